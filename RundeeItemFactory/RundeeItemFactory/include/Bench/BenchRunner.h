@@ -0,0 +1,106 @@
+/**
+ * @file BenchRunner.h
+ * @brief Micro-benchmarks for catalog code paths (--bench mode)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * `--bench <suite> [--benchFile catalog.json]` runs one suite against an
+ * existing catalog and prints time, throughput and heap usage per variant
+ * (see AllocationStats). The LLM is not used.
+ */
+
+#pragma once
+
+#include "Helpers/CommandLineParser.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @struct BenchMeasurement
+ * @brief Result of one measured variant
+ */
+struct BenchMeasurement
+{
+    std::string name;
+    double seconds = 0.0;
+    size_t items = 0;              ///< Items produced by the variant (for cross-checking)
+    size_t inputBytes = 0;         ///< Bytes of input processed (for throughput)
+    uint64_t allocations = 0;      ///< Heap allocations made during the run
+    uint64_t allocatedBytes = 0;   ///< Bytes requested by those allocations
+    uint64_t peakHeapBytes = 0;    ///< Peak live heap above the level at the start of the run
+    uint64_t copies = 0;           ///< Deep copies of items, for suites that count them
+};
+
+/**
+ * @struct BenchInput
+ * @brief One named input of a BenchComparison
+ */
+struct BenchInput
+{
+    std::string name;
+    size_t bytes = 0;              ///< Bytes one variant processes for this input (for throughput)
+};
+
+/**
+ * @struct BenchComparison
+ * @brief A replaced implementation timed against its replacement on several inputs
+ *
+ * Suites supply the inputs and the two variants; BenchRunner::RunComparison
+ * measures both on every input, checks that they agree and prints the table.
+ */
+struct BenchComparison
+{
+    std::string title;
+    std::string referenceName;     ///< Label of the replaced implementation (e.g. "legacy")
+    std::string candidateName;     ///< Label of its replacement
+    std::vector<BenchInput> inputs;
+    std::function<std::string(size_t input)> reference;   ///< Result of the replaced code on inputs[input]
+    std::function<std::string(size_t input)> candidate;   ///< Result of the replacement on inputs[input]
+    /** @brief Items column for a result (untimed); empty = 0 */
+    std::function<size_t(size_t input, const std::string& result)> countItems;
+    /** @brief Whether two results agree; empty = byte equality */
+    std::function<bool(const std::string& reference, const std::string& candidate)> equivalent;
+};
+
+/**
+ * @class BenchRunner
+ * @brief Static entry point for bench mode and shared measuring helpers
+ */
+class BenchRunner
+{
+public:
+    /** @brief Seed of every suite's generated cases, so runs are repeatable */
+    static constexpr uint32_t kSeed = 20261018;
+
+    /**
+     * @brief Run the suite named by args.benchSuite
+     * @param args Arguments (benchSuite, benchFile or params.outputPath)
+     * @return Exit code (0 = suite ran and its variants agreed)
+     */
+    static int Run(const CommandLineArgs& args);
+
+    /**
+     * @brief Time one variant and record its heap usage
+     * @param name Variant label
+     * @param inputBytes Bytes the variant processes (0 = no throughput column)
+     * @param body Work to measure; returns the number of items it produced
+     */
+    static BenchMeasurement Measure(const std::string& name, size_t inputBytes, const std::function<size_t()>& body);
+
+    /**
+     * @brief Print a result table
+     * @param title Suite title
+     * @param results Measured variants
+     */
+    static void PrintResults(const std::string& title, const std::vector<BenchMeasurement>& results);
+
+    /**
+     * @brief Measure both variants of a comparison on every input and print the table
+     * @param comparison Inputs and variants
+     * @return Number of inputs on which the variants disagreed (reported on stderr)
+     */
+    static int RunComparison(const BenchComparison& comparison);
+};
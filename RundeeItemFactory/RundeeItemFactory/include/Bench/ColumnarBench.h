@@ -0,0 +1,32 @@
+/**
+ * @file ColumnarBench.h
+ * @brief Round-trip and column-scan check of ColumnarCatalog (--bench columnar)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Loads a JSON catalog, builds a ColumnarCatalog from it with the given
+ * profile and rebuilds the JSON; the result must equal the catalog. Then
+ * every profile field is aggregated twice, once by walking the JSON items
+ * and once by scanning the typed columns, and both summaries must match.
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @class ColumnarBench
+ * @brief Static runner for the "columnar" suite
+ */
+class ColumnarBench
+{
+public:
+    /**
+     * @brief Round-trip the catalog, compare both scans and print the timings
+     * @param catalogPath JSON catalog path
+     * @param profileId Item profile that defines the columns (required)
+     * @return Exit code (0 = loss-free round trip and identical scans)
+     */
+    static int Run(const std::string& catalogPath, const std::string& profileId);
+};
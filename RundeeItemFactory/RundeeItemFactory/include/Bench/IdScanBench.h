@@ -0,0 +1,31 @@
+/**
+ * @file IdScanBench.h
+ * @brief Benchmark of catalog ID enumeration strategies (--bench ids)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Compares three ways of collecting the "id" of every item in a catalog:
+ * - dom:        parse the whole file into nlohmann::json (the original GetExistingIds)
+ * - sax-filter: nlohmann SAX over the mapped file, discarding every value except top-level ids
+ * - structural: the mapped structural scan used by DynamicItemJsonWriter::GetExistingIds
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @class IdScanBench
+ * @brief Static runner for the "ids" suite
+ */
+class IdScanBench
+{
+public:
+    /**
+     * @brief Run every variant on one catalog and print the comparison
+     * @param catalogPath JSON catalog path
+     * @return Exit code (0 = all variants found the same IDs)
+     */
+    static int Run(const std::string& catalogPath);
+};
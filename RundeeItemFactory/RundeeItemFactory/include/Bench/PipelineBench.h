@@ -0,0 +1,36 @@
+/**
+ * @file PipelineBench.h
+ * @brief End-to-end benchmark of the parse -> dedup -> write item pipeline (--bench pipeline)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Items from an existing catalog are cut into LLM-sized responses and run
+ * through the generator's stages without the LLM:
+ * - copying:   the previous flow, which copied each item out of the parsed
+ *              batch, again into the run and once more into the writer's
+ *              output array
+ * - move-only: the current flow, where owned batches are moved from the
+ *              parser to the run and handed to DynamicItemJsonWriter by rvalue
+ * Both variants use the same parser and must write byte-identical files.
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @class PipelineBench
+ * @brief Static runner for the "pipeline" suite
+ */
+class PipelineBench
+{
+public:
+    /**
+     * @brief Run both variants and print copies and heap traffic
+     * @param catalogPath JSON catalog the items are taken from
+     * @param profileId Item profile to parse with (empty = no field rules)
+     * @return Exit code (0 = both variants wrote the same catalog)
+     */
+    static int Run(const std::string& catalogPath, const std::string& profileId);
+};
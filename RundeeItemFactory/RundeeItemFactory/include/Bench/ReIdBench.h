@@ -0,0 +1,32 @@
+/**
+ * @file ReIdBench.h
+ * @brief Equivalence test and benchmark of ID shortening (--bench reid)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Re-derives the short ID of every display name in a catalog, plus seeded
+ * weapon-style names built from the built-in rule words, with both the old
+ * per-call find/erase implementation and the compiled IdShortener. Every
+ * name must shorten to the same suffix, so existing catalog IDs do not
+ * change. Afterwards both are timed on the whole name list.
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @class ReIdBench
+ * @brief Static runner for the "reid" suite
+ */
+class ReIdBench
+{
+public:
+    /**
+     * @brief Compare both implementations on every name, then time them
+     * @param catalogPath JSON catalog whose display names are used
+     * @return Exit code (0 = every name shortened identically)
+     */
+    static int Run(const std::string& catalogPath);
+};
@@ -0,0 +1,38 @@
+/**
+ * @file RepairBench.h
+ * @brief Property test and benchmark of the LLM JSON repair pass (--bench repair)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Items from an existing catalog are dumped as LLM-style responses and
+ * damaged with seeded random corruptions:
+ * - legacy cases use only the damage the old multi-pass cleaner handled
+ *   (prose, trailing commas before ']', "..." lines, a missing final ']',
+ *   spaces in ids); whenever the old cleaner's output parses, the
+ *   JsonRepair output must parse to the same value
+ * - repair-only cases (missing commas, trailing commas before '}', raw
+ *   newlines in strings, )key" quotes, a response cut off mid-item) must
+ *   parse to the original items, or to the complete ones before the cut
+ * Afterwards both cleaners are timed on a whole-catalog response and on a
+ * response with thousands of trailing commas.
+ */
+
+#pragma once
+
+#include <string>
+
+/**
+ * @class RepairBench
+ * @brief Static runner for the "repair" suite
+ */
+class RepairBench
+{
+public:
+    /**
+     * @brief Run the property cases, then time both cleaners
+     * @param catalogPath JSON catalog the items are taken from
+     * @return Exit code (0 = every property case held)
+     */
+    static int Run(const std::string& catalogPath);
+};
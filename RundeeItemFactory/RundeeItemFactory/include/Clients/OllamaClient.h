@@ -12,8 +12,29 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #include "Helpers/AppConfig.h"
 
+/**
+ * @struct OllamaCallStats
+ * @brief Server-side counters and timings reported by Ollama for a single call
+ * 
+ * Ollama appends these fields to the final ("done": true) object of a
+ * /api/generate response. Durations are kept in nanoseconds as reported.
+ */
+struct OllamaCallStats
+{
+    bool hasServerStats = false;          ///< True if the response carried Ollama's eval counters
+    long long promptEvalCount = 0;        ///< Prompt tokens evaluated (prefill)
+    long long promptEvalDurationNs = 0;   ///< Time spent on prefill (ns)
+    long long evalCount = 0;              ///< Tokens generated (decode)
+    long long evalDurationNs = 0;         ///< Time spent on decode (ns)
+    long long loadDurationNs = 0;         ///< Time spent loading the model (ns)
+    long long totalDurationNs = 0;        ///< Total server-side time (ns)
+    double wallSeconds = 0.0;             ///< Client-side wall time of the HTTP call
+    int attempts = 0;                     ///< Number of attempts made (RunWithRetry only)
+};
+
 /**
  * @class OllamaClient
  * @brief Static class for communicating with Ollama LLM server
@@ -33,15 +54,24 @@ public:
      * @param modelName Name of the LLM model (e.g., "llama3", "mistral")
      * @param prompt Prompt text to send to the LLM
      * @param settings Ollama connection settings (host, port, timeouts)
+     * @param outStats Optional output for Ollama's token counters and timings (may be nullptr)
+     * @param context Optional conversation context (may be nullptr). If non-empty it is sent
+     *                with the request so the server continues that exchange instead of
+     *                re-prefilling it; on return it holds the context of the new exchange
+     *                (empty if the server returned none)
      * @return JSON response as a string, or empty string on error
      * 
      * @note This function does not retry on failure
      * @note Uses WinHTTP on Windows for HTTP communication
+     * @note The WinHTTP session and per-server connection are shared across calls
+     *       and threads; only the request handle is created per call
      * @see RunWithRetry for automatic retry logic
      */
     static std::string RunSimple(const std::string& modelName, 
                                  const std::string& prompt,
-                                 const OllamaSettings& settings);
+                                 const OllamaSettings& settings,
+                                 OllamaCallStats* outStats = nullptr,
+                                 std::vector<int>* context = nullptr);
 
     /**
      * @brief Run LLM call with automatic retry logic
@@ -53,6 +83,8 @@ public:
      * @param prompt Prompt text to send to the LLM
      * @param maxRetries Maximum number of retry attempts (default: 3)
      * @param timeoutSeconds Timeout per attempt in seconds (default: 120, 0 = no timeout)
+     * @param outStats Optional output for the stats of the successful attempt (may be nullptr)
+     * @param context Optional conversation context, see RunSimple; left unchanged if all attempts fail
      * @return Response string, or empty string if all attempts failed
      * 
      * @note Automatically loads OllamaSettings from AppConfig
@@ -63,5 +95,15 @@ public:
     static std::string RunWithRetry(const std::string& modelName, 
                                     const std::string& prompt,
                                     int maxRetries = 3,
-                                    int timeoutSeconds = 120);
+                                    int timeoutSeconds = 120,
+                                    OllamaCallStats* outStats = nullptr,
+                                    std::vector<int>* context = nullptr);
+
+    /**
+     * @brief Close the shared WinHTTP session and connections
+     * 
+     * Call once no more requests are in flight (e.g., at the end of a manifest
+     * run or server shutdown). The next call reopens them on demand.
+     */
+    static void ReleaseConnections();
 };
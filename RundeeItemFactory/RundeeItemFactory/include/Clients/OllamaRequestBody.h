@@ -0,0 +1,70 @@
+/**
+ * @file OllamaRequestBody.h
+ * @brief Streamed JSON body of an Ollama /api/generate request
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * A request body is {"model":...,"prompt":...,"stream":false[,"context":[...]]}.
+ * Prompts carry player-stat sections and exclusion lists and can be large,
+ * so the body is never assembled as one string. It is three segments:
+ * - head:   the model field and the opening of the prompt string (small, owned)
+ * - prompt: the caller's prompt, escaped on the fly while it is written
+ * - tail:   the stream flag and the conversation context (owned, rebuilt per call)
+ * The exact length is known up front (for Content-Length), and WriteTo()
+ * hands the bytes to a sink: long runs that need no escaping point straight
+ * into the prompt, everything else goes through a small staging buffer.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class OllamaRequestBody
+ * @brief Length-prefixed, scatter/gather writer for one request body
+ *
+ * The prompt is referenced, not copied; it must outlive the object.
+ */
+class OllamaRequestBody
+{
+public:
+    /**
+     * @brief Receives the next piece of the body; return false to abort
+     */
+    using Sink = std::function<bool(const char* data, size_t size)>;
+
+    /**
+     * @brief Prepare a body
+     * @param modelName Model name
+     * @param prompt Prompt text (referenced)
+     * @param context Optional conversation context to continue (may be nullptr or empty)
+     */
+    OllamaRequestBody(const std::string& modelName, const std::string& prompt, const std::vector<int>* context);
+
+    /**
+     * @brief Exact size of the body in bytes
+     */
+    size_t GetLength() const { return m_length; }
+
+    /**
+     * @brief Stream the body to a sink
+     * @param sink Called with consecutive pieces; the pointers are only valid during the call
+     * @return False if the sink refused a piece
+     */
+    bool WriteTo(const Sink& sink) const;
+
+    /**
+     * @brief Materialize the body (diagnostics only)
+     */
+    std::string ToString() const;
+
+private:
+    std::string m_head;
+    const std::string& m_prompt;
+    std::string m_tail;
+    size_t m_length = 0;
+};
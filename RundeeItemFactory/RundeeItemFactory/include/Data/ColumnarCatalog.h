@@ -0,0 +1,161 @@
+/**
+ * @file ColumnarCatalog.h
+ * @brief Column-oriented in-memory item catalog keyed by profile fields
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Stores one column per ItemProfile field instead of one JSON object per item:
+ * integers and floats as contiguous arrays, strings as an offset table into a
+ * shared blob, allowedValues strings as dictionary codes, booleans as bytes.
+ * Array/Object fields keep their JSON values in a per-column vector.
+ *
+ * Conversion is loss-free: values whose type does not fit their column and
+ * fields that are not in the profile are kept aside per row and restored by
+ * GetItem/ToJson, so FromJson(items).ToJson() == items.
+ * `--bench columnar` checks both on a catalog (see ColumnarBench).
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include <json.hpp>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @enum ColumnType
+ * @brief Storage used for one column
+ */
+enum class ColumnType
+{
+    Int = 0,      ///< ProfileFieldType::Integer -> ints
+    Float = 1,    ///< ProfileFieldType::Float -> floats
+    Bool = 2,     ///< ProfileFieldType::Boolean -> bools
+    String = 3,   ///< ProfileFieldType::String -> offsets + blob
+    Enum = 4,     ///< String with allowedValues -> codes into dictionary
+    Json = 5      ///< Array/Object -> JSON values
+};
+
+/**
+ * @enum CellState
+ * @brief What a column holds for one row
+ */
+enum class CellState : uint8_t
+{
+    Missing = 0,    ///< Field absent from the item
+    Value = 1,      ///< Typed value stored in the column
+    Integral = 2,   ///< Float column: value was written as an integer (e.g. 400, not 400.0)
+    Fallback = 3    ///< Value of another type; stored as JSON in the column's fallback map
+};
+
+/**
+ * @struct CatalogColumn
+ * @brief One field's values for every row
+ *
+ * Only the vectors matching the column type are filled. Typed vectors have one
+ * entry per row (zero/empty when the cell is not CellState::Value) so row i is
+ * always at index i.
+ */
+struct CatalogColumn
+{
+    std::string name;
+    ColumnType type = ColumnType::Json;
+    std::vector<CellState> states;
+
+    std::vector<int64_t> ints;                ///< Int
+    std::vector<double> floats;               ///< Float
+    std::vector<uint8_t> bools;               ///< Bool (0/1)
+    std::vector<uint64_t> offsets;            ///< String: rows + 1 offsets into blob
+    std::string blob;                         ///< String: concatenated bytes
+    std::vector<uint32_t> codes;              ///< Enum: index into dictionary
+    std::vector<std::string> dictionary;      ///< Enum: allowedValues first, then any other values seen
+    size_t allowedCount = 0;                  ///< Enum: codes below this are allowed values
+    std::map<std::string, uint32_t> dictionaryIndex; ///< Enum: value -> code
+    std::vector<nlohmann::json> values;       ///< Json
+    std::map<size_t, nlohmann::json> fallback; ///< Row -> value that did not fit the column type
+
+    /**
+     * @brief Get a String column cell without copying
+     * @param row Row index
+     * @return Pointer/length view of the string bytes
+     */
+    std::pair<const char*, size_t> GetString(size_t row) const
+    {
+        return { blob.data() + offsets[row], static_cast<size_t>(offsets[row + 1] - offsets[row]) };
+    }
+};
+
+/**
+ * @class ColumnarCatalog
+ * @brief Columnar item storage built from an item profile
+ */
+class ColumnarCatalog
+{
+public:
+    /**
+     * @brief Create an empty catalog with one column per profile field
+     * @param profile Item profile defining the columns
+     */
+    explicit ColumnarCatalog(const ItemProfile& profile);
+
+    /**
+     * @brief Build a catalog from JSON items
+     * @param profile Item profile defining the columns
+     * @param items JSON array of item objects
+     * @return Catalog holding every object in items (non-objects are skipped)
+     */
+    static ColumnarCatalog FromJson(const ItemProfile& profile, const nlohmann::json& items);
+
+    /**
+     * @brief Append one item
+     * @param item Item JSON object
+     * @return False if item is not an object (nothing is appended)
+     */
+    bool Append(const nlohmann::json& item);
+
+    /**
+     * @brief Reserve space for a number of rows in every column
+     */
+    void Reserve(size_t rows);
+
+    /**
+     * @brief Rebuild one item as JSON
+     * @param row Row index (< GetRowCount())
+     * @return Item equal to the one appended
+     */
+    nlohmann::json GetItem(size_t row) const;
+
+    /**
+     * @brief Rebuild all items as a JSON array
+     */
+    nlohmann::json ToJson() const;
+
+    /**
+     * @brief Number of rows (items)
+     */
+    size_t GetRowCount() const { return m_rowCount; }
+
+    /**
+     * @brief All columns in profile field order
+     */
+    const std::vector<CatalogColumn>& GetColumns() const { return m_columns; }
+
+    /**
+     * @brief Find a column by field name
+     * @return Column, or nullptr if the profile has no such field
+     */
+    const CatalogColumn* FindColumn(const std::string& name) const;
+
+private:
+    void AppendCell(CatalogColumn& column, const nlohmann::json* value);
+    void AppendPlaceholder(CatalogColumn& column);
+    static bool GetCell(const CatalogColumn& column, size_t row, nlohmann::json& outValue);
+
+    std::vector<CatalogColumn> m_columns;
+    std::map<std::string, size_t> m_columnIndex;
+    std::map<size_t, nlohmann::json> m_extras; ///< Row -> fields not in the profile
+    size_t m_rowCount = 0;
+};
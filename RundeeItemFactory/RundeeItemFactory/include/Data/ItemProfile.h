@@ -54,7 +54,7 @@ struct ProfileFieldValidation
     double maxValue = 0.0;
     std::vector<std::string> allowedValues;
     std::vector<RelationshipConstraint> relationshipConstraints;
-    std::string customConstraint;
+    std::string customConstraint; // Expression checked by the validator, or free-form prompt guidance (see ProfileConstraints)
 };
 
 /**
@@ -73,6 +73,17 @@ struct ProfileField
     ProfileFieldValidation validation;
 };
 
+/**
+ * @struct IdShorteningRules
+ * @brief Rules that shorten display names into ID suffixes (see IdShortener)
+ */
+struct IdShorteningRules
+{
+    bool isSet = false; // False -> built-in rules
+    std::vector<std::string> removeWords; // Whole words dropped from the name, in precedence order
+    std::map<std::string, std::string> abbreviations; // Whole word -> replacement, after removeWords
+};
+
 /**
  * @struct ItemProfile
  * @brief Complete item profile defining structure and validation
@@ -86,6 +97,9 @@ struct ItemProfile
     int version = 1;
     bool isDefault = false;
     std::string customContext;
+    std::vector<std::string> bannedTerms; // Added to the guardrail's banned list from config
+    std::map<std::string, std::map<std::string, double>> quotas; // Field name -> allowed value -> target share (see QuotaScheduler)
+    IdShorteningRules idShortening; // "idShortening" section; compiled once per profile by IdShortener
     std::vector<ProfileField> fields;
     std::map<std::string, nlohmann::json> metadata;
     std::map<std::string, int> playerSettings;
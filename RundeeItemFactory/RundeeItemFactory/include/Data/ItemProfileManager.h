@@ -40,6 +40,14 @@ public:
      */
     static ItemProfile LoadProfile(const std::string& profileId);
     
+    /**
+     * @brief Load a profile from a given profiles directory
+     * @param profileId Profile ID (filename without extension)
+     * @param profilesDir Directory containing profile files (Initialize() is not needed)
+     * @return Loaded profile, or empty profile if not found
+     */
+    static ItemProfile LoadProfile(const std::string& profileId, const std::string& profilesDir);
+    
     /**
      * @brief Load a profile from file path
      * @param filePath Full path to profile file
@@ -0,0 +1,102 @@
+/**
+ * @file BatchSizeController.h
+ * @brief Online tuning of items-per-request for each (model, profile)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Large requests produce long, truncation-prone responses; small requests
+ * pay the prompt prefill over and over. The controller measures every batch
+ * (parse success, duplicates, GPU time, tokens per item) and hill-climbs a
+ * ladder of batch sizes towards the one with the highest accepted items per
+ * GPU-second. Learned state is persisted to Registry/batch_tuning.json
+ * whenever the batch size changes and at the end of each run.
+ */
+
+#pragma once
+
+#include "Clients/OllamaClient.h"
+#include <string>
+
+/**
+ * @struct BatchOutcome
+ * @brief Measured result of one LLM request
+ */
+struct BatchOutcome
+{
+    int requested = 0;         ///< Items asked for in the prompt
+    bool parsed = false;       ///< True if the response parsed as an item array
+    int parsedItems = 0;       ///< Items that survived parsing/validation
+    int duplicates = 0;        ///< Parsed items rejected as duplicate IDs
+    int rejected = 0;          ///< Parsed items rejected by the guardrail
+    int quotaDropped = 0;      ///< Parsed items dropped because their quota bucket was full
+    OllamaCallStats stats;     ///< Server counters/timings for the call
+};
+
+/**
+ * @struct BatchTuningSnapshot
+ * @brief Read-only view of the controller state for one (model, profile)
+ */
+struct BatchTuningSnapshot
+{
+    int batchSize = 0;                ///< Current recommended items per request
+    int batches = 0;                  ///< Batches observed (all sizes)
+    double parseSuccessRate = 1.0;    ///< Smoothed share of responses that parsed
+    double duplicateRate = 0.0;       ///< Smoothed share of parsed items that were duplicates
+    double acceptanceRate = 1.0;      ///< Smoothed usable (parsed, non-duplicate, not rejected or quota-dropped) items / requested
+    double secondsPerBatch = 0.0;     ///< Smoothed GPU seconds per request
+    double tokensPerItem = 0.0;       ///< Smoothed generated tokens per parsed item
+    double itemsPerGpuSecond = 0.0;   ///< Smoothed throughput at the current batch size
+};
+
+/**
+ * @class BatchSizeController
+ * @brief Static, thread-safe batch size tuner shared by all jobs
+ */
+class BatchSizeController
+{
+public:
+    /**
+     * @brief Get the number of items to request next
+     * @param modelName Model used for generation
+     * @param profileId Item profile being generated
+     * @param remaining Items still needed by the run
+     * @return Items to request (1..remaining)
+     */
+    static int RecommendBatchSize(const std::string& modelName, const std::string& profileId, int remaining);
+
+    /**
+     * @brief Predict the share of requested items that will be usable
+     * 
+     * Based on the smoothed parse success, validation and duplicate losses
+     * observed for the pair; a conservative prior is used until the first
+     * batch has been measured.
+     * 
+     * @param modelName Model used for generation
+     * @param profileId Item profile being generated
+     * @return Predicted yield in [0.5, 1]
+     */
+    static double PredictYield(const std::string& modelName, const std::string& profileId);
+
+    /**
+     * @brief Feed the measured outcome of one request back into the controller
+     * @param modelName Model used for generation
+     * @param profileId Item profile being generated
+     * @param outcome Measured result
+     * @note Persists the state only if the batch size changed (see Save)
+     */
+    static void RecordBatch(const std::string& modelName, const std::string& profileId, const BatchOutcome& outcome);
+
+    /**
+     * @brief Persist everything recorded since the last write (no-op if nothing changed)
+     */
+    static void Save();
+
+    /**
+     * @brief Get the current tuning state for a (model, profile)
+     * @param modelName Model name
+     * @param profileId Item profile ID
+     * @return Snapshot (defaults if nothing was learned yet)
+     */
+    static BatchTuningSnapshot GetSnapshot(const std::string& modelName, const std::string& profileId);
+};
@@ -0,0 +1,87 @@
+/**
+ * @file CatalogCommitter.h
+ * @brief Background write-behind committer for generated items
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Jobs hand their accepted items to a single committer thread instead of
+ * rewriting the output file and the ID registry themselves. While other
+ * jobs are still running (see ProducerScope), the committer waits up to
+ * CommitSettings::intervalMs after the first request to collect theirs;
+ * with a single job, or once every running job has submitted or the queue
+ * is full, it commits at once. One group commit merges each output catalog
+ * once with the items of every request that targets it and saves each
+ * type's registry once. Every file is synced once per commit.
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <future>
+#include <string>
+#include <vector>
+
+/**
+ * @struct CatalogCommitRequest
+ * @brief Items of one job and where they go
+ */
+struct CatalogCommitRequest
+{
+    std::string outputPath;                  ///< Unsharded JSON output path
+    bool writeJson = true;                   ///< Merge into the JSON catalog
+    bool writeBinary = false;                ///< Merge into the binary catalog (.ricat)
+    int shardCount = 1;                      ///< Output shards (see ShardedCatalogWriter)
+    std::string typeNameLower;               ///< Registry key; empty = do not touch the registry
+    std::vector<nlohmann::json> items;       ///< Accepted items (objects with a string "id")
+};
+
+/**
+ * @struct CatalogCommitResult
+ * @brief Outcome of the group commit that included a request
+ */
+struct CatalogCommitResult
+{
+    bool success = false;
+    std::string error;                       ///< Reason when success is false
+    size_t registryBefore = 0;               ///< Registry size before the commit (for this request's type)
+    size_t registryAfter = 0;                ///< Registry size after the commit
+    size_t groupedRequests = 0;              ///< Requests coalesced into the same commit
+};
+
+/**
+ * @class CatalogCommitter
+ * @brief Static interface to the process-wide committer thread
+ */
+class CatalogCommitter
+{
+public:
+    /**
+     * @brief Queue items for the next group commit
+     * @param request Items and destination (moved into the queue)
+     * @return Future that becomes ready once the items are durable (or the commit failed)
+     */
+    static std::future<CatalogCommitResult> Submit(CatalogCommitRequest request);
+
+    /**
+     * @brief Block until every request submitted so far has been committed
+     */
+    static void Flush();
+
+    /**
+     * @class ProducerScope
+     * @brief Marks a running job that may still submit items
+     *
+     * The committer only holds a request back to group it while another
+     * producer is active and has not submitted yet.
+     */
+    class ProducerScope
+    {
+    public:
+        ProducerScope();
+        ~ProducerScope();
+
+        ProducerScope(const ProducerScope&) = delete;
+        ProducerScope& operator=(const ProducerScope&) = delete;
+    };
+};
@@ -0,0 +1,124 @@
+/**
+ * @file GenerationCache.h
+ * @brief Process-wide cache of profiles and known item IDs
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Keeps item profiles, player profiles, output-file IDs and registry IDs
+ * in memory so that several generation jobs in one process (serve mode,
+ * manifests) do not reload them from disk for every job. Entries backed by
+ * files are revalidated against the file's last write time.
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include "Data/PlayerProfile.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+struct CatalogIdIndex;
+
+/**
+ * @class GenerationCache
+ * @brief Static, thread-safe cache shared by all generation jobs
+ */
+class GenerationCache
+{
+public:
+    /**
+     * @brief Create the profile directories if they do not exist yet
+     * @param itemProfilesDir Directory containing item profile files
+     * @param playerProfilesDir Directory containing player profile files
+     * @return True if the item profiles directory exists
+     * @note Directories are passed to every lookup instead of being stored,
+     *       so concurrent jobs never see each other's settings
+     */
+    static bool PrepareDirectories(const std::string& itemProfilesDir, const std::string& playerProfilesDir);
+
+    /**
+     * @brief Get an item profile, loading it on first use or when the file changed
+     * @param profilesDir Item profiles directory
+     * @param profileId Profile ID (filename without extension)
+     * @return Loaded profile, or empty profile if not found
+     */
+    static ItemProfile GetItemProfile(const std::string& profilesDir, const std::string& profileId);
+
+    /**
+     * @brief Get a player profile, loading it on first use or when the file changed
+     * @param profilesDir Player profiles directory
+     * @param profileId Player profile ID (filename without extension)
+     * @return Loaded player profile, or empty profile if not found
+     */
+    static PlayerProfile GetPlayerProfile(const std::string& profilesDir, const std::string& profileId);
+
+    /**
+     * @brief Get the default player profile (isDefault, or the first one found)
+     * @param profilesDir Player profiles directory
+     * @return Default player profile, or empty profile if none found
+     */
+    static PlayerProfile GetDefaultPlayerProfile(const std::string& profilesDir);
+
+    /**
+     * @brief Get IDs already used by an output file and the type registry
+     * @param outputPath Output JSON file path
+     * @param typeNameLower Lowercase item type name (registry key)
+     * @param outFileIdCount Optional output: number of IDs found in the output file
+     * @param outRegistryIdCount Optional output: number of IDs found in the registry
+     * @return Union of output-file IDs and registry IDs
+     */
+    static std::set<std::string> GetKnownIds(const std::string& outputPath,
+                                             const std::string& typeNameLower,
+                                             size_t* outFileIdCount = nullptr,
+                                             size_t* outRegistryIdCount = nullptr);
+
+    /**
+     * @brief Get IDs already used by several output files (e.g. catalog shards) and the type registry
+     * @param outputPaths Output JSON file paths; each is cached and refreshed separately
+     * @param typeNameLower Lowercase item type name (registry key)
+     * @param outFileIdCount Optional output: number of IDs found in the output files
+     * @param outRegistryIdCount Optional output: number of IDs found in the registry
+     * @return Union of output-file IDs and registry IDs
+     */
+    static std::set<std::string> GetKnownIds(const std::vector<std::string>& outputPaths,
+                                             const std::string& typeNameLower,
+                                             size_t* outFileIdCount = nullptr,
+                                             size_t* outRegistryIdCount = nullptr);
+
+    /**
+     * @brief Record IDs that were just written to an output file
+     * @param outputPath Output JSON file path
+     * @param ids IDs written
+     * @note Call while still holding the output file's lock so the cached
+     *       write time matches the cached IDs
+     */
+    static void RecordWrittenIds(const std::string& outputPath, const std::set<std::string>& ids);
+
+    /**
+     * @brief Merge IDs into the cached registry for a type and persist it
+     * @param typeNameLower Lowercase item type name (registry key)
+     * @param ids IDs to add
+     * @param outBefore Registry size before merging
+     * @param outAfter Registry size after merging
+     * @return True if the registry was saved
+     */
+    static bool MergeRegistryIds(const std::string& typeNameLower,
+                                 const std::set<std::string>& ids,
+                                 size_t& outBefore,
+                                 size_t& outAfter);
+
+    /**
+     * @brief Get the ID index shared by all running jobs that write one catalog
+     * @param outputPath Output JSON file path of the catalog
+     * @return Index kept alive while any job holds it; a new empty one if none does
+     */
+    static std::shared_ptr<CatalogIdIndex> AcquireIdIndex(const std::string& outputPath);
+
+    /**
+     * @brief Drop all cached entries
+     */
+    static void Clear();
+};
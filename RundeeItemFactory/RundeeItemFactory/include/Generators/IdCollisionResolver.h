@@ -0,0 +1,145 @@
+/**
+ * @file IdCollisionResolver.h
+ * @brief Deterministic resolution of short-ID collisions between distinct items
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * GenerateShortIdFromDisplayName() drops descriptors ("rifle", "mk") and
+ * shortens manufacturers, so "HK416 Carbine" and "HK416 Rifle" both become
+ * weapon_hk416. Rejecting the second item as a duplicate throws away a
+ * distinct item and costs another LLM request.
+ *
+ * The resolver walks a fixed candidate sequence derived only from the
+ * display name:
+ *   1. the short ID                      weapon_hk416
+ *   2. the full normalized name          weapon_hk416carbine
+ *   3. that plus a name hash             weapon_hk416carbine_3fa2
+ *   4. then _2, _3, ... on the hash form weapon_hk416carbine_3fa2_2
+ * and takes the first candidate not in the ID index. Only the ASCII part
+ * of the name goes into an ID; a name without one skips step 2, and the
+ * hash is taken over the whole name. When a candidate is
+ * taken by an item with the same normalized display name, the item is a
+ * true duplicate and is rejected. Because the sequence depends only on the
+ * name, a repeat of an earlier item walks the same candidates and finds it.
+ *
+ * Names of IDs from this run are kept in memory. Names of catalog IDs are
+ * read on the first collision that needs them. IDs known only from the
+ * registry have no name and count as other items.
+ *
+ * Concurrent jobs writing the same catalog (manifest, serve mode) share one
+ * CatalogIdIndex, so an ID accepted by one job is taken for all of them and
+ * the writer never has to drop one of two items with the same ID.
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class BinaryCatalogReader;
+
+/**
+ * @struct CatalogIdIndex
+ * @brief IDs and display names claimed by every job writing one catalog
+ * @see GenerationCache::AcquireIdIndex
+ */
+struct CatalogIdIndex
+{
+    std::mutex mutex;
+    std::set<std::string> ids;
+    std::unordered_map<std::string, std::string> names;   ///< ID -> normalized display name
+    bool catalogsLoaded = false;                          ///< Catalog display names were read into names
+};
+
+/**
+ * @class IdCollisionResolver
+ * @brief Assigns unique IDs to new items against a run's ID index
+ */
+class IdCollisionResolver
+{
+public:
+    /**
+     * @enum Outcome
+     * @brief Result of resolving one item
+     */
+    enum class Outcome
+    {
+        Unique,          ///< The derived short ID was free
+        Resolved,        ///< The short ID was taken by another item; item["id"] was rewritten
+        DuplicateName    ///< An item with the same display name already holds one of the candidates
+    };
+
+    /**
+     * @brief Create a resolver over a run's ID index
+     * @param knownIds ID index of the run (catalog, registry); Record() adds to it
+     * @param sharedIndex Index shared with other jobs writing the same catalog; knownIds is merged into it
+     * @param idPrefix Item type prefix of generated IDs (e.g. "weapon")
+     * @param jsonCatalogs JSON catalogs whose display names are read on the first collision
+     * @param binaryCatalogs Binary catalogs whose items are looked up by ID on collision
+     */
+    IdCollisionResolver(std::set<std::string>& knownIds,
+                        std::shared_ptr<CatalogIdIndex> sharedIndex,
+                        const std::string& idPrefix,
+                        std::vector<std::string> jsonCatalogs,
+                        std::vector<std::string> binaryCatalogs);
+    ~IdCollisionResolver();
+
+    IdCollisionResolver(const IdCollisionResolver&) = delete;
+    IdCollisionResolver& operator=(const IdCollisionResolver&) = delete;
+
+    /**
+     * @brief Pick the ID for a new item, rewriting item["id"] if its short ID collides
+     * @param item Parsed item with "id" and "displayName" filled in
+     * @param outCollidedId Set to the original short ID when it was taken (left empty otherwise)
+     * @return How the ID was settled; the index is not changed until Record()
+     */
+    Outcome Resolve(nlohmann::json& item, std::string& outCollidedId);
+
+    /**
+     * @brief Claim an accepted item's ID and display name in the index
+     * @param item Item whose "id" was settled by Resolve()
+     * @param resolved What Resolve() returned for the item; Resolved counts it as rewritten
+     * @return False if another job took the ID since Resolve() and the item
+     *         turned out to be a duplicate of that job's item; if it was only
+     *         a collision, item["id"] is rewritten again and the item is kept
+     */
+    bool Record(nlohmann::json& item, Outcome resolved = Outcome::Unique);
+
+    /**
+     * @brief Number of recorded items whose ID was rewritten so far
+     */
+    int GetResolvedCount() const { return m_resolvedCount; }
+
+    /**
+     * @brief Comparison form of a display name ("HK-416 Carbine" -> "hk416carbine")
+     *
+     * ASCII letters are lowercased and ASCII spaces and punctuation dropped;
+     * non-ASCII (UTF-8) bytes are kept, so names in other scripts still compare.
+     */
+    static std::string NormalizeName(const std::string& displayName);
+
+private:
+    /** @brief Resolve() body; the shared index must be locked */
+    Outcome ResolveLocked(nlohmann::json& item, std::string& outCollidedId);
+
+    /** @brief Normalized display name of the item holding @p id (empty if unknown); index locked */
+    std::string HolderName(const std::string& id);
+
+    /** @brief Read "id" -> display name from the JSON catalogs once per index, open the binary ones once */
+    void LoadCatalogs();
+
+    std::set<std::string>& m_knownIds;
+    std::shared_ptr<CatalogIdIndex> m_index;
+    std::string m_idPrefix;
+    std::vector<std::string> m_jsonCatalogs;
+    std::vector<std::string> m_binaryCatalogs;
+    std::vector<std::unique_ptr<BinaryCatalogReader>> m_binaryReaders;
+    bool m_binaryOpened = false;
+    int m_resolvedCount = 0;
+};
@@ -9,6 +9,25 @@
 #pragma once
 
 #include "Helpers/CommandLineParser.h"
+#include <functional>
+#include <string>
+
+/**
+ * @struct GenerationProgress
+ * @brief Progress event emitted while a generation job runs
+ */
+struct GenerationProgress
+{
+    std::string stage;      ///< Stage name ("loaded", "request", "batch", "written", "done", "failed")
+    int accepted = 0;       ///< Items accepted so far
+    int requested = 0;      ///< Items requested for the job
+    std::string message;    ///< Human-readable detail
+};
+
+/**
+ * @brief Callback receiving progress events (may be empty)
+ */
+using GenerationProgressCallback = std::function<void(const GenerationProgress&)>;
 
 /**
  * @class ItemGenerator
@@ -20,7 +39,16 @@ public:
     /**
      * @brief Generate items using LLM
      * @param args Command line arguments (may be modified to apply player profile settings)
+     * @param onProgress Optional callback receiving progress events
      * @return Exit code (0 = success)
+     * @note Profiles and known IDs are served from GenerationCache, so repeated
+     *       calls in one process only touch disk for files that changed
+     */
+    static int GenerateWithLLM(CommandLineArgs& args, const GenerationProgressCallback& onProgress = nullptr);
+
+    /**
+     * @brief Get the directory containing the executable (with trailing separator)
+     * @return Executable directory, or empty string if unknown
      */
-    static int GenerateWithLLM(CommandLineArgs& args);
+    static std::string GetExecutableDirectory();
 };
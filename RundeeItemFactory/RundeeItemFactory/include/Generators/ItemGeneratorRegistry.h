@@ -17,6 +17,13 @@
 
 namespace ItemGeneratorRegistry
 {
+    /**
+     * @brief Get the file path of a type's registry
+     * @param typeName Item type name (e.g., "food", "weapon")
+     * @return Registry file path
+     */
+    std::string GetRegistryFilePath(const std::string& typeName);
+    
     /**
      * @brief Load item IDs from registry file
      * @param typeName Item type name (e.g., "Food", "Weapon")
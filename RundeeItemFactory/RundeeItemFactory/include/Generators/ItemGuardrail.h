@@ -0,0 +1,75 @@
+/**
+ * @file ItemGuardrail.h
+ * @brief Banned-term screening of generated items
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ * 
+ * The banned list (config "guardrail.bannedTerms" plus the profile's
+ * "bannedTerms") is compiled once into an Aho-Corasick automaton; every
+ * string field of every parsed item, including strings nested in arrays and
+ * objects, is then scanned in a single pass per string.
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include "Utils/AhoCorasick.h"
+#include <json.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @struct GuardrailReport
+ * @brief Accumulated guardrail results for a run
+ */
+struct GuardrailReport
+{
+    int itemsScanned = 0;                       ///< Items passed to ScanItem
+    int itemsWithHits = 0;                      ///< Items containing at least one banned term
+    int totalHits = 0;                          ///< Term occurrences across all items
+    std::map<std::string, int> hitsByField;     ///< Occurrences per field path (e.g., "description", "tags[]")
+    std::map<std::string, int> hitsByTerm;      ///< Occurrences per banned term
+};
+
+/**
+ * @class ItemGuardrail
+ * @brief Compiled banned-term scanner for one item profile
+ */
+class ItemGuardrail
+{
+public:
+    /**
+     * @brief Compile the banned list for a profile (config terms + profile terms)
+     * @param profile Item profile whose bannedTerms are added
+     */
+    explicit ItemGuardrail(const ItemProfile& profile);
+
+    /**
+     * @brief Scan every string field of an item
+     * @param item Parsed item
+     * @param report Report to accumulate hits into
+     * @return Number of banned-term occurrences found in the item
+     */
+    int ScanItem(const nlohmann::json& item, GuardrailReport& report) const;
+
+    /**
+     * @brief Check whether items with hits should be dropped
+     * @return True if config requests rejection (guardrail.rejectOnHit)
+     */
+    bool RejectsOnHit() const { return m_rejectOnHit; }
+
+    /**
+     * @brief Get the number of compiled terms
+     * @return Term count
+     */
+    size_t GetTermCount() const { return m_matcher.GetTerms().size(); }
+
+private:
+    void ScanValue(const nlohmann::json& value, const std::string& path,
+                   std::map<std::string, int>& fieldHits, std::map<int, int>& termHits) const;
+
+    AhoCorasickMatcher m_matcher;
+    bool m_rejectOnHit = true;
+};
@@ -0,0 +1,45 @@
+/**
+ * @file ManifestRunner.h
+ * @brief Runs many generation jobs from a manifest in one process (--manifest mode)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Manifest format (a bare array of jobs is also accepted):
+ * @code
+ * {
+ *   "concurrency": 2,
+ *   "defaults": { "model": "llama3" },
+ *   "jobs": [
+ *     { "profile": "realistic_food", "count": 20, "out": "items_food.json" },
+ *     { "profile": "realistic_firearms", "playerProfile": "hardcore", "count": 10, "out": "items_weapon.json" }
+ *   ]
+ * }
+ * @endcode
+ * Each job uses the keys understood by CommandLineParser::ParseJobJson.
+ * Jobs share the process-wide GenerationCache and OllamaClient connections.
+ */
+
+#pragma once
+
+#include "Helpers/CommandLineParser.h"
+
+/**
+ * @class ManifestRunner
+ * @brief Static entry point for manifest mode
+ */
+class ManifestRunner
+{
+public:
+    /**
+     * @brief Run every job listed in a manifest
+     * @param defaults Arguments used for job fields that are not specified
+     * @return Exit code (0 = all jobs succeeded)
+     *
+     * Jobs are validated up front, then run by a small pool of workers so
+     * that one job's LLM request is in flight while another job parses,
+     * validates and writes its batch. Larger jobs start first so the pool
+     * stays busy until the end of the run.
+     */
+    static int Run(const CommandLineArgs& defaults);
+};
@@ -0,0 +1,86 @@
+/**
+ * @file QuotaScheduler.h
+ * @brief Target value distributions for allowedValues fields across batches
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * An item profile may declare "quotas", e.g.
+ * {"rarity": {"Common": 50, "Uncommon": 30, "Rare": 20}}. The shares are
+ * turned into per-value item counts for the run; each batch is then asked for
+ * the values that are still short, and items whose value is already filled are
+ * dropped before they are written.
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include <json.hpp>
+#include <map>
+#include <string>
+
+/**
+ * @brief Per-field, per-value item counts (field name -> value -> count)
+ */
+using QuotaCounts = std::map<std::string, std::map<std::string, int>>;
+
+/**
+ * @class QuotaScheduler
+ * @brief Tracks the running value histogram of a run against its quotas
+ */
+class QuotaScheduler
+{
+public:
+    /**
+     * @brief Build quota targets for one run
+     * @param profile Item profile declaring the quotas (fields without allowedValues are ignored)
+     * @param totalCount Number of items the run produces
+     */
+    QuotaScheduler(const ItemProfile& profile, int totalCount);
+
+    /**
+     * @brief Whether the profile declares any usable quota
+     */
+    bool HasQuotas() const { return !m_targets.empty(); }
+
+    /**
+     * @brief Count an item that is already part of the run (e.g. resumed from a checkpoint)
+     * @param item Item JSON
+     */
+    void Record(const nlohmann::json& item);
+
+    /**
+     * @brief Accept an item if none of its quota buckets is full
+     * @param item Item JSON
+     * @param reason Receives "field=value" of the full bucket when rejected
+     * @return True if the item was counted, false if it must be dropped
+     */
+    bool TryAccept(const nlohmann::json& item, std::string& reason);
+
+    /**
+     * @brief Undo TryAccept() for an item that was dropped afterwards
+     * @param item Item JSON
+     */
+    void Release(const nlohmann::json& item);
+
+    /**
+     * @brief Split the next request across the buckets that are still short
+     * @param batchCount Number of items the next request asks for
+     * @return Per-field, per-value counts summing to batchCount for every field
+     */
+    QuotaCounts PlanBatch(int batchCount) const;
+
+    /**
+     * @brief Target counts for the whole run
+     */
+    const QuotaCounts& GetTargets() const { return m_targets; }
+
+    /**
+     * @brief Counts accepted so far
+     */
+    const QuotaCounts& GetCounts() const { return m_counts; }
+
+private:
+    QuotaCounts m_targets;
+    QuotaCounts m_counts;
+};
@@ -0,0 +1,104 @@
+/**
+ * @file RunCheckpoint.h
+ * @brief Batch-granular checkpointing of generation runs (--resume support)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Layout of a checkpointed run:
+ * - Checkpoints/<runId>/run.json    : run manifest (job arguments, accepted count, status),
+ *                                     replaced atomically after every batch
+ * - Checkpoints/<runId>/items.jsonl : accepted items, one JSON object per line,
+ *                                     appended and synced after every batch
+ */
+
+#pragma once
+
+#include "Helpers/CommandLineParser.h"
+#include <json.hpp>
+#include <string>
+#include <vector>
+
+/**
+ * @class RunCheckpoint
+ * @brief Durable record of the items accepted so far by one generation run
+ */
+class RunCheckpoint
+{
+public:
+    /**
+     * @brief Create a new unique run ID (timestamp plus random suffix)
+     * @return Run ID usable with --resume
+     */
+    static std::string NewRunId();
+
+    /**
+     * @brief Check that a run ID has exactly the form NewRunId() produces
+     *        (YYYYMMDD-HHMMSS-xxxx), so it cannot name a path outside Checkpoints/
+     * @param runId Run ID from --resume or a job's "resume" field
+     * @return True if the ID is well-formed
+     */
+    static bool IsValidRunId(const std::string& runId);
+
+    /**
+     * @brief Get the directory holding a run's checkpoint files
+     * @param runId Run ID (must pass IsValidRunId)
+     * @return Directory path (with trailing separator)
+     */
+    static std::string GetRunDirectory(const std::string& runId);
+
+    /**
+     * @brief Start checkpointing a new run
+     * @param runId Run ID (see NewRunId)
+     * @param args Job arguments recorded in the run manifest
+     * @return True if the run manifest was written
+     */
+    bool Begin(const std::string& runId, const CommandLineArgs& args);
+
+    /**
+     * @brief Reopen an existing run
+     * @param runId Run ID to resume
+     * @param inOutArgs Job arguments; replaced by the arguments recorded for the run
+     * @param outItems Items accepted before the run stopped
+     * @param outCompleted True if the run already finished writing its output
+     * @return True if the run was found and loaded
+     */
+    bool Resume(const std::string& runId, CommandLineArgs& inOutArgs,
+                std::vector<nlohmann::json>& outItems, bool& outCompleted);
+
+    /**
+     * @brief Durably record a batch of newly accepted items
+     * @param items Accepted items; the batch is items[first..end)
+     * @param first Index of the first item of this batch
+     * @param totalAccepted Total items accepted by the run so far
+     * @return True if the items and manifest were synced to disk
+     */
+    bool CommitBatch(const std::vector<nlohmann::json>& items, size_t first, int totalAccepted);
+
+    /**
+     * @brief Mark the run as finished (output file and registry written)
+     * @param totalAccepted Final number of accepted items
+     * @return True if the manifest was updated
+     */
+    bool MarkCompleted(int totalAccepted);
+
+    /**
+     * @brief Get the run ID
+     * @return Run ID, or empty string before Begin/Resume
+     */
+    const std::string& GetRunId() const { return m_runId; }
+
+private:
+    /**
+     * @brief Rewrite run.json with the current state
+     * @param status Run status ("running" or "completed")
+     * @param totalAccepted Accepted item count
+     * @return True on success
+     */
+    bool WriteManifest(const std::string& status, int totalAccepted);
+
+    std::string m_runId;
+    std::string m_runDir;
+    nlohmann::json m_job;
+    int m_batches = 0;
+};
@@ -12,6 +12,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 /**
  * @struct OllamaSettings
@@ -71,6 +72,51 @@ struct OllamaSettings
     int receiveTimeoutMs = 120000;
 };
 
+/**
+ * @struct GuardrailSettings
+ * @brief Configuration for screening generated items for banned terms
+ */
+struct GuardrailSettings
+{
+    /**
+     * @brief Terms that must not appear in any string field (case-insensitive substring match)
+     * 
+     * Item profiles can add more terms through their "bannedTerms" array.
+     * Default: placeholder/test words
+     */
+    std::vector<std::string> bannedTerms = { "dummy", "lorem", "ipsum", "placeholder", "test item", "badword" };
+
+    /**
+     * @brief Drop items that contain a banned term (false = report only)
+     * 
+     * Default: true
+     */
+    bool rejectOnHit = true;
+};
+
+/**
+ * @struct CommitSettings
+ * @brief Configuration for the background catalog committer (see CatalogCommitter)
+ */
+struct CommitSettings
+{
+    /**
+     * @brief How long the committer waits after the first queued request to collect more (milliseconds)
+     * 
+     * Requests arriving within the window share one output rewrite and one registry save.
+     * The window is skipped when no other job is running.
+     * Default: 200
+     */
+    int intervalMs = 200;
+
+    /**
+     * @brief Queued items that trigger a commit before the window ends
+     * 
+     * Default: 5000
+     */
+    int maxItems = 5000;
+};
+
 /**
  * @class AppConfig
  * @brief Static class for loading and accessing application configuration
@@ -112,6 +158,20 @@ public:
      */
     static const OllamaSettings& GetOllamaSettings();
 
+    /**
+     * @brief Access loaded guardrail settings
+     * 
+     * @return Reference to GuardrailSettings structure
+     */
+    static const GuardrailSettings& GetGuardrailSettings();
+
+    /**
+     * @brief Access loaded commit settings
+     * 
+     * @return Reference to CommitSettings structure
+     */
+    static const CommitSettings& GetCommitSettings();
+
 private:
     /**
      * @brief Ensure configuration is loaded
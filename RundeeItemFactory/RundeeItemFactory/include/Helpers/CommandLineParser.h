@@ -13,6 +13,7 @@
 
 #include <string>
 #include <vector>
+#include <json.hpp>
 #include "Helpers/ItemGenerateParams.h"
 
 /**
@@ -41,6 +42,17 @@ enum class ItemType
     Clothing         ///< Clothing items (warmth and style)
 };
 
+/**
+ * @enum OutputFormat
+ * @brief Catalog format(s) written for generated items
+ */
+enum class OutputFormat
+{
+    Json,    ///< Pretty-printed JSON array (items_x.json)
+    Binary,  ///< MessagePack records with an id index (items_x.ricat, see BinaryCatalogWriter)
+    Both     ///< Both files
+};
+
 /**
  * @struct CommandLineArgs
  * @brief Parsed command line arguments structure
@@ -56,12 +68,28 @@ struct CommandLineArgs
     ItemType itemType = ItemType::Food;      ///< Item type to generate
     FoodGenerateParams params;               ///< Item-specific generation parameters
     std::string reportPath;                  ///< Path to JSON file for balance report (empty if not reporting)
+    std::string validatePath;                ///< Path to JSON file to re-validate against its profile (empty if not validating)
     
     std::string customPresetPath;            ///< Path to custom preset JSON file (empty if using built-in preset)
     std::string additionalPrompt;           ///< Additional user-defined prompt text to append
     bool useTestMode = false;                ///< If true, outputs go to Test/ folder instead of ItemJson/
     std::string profileId;                   ///< Item profile ID to use for generation (empty = use default profile for item type)
     std::string playerProfileId;             ///< Player profile ID to use for generation (empty = use default player profile)
+    
+    bool serveMode = false;                  ///< If true, run as a long-lived local job server (--serve)
+    int servePort = 11500;                   ///< Loopback port for serve mode (--port)
+    
+    std::string resumeRunId;                 ///< Checkpointed run to continue (--resume, empty = start a new run)
+    
+    std::string manifestPath;                ///< Path to a jobs manifest to run in one process (--manifest, empty = single job)
+    int manifestConcurrency = 0;             ///< Jobs kept in flight for a manifest run (--concurrency, 0 = manifest value or default)
+    
+    OutputFormat outputFormat = OutputFormat::Json; ///< Catalog format(s) to write (--format)
+    int shardCount = 1;                      ///< Output shards per catalog (--shards, 1 = single file, see ShardedCatalogWriter)
+    int repairLimit = 20;                    ///< Invalid items sent back for repair per batch (--repair, 0 = drop them)
+    
+    std::string benchSuite;                  ///< Benchmark suite to run instead of generating (--bench, empty = none)
+    std::string benchFile;                   ///< Catalog the benchmark reads (--benchFile, empty = output path)
 };
 
 /**
@@ -78,6 +106,49 @@ namespace CommandLineParser
      */
     CommandLineArgs ParseArguments(int argc, char** argv);
     
+    /**
+     * @brief Build job arguments from a JSON job description
+     * 
+     * Recognized keys mirror the command line flags: "model", "itemType",
+     * "count", "profile", "playerProfile", "out", "additionalPrompt", "format", "shards",
+     * "repair", "resume".
+     * Keys that are missing keep the value from defaults.
+     * 
+     * @param job JSON object describing one generation job
+     * @param defaults Arguments used for keys not present in the job
+     * @param outArgs Resulting job arguments
+     * @param outError Error message if the job is invalid
+     * @return True if the job was valid
+     */
+    bool ParseJobJson(const nlohmann::json& job, const CommandLineArgs& defaults,
+                      CommandLineArgs& outArgs, std::string& outError);
+    
+    /**
+     * @brief Describe job arguments as a JSON job object
+     * 
+     * Inverse of ParseJobJson: parsing the result with the same defaults
+     * yields the same job.
+     * 
+     * @param args Job arguments
+     * @return JSON object with the keys understood by ParseJobJson
+     */
+    nlohmann::json JobToJson(const CommandLineArgs& args);
+    
+    /**
+     * @brief Resolve an output filename to the executable's ItemJson folder
+     * @param outPath Output path or filename as given by the user
+     * @return Full output path inside ItemJson/
+     */
+    std::string ResolveOutputPath(const std::string& outPath);
+    
+    /**
+     * @brief Parse an item type name (case-insensitive)
+     * @param typeStr Type name (e.g., "food", "weaponcomponent")
+     * @param outType Parsed item type
+     * @return True if the name was recognized
+     */
+    bool TryParseItemType(const std::string& typeStr, ItemType& outType);
+    
     /**
      * @brief Get run mode name as string
      * @param mode Run mode
@@ -91,4 +162,19 @@ namespace CommandLineParser
      * @return Type name string
      */
     std::string GetItemTypeName(ItemType type);
+    
+    /**
+     * @brief Parse an output format name ("json", "binary", "both")
+     * @param formatStr Format name
+     * @param outFormat Parsed format
+     * @return True if the name was recognized
+     */
+    bool TryParseOutputFormat(const std::string& formatStr, OutputFormat& outFormat);
+    
+    /**
+     * @brief Get output format name as string
+     * @param format Output format
+     * @return Format name ("json", "binary", "both")
+     */
+    std::string GetOutputFormatName(OutputFormat format);
 }
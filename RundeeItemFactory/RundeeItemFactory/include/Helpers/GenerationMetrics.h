@@ -0,0 +1,170 @@
+/**
+ * @file GenerationMetrics.h
+ * @brief Aggregation of LLM call statistics per model and per profile
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Collects the per-call counters returned by Ollama (OllamaCallStats) and
+ * the number of items that survived parsing and duplicate filtering, so a
+ * run can be broken down into model load, prefill and decode time.
+ */
+
+#pragma once
+
+#include <string>
+#include "Clients/OllamaClient.h"
+
+/**
+ * @struct GenerationMetricsTotals
+ * @brief Summed counters for one (model, profile) pair or one rollup
+ */
+struct GenerationMetricsTotals
+{
+    int calls = 0;                        ///< Number of successful LLM calls
+    int callsWithServerStats = 0;         ///< Calls whose response carried eval counters
+    long long promptTokens = 0;           ///< Sum of prompt_eval_count
+    long long generatedTokens = 0;        ///< Sum of eval_count
+    long long promptEvalDurationNs = 0;   ///< Sum of prompt_eval_duration
+    long long evalDurationNs = 0;         ///< Sum of eval_duration
+    long long loadDurationNs = 0;         ///< Sum of load_duration
+    double wallSeconds = 0.0;             ///< Sum of client-side wall time
+    long long acceptedItems = 0;          ///< Items accepted after parsing/dedup
+    long long requestedItems = 0;         ///< Items asked for across all requests (including over-generation)
+    long long usableItems = 0;            ///< Items that parsed and were not duplicates
+    double predictedUsableItems = 0.0;    ///< Usable items expected from the predicted yield
+    int batches = 0;                      ///< Responses run through parse/validate/dedup
+    long long batchAllocations = 0;       ///< Heap allocations made while processing those responses
+    long long batchAllocatedBytes = 0;    ///< Bytes requested by those allocations
+    int repairCalls = 0;                  ///< Requests that sent invalid items back for repair
+    long long repairSentItems = 0;        ///< Invalid items sent in those requests
+    long long repairedItems = 0;          ///< Sent items that came back valid
+    long long repairPromptTokens = 0;     ///< Prompt tokens of the repair requests (also in promptTokens)
+
+    /**
+     * @brief Prefill throughput in tokens per second (0 if unknown)
+     */
+    double PrefillTokensPerSecond() const;
+
+    /**
+     * @brief Decode throughput in tokens per second (0 if unknown)
+     */
+    double DecodeTokensPerSecond() const;
+
+    /**
+     * @brief Generated tokens spent per accepted item (0 if no items accepted)
+     */
+    double GeneratedTokensPerAcceptedItem() const;
+
+    /**
+     * @brief Share of requested items that were usable (0 if nothing was requested)
+     */
+    double ActualYield() const;
+
+    /**
+     * @brief Yield that was predicted when the requests were sized (0 if nothing was requested)
+     */
+    double PredictedYield() const;
+
+    /**
+     * @brief Average heap allocations per processed response (0 if none recorded)
+     */
+    double AllocationsPerBatch() const;
+
+    /**
+     * @brief Add another totals structure into this one
+     * @param other Totals to add
+     */
+    void Add(const GenerationMetricsTotals& other);
+};
+
+/**
+ * @class GenerationMetrics
+ * @brief Static, thread-safe collector for generation statistics
+ *
+ * Records are keyed by (model, profile). The report prints one line per
+ * model and one line per profile so a slow run can be attributed to model
+ * load, prompt size (prefill) or decode speed.
+ */
+class GenerationMetrics
+{
+public:
+    /**
+     * @brief Record one successful LLM call
+     * @param modelName Model used for the call
+     * @param profileId Item profile the call generated for
+     * @param stats Stats returned by OllamaClient
+     */
+    static void RecordCall(const std::string& modelName,
+                           const std::string& profileId,
+                           const OllamaCallStats& stats);
+
+    /**
+     * @brief Record items accepted after parsing and duplicate filtering
+     * @param modelName Model that produced the items
+     * @param profileId Item profile the items belong to
+     * @param count Number of accepted items
+     */
+    static void RecordAcceptedItems(const std::string& modelName,
+                                    const std::string& profileId,
+                                    int count);
+
+    /**
+     * @brief Record the predicted and actual yield of one request
+     * @param modelName Model used for the request
+     * @param profileId Item profile the request generated for
+     * @param requested Items asked for in the prompt
+     * @param predictedYield Yield the request was sized with (0..1)
+     * @param usable Items that parsed and were not duplicates
+     */
+    static void RecordYield(const std::string& modelName,
+                            const std::string& profileId,
+                            int requested,
+                            double predictedYield,
+                            int usable);
+
+    /**
+     * @brief Record the heap traffic of processing one response
+     * @param modelName Model that produced the response
+     * @param profileId Item profile the response generated for
+     * @param allocations Allocations made by parse, validation and duplicate filtering
+     * @param allocatedBytes Bytes requested by those allocations
+     */
+    static void RecordBatchAllocations(const std::string& modelName,
+                                       const std::string& profileId,
+                                       long long allocations,
+                                       long long allocatedBytes);
+
+    /**
+     * @brief Record one repair request for items that failed validation
+     * @param modelName Model that repaired the items
+     * @param profileId Item profile the items belong to
+     * @param sent Invalid items sent in the request
+     * @param repaired Items that came back valid
+     * @param stats Stats of the call (RecordCall is made for it as well)
+     */
+    static void RecordRepair(const std::string& modelName,
+                             const std::string& profileId,
+                             int sent,
+                             int repaired,
+                             const OllamaCallStats& stats);
+
+    /**
+     * @brief Get the totals recorded for a (model, profile) pair
+     * @param modelName Model name
+     * @param profileId Item profile ID
+     * @return Totals (all zero if nothing was recorded)
+     */
+    static GenerationMetricsTotals GetTotals(const std::string& modelName,
+                                             const std::string& profileId);
+
+    /**
+     * @brief Print per-model and per-profile summaries to std::cout
+     */
+    static void PrintReport();
+
+    /**
+     * @brief Clear all recorded statistics
+     */
+    static void Reset();
+};
@@ -0,0 +1,106 @@
+/**
+ * @file BinaryCatalogReader.h
+ * @brief Random-access reader for the indexed binary item catalog (.ricat)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Opening a catalog reads the footer and the id index only. Find() locates an
+ * item with a binary search over the sorted index and decodes just that
+ * record; the rest of the file is never parsed. See BinaryCatalogWriter.h for
+ * the file layout.
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @class BinaryCatalogReader
+ * @brief Reader for one .ricat file
+ */
+class BinaryCatalogReader
+{
+public:
+    /**
+     * @brief Open a catalog and load its index
+     * @param path .ricat file path
+     * @return False if the file is missing or not a valid catalog
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Close the file and drop the index
+     */
+    void Close();
+
+    /**
+     * @brief Whether a catalog is open
+     */
+    bool IsOpen() const { return m_file.is_open(); }
+
+    /**
+     * @brief Number of items in the catalog
+     */
+    size_t GetCount() const { return m_entries.size(); }
+
+    /**
+     * @brief ID of the n-th index entry (IDs are sorted)
+     * @param index Entry index (< GetCount())
+     */
+    std::string GetId(size_t index) const;
+
+    /**
+     * @brief Fetch one item by ID (O(log n) index lookups, one record decoded)
+     * @param id Item ID
+     * @param outItem Decoded item
+     * @return False if the ID is not in the catalog or the record is corrupt
+     */
+    bool Find(const std::string& id, nlohmann::json& outItem);
+
+    /**
+     * @brief Read the raw MessagePack bytes of the n-th index entry
+     * @param index Entry index (< GetCount())
+     * @param outRecord Record bytes
+     * @return False on read error
+     */
+    bool ReadRecord(size_t index, std::string& outRecord);
+
+    /**
+     * @brief Position of the n-th index entry's record in the file
+     * @param index Entry index (< GetCount())
+     * @return Byte offset (records are stored in catalog order)
+     */
+    uint64_t GetRecordOffset(size_t index) const { return m_entries[index].recordOffset; }
+
+    /**
+     * @brief Length of the n-th index entry's record
+     * @param index Entry index (< GetCount())
+     */
+    uint32_t GetRecordLength(size_t index) const { return m_entries[index].recordLength; }
+
+    /**
+     * @brief Read every record as one block (header end up to the index), undecoded
+     * @param outBytes Record bytes; a record at file offset X is at outBytes[X - header size]
+     * @return False on read error
+     */
+    bool ReadRecordSection(std::string& outBytes);
+
+private:
+    struct IndexEntry
+    {
+        uint64_t recordOffset = 0;
+        uint64_t idOffset = 0;
+        uint32_t idLength = 0;
+        uint32_t recordLength = 0;
+    };
+
+    std::ifstream m_file;
+    std::vector<IndexEntry> m_entries;
+    std::string m_idPool;
+    uint64_t m_indexOffset = 0;
+};
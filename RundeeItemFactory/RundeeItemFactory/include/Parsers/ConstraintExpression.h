@@ -0,0 +1,111 @@
+/**
+ * @file ConstraintExpression.h
+ * @brief Field constraint expressions compiled to a small stack bytecode
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Grammar (lowest precedence first):
+ *   expr    := and ( ("||" | "or") and )*
+ *   and     := compare ( ("&&" | "and") compare )*
+ *   compare := sum ( ("==" | "=" | "!=" | "<" | "<=" | ">" | ">=") sum )?
+ *   sum     := product ( ("+" | "-") product )*
+ *   product := unary ( ("*" | "/" | "%") unary )*
+ *   unary   := ("-" | "!" | "not") unary | primary
+ *   primary := number | 'text' | "text" | true | false
+ *            | field | function "(" expr ("," expr)* ")" | "(" expr ")"
+ * Functions: min, max, abs, floor, ceil, round, len (string length or
+ * array/object size). "value" names the field that owns a custom
+ * constraint.
+ *
+ * Field names are resolved to slots at compile time, so evaluating an item
+ * looks each referenced field up once and runs a few instructions without
+ * allocating. A field that is missing or has the wrong type makes the
+ * constraint not applicable rather than failed; the field validator already
+ * reports those.
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class ConstraintExpression
+ * @brief One compiled true/false expression over an item's fields
+ */
+class ConstraintExpression
+{
+public:
+    /**
+     * @enum Result
+     * @brief Outcome of evaluating an item
+     */
+    enum class Result
+    {
+        Pass,
+        Fail,
+        NotApplicable   ///< A referenced field is missing or has the wrong type, or a division by zero
+    };
+
+    /**
+     * @brief Compile an expression
+     * @param text Expression text (e.g. "hungerRestore >= thirstRestore")
+     * @param selfField Field that "value" refers to (empty if none)
+     * @param outError Set to the reason when compiling fails
+     * @return True if the text is a valid true/false expression
+     */
+    bool Compile(const std::string& text, const std::string& selfField, std::string* outError = nullptr);
+
+    /**
+     * @brief Evaluate the expression on an item
+     * @param item Item object
+     * @return Pass, Fail or NotApplicable (also for an expression that was not compiled)
+     */
+    Result Evaluate(const nlohmann::json& item) const;
+
+    /**
+     * @brief Referenced fields with the item's values, for error messages ("weight=12, maxWeight=10")
+     */
+    std::string DescribeValues(const nlohmann::json& item) const;
+
+    /**
+     * @brief Source text of the compiled expression
+     */
+    const std::string& GetText() const { return m_text; }
+
+    /**
+     * @brief Fields the expression reads
+     */
+    const std::vector<std::string>& GetFields() const { return m_fields; }
+
+private:
+    friend class ConstraintCompiler;
+
+    enum class Op : uint8_t
+    {
+        PushNumber, PushString, PushBool, LoadField,
+        Add, Subtract, Multiply, Divide, Modulo, Negate, Not,
+        Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual,
+        And, Or, Call
+    };
+
+    /**
+     * @struct Instruction
+     * @brief One bytecode instruction; operand indexes m_numbers, m_strings or m_fields, or is a function ID
+     */
+    struct Instruction
+    {
+        Op op;
+        uint8_t argCount;
+        uint16_t operand;
+    };
+
+    std::string m_text;
+    std::vector<Instruction> m_code;
+    std::vector<double> m_numbers;
+    std::vector<std::string> m_strings;
+    std::vector<std::string> m_fields;
+};
@@ -16,6 +16,20 @@
 #include <vector>
 #include <json.hpp>
 
+class IdShortener;
+class ProfileConstraints;
+
+/**
+ * @struct RejectedItem
+ * @brief An object from an LLM response that failed profile validation
+ */
+struct RejectedItem
+{
+    nlohmann::json item;                       ///< The object as parsed (defaults, id and displayName filled in)
+    std::vector<std::string> errors;           ///< Validation error messages
+    std::vector<std::string> invalidFields;    ///< Profile fields those errors refer to
+};
+
 /**
  * @class DynamicItemJsonParser
  * @brief Static class for parsing items dynamically from JSON
@@ -32,24 +46,31 @@ public:
      * @param jsonText JSON text to parse
      * @param profile Profile defining the expected structure
      * @param outItems Output vector of parsed items (as JSON objects)
-     * @return True if parsing succeeded
+     * @param outRejected Optional output for objects that failed validation, so they can be
+     *                    sent back for repair instead of being regenerated (may be nullptr)
+     * @return True if at least one item parsed and validated
      */
     static bool ParseItemsFromJsonText(
         const std::string& jsonText,
         const ItemProfile& profile,
-        std::vector<nlohmann::json>& outItems);
+        std::vector<nlohmann::json>& outItems,
+        std::vector<RejectedItem>* outRejected = nullptr);
     
     /**
      * @brief Validate an item against its profile
      * @param item JSON object representing an item
      * @param profile Profile to validate against
      * @param errors Output vector of error messages
+     * @param outInvalidFields Optional output for the names of the fields that failed (may be nullptr)
+     * @param constraints Compiled relationship/custom constraints of the profile (nullptr = look up the cached ones)
      * @return True if item is valid
      */
     static bool ValidateItem(
         const nlohmann::json& item,
         const ItemProfile& profile,
-        std::vector<std::string>& errors);
+        std::vector<std::string>& errors,
+        std::vector<std::string>* outInvalidFields = nullptr,
+        const ProfileConstraints* constraints = nullptr);
     
     /**
      * @brief Apply default values from profile to an item
@@ -71,12 +92,27 @@ public:
         const ItemProfile& profile);
     
     /**
-     * @brief Generate short ID from displayName by extracting key identifiers
+     * @brief Generate short ID from displayName by extracting key identifiers (built-in rules)
      * @param displayName Display name to process
      * @return Short ID suffix (without prefix)
      */
     static std::string GenerateShortIdFromDisplayName(const std::string& displayName);
 
+    /**
+     * @brief Generate short ID from displayName with the profile's idShortening rules
+     * @param displayName Display name to process
+     * @param profile Profile whose compiled rules are used (see IdShortener)
+     * @return Short ID suffix (without prefix)
+     */
+    static std::string GenerateShortIdFromDisplayName(const std::string& displayName, const ItemProfile& profile);
+
+    /**
+     * @brief Item type prefix of generated IDs ("Weapon Component" -> "weaponcomponent")
+     * @param profile Profile whose itemTypeName is used
+     * @return Lowercase alphanumeric prefix (without the trailing '_')
+     */
+    static std::string GetIdPrefix(const ItemProfile& profile);
+
 private:
     /**
      * @brief Validate a single field value
@@ -99,12 +135,17 @@ private:
     
     /**
      * @brief Ensure id and displayName are present, generate if missing
+     *
+     * This is the only place items get their id/displayName filled in; it
+     * edits the item in place so callers can move it on afterwards.
      * @param item JSON item to modify
      * @param profile Profile for context
+     * @param shortener Compiled idShortening rules of the profile
      * @param index Item index for generating unique ID
      */
     static void EnsureIdAndDisplayName(
         nlohmann::json& item,
         const ItemProfile& profile,
+        const IdShortener& shortener,
         size_t index);
 };
@@ -0,0 +1,103 @@
+/**
+ * @file IdShortener.h
+ * @brief Compiled rules that shorten display names into ID suffixes
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * An Item Profile may declare its own shortening rules, e.g.
+ *   "idShortening": {
+ *     "removeWords": ["rifle", "mk", "semi-auto"],
+ *     "abbreviations": {"heckler": "hk", "koch": ""}
+ *   }
+ * A key that is left out keeps the built-in list. Profiles without the
+ * section use the built-in rules.
+ *
+ * The rules are compiled once into a dictionary keyed by a rule's first
+ * word. Shortening looks each word of the lowercase name up once and runs
+ * only the rules found there (plus the few without letters or digits, like
+ * "&"), so a name that no rule touches costs one lookup per word.
+ *
+ * The rules that do run keep the old find/erase semantics and order:
+ * remove words in list order, then abbreviations in key order. A removed
+ * word takes one following space or hyphen with it, which can close up a
+ * later multi-word rule ("pump-semi-auto-action" -> "pump-action" -> "").
+ * A non-empty abbreviation swallows the same, gluing the next word to it
+ * ("Smith & Wesson" -> "swwesson"); the glued word is looked up again for
+ * later rules. Keeping these quirks keeps the IDs of existing catalogs
+ * stable.
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class IdShortener
+ * @brief Rule set compiled into a token dictionary
+ */
+class IdShortener
+{
+public:
+    /**
+     * @brief Compile a rule set
+     * @param rules Remove words and abbreviations (patterns without letters or digits, like "&", can only be removed)
+     */
+    explicit IdShortener(const IdShorteningRules& rules);
+
+    /**
+     * @brief Shorten a display name ("Heckler & Koch HK416 Carbine" -> "hkkochhk416")
+     * @param displayName Display name to process
+     * @return Lowercase alphanumeric ID suffix (may be empty)
+     */
+    std::string Shorten(const std::string& displayName) const;
+
+    /**
+     * @brief Number of compiled rules
+     */
+    size_t GetRuleCount() const { return m_rules.size(); }
+
+    /**
+     * @brief Built-in rules, used by profiles without an "idShortening" section
+     */
+    static const IdShorteningRules& GetDefaultRules();
+
+    /**
+     * @brief Shortener for the built-in rules (compiled on first use)
+     */
+    static const IdShortener& Default();
+
+    /**
+     * @brief Shortener for a profile's rules, compiled once and cached by profile ID
+     * @param profile Profile whose idShortening rules are used
+     * @return Compiled shortener (the built-in one if the profile sets no rules)
+     */
+    static std::shared_ptr<const IdShortener> ForProfile(const ItemProfile& profile);
+
+private:
+    /**
+     * @struct Rule
+     * @brief One compiled rule; its index in m_rules is its precedence
+     */
+    struct Rule
+    {
+        std::string pattern;     ///< Lowercase text found and replaced as a whole word
+        std::string replacement; ///< Lowercase alphanumeric replacement (empty = remove)
+    };
+
+    void AddRule(const std::string& pattern, const std::string& replacement);
+
+    /** @brief Queue the rules keyed by a word of @p text that run after rule @p after, in precedence order */
+    void QueueRules(const std::string& text, int after, std::vector<int>& queued) const;
+
+    /** @brief One old find/erase pass of a rule over @p text; returns whether it changed */
+    static bool Apply(const Rule& rule, std::string& text);
+
+    std::vector<Rule> m_rules;
+    std::unordered_map<std::string, std::vector<int>> m_byFirstToken; ///< First word -> rule indices, earliest first
+    std::vector<int> m_symbolRules;                                   ///< Rules without letters or digits, always run
+};
@@ -0,0 +1,103 @@
+/**
+ * @file LazyCatalogReader.h
+ * @brief Memory-mapped reader for JSON item catalogs that parses items on demand
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * A catalog (items_*.json) is one top-level array. Instead of building a DOM
+ * for the whole file, the reader maps it, finds element boundaries with a
+ * structural scan and hands out raw element text; an element is only parsed
+ * when GetItem() asks for it. Streaming passes (ForEachItem/ForEachId) drop
+ * pages behind the scan, so resident memory stays flat for any file size.
+ */
+
+#pragma once
+
+#include "Utils/MappedFile.h"
+#include <json.hpp>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @class LazyCatalogReader
+ * @brief Reader for one JSON catalog file
+ */
+class LazyCatalogReader
+{
+public:
+    /**
+     * @brief Map a catalog file
+     * @param path JSON catalog path
+     * @return False if the file is missing or its root is not an array
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Unmap the file and drop the element index
+     */
+    void Close();
+
+    /**
+     * @brief Whether a catalog is mapped
+     */
+    bool IsOpen() const { return m_file.IsOpen(); }
+
+    /**
+     * @brief Visit the raw text of every element in file order
+     *
+     * Single structural pass; no element index is built.
+     *
+     * @param onItem Receives (text, length) of each element; return false to stop
+     * @return False if the array is truncated or malformed (elements before the damage are still visited)
+     */
+    bool ForEachItem(const std::function<bool(const char*, size_t)>& onItem);
+
+    /**
+     * @brief Visit the "id" of every object element without parsing the elements
+     * @param onId Receives each string ID in file order
+     * @return False if the array is truncated or malformed
+     */
+    bool ForEachId(const std::function<void(const std::string&)>& onId);
+
+    /**
+     * @brief Number of elements (builds the element index on first use)
+     */
+    size_t GetCount();
+
+    /**
+     * @brief Raw text of the n-th element
+     * @param index Element index (< GetCount())
+     * @return Pointer into the mapping and length; valid until Close()
+     */
+    std::pair<const char*, size_t> GetRaw(size_t index);
+
+    /**
+     * @brief Parse the n-th element
+     * @param index Element index (< GetCount())
+     * @param outItem Parsed element
+     * @return False if the element is not valid JSON
+     */
+    bool GetItem(size_t index, nlohmann::json& outItem);
+
+    /**
+     * @brief Drop the resident pages of elements a pass is done with
+     *
+     * For passes over GetRaw() that keep memory flat the way ForEachItem() does;
+     * the pages are read back from disk if touched again.
+     *
+     * @param first First element index
+     * @param last One past the last element index (<= GetCount())
+     */
+    void Release(size_t first, size_t last);
+
+private:
+    /** @brief Build m_spans if it has not been built yet (a truncated array keeps the elements before the damage) */
+    void EnsureIndex();
+
+    MappedFile m_file;
+    std::vector<std::pair<size_t, size_t>> m_spans;
+    bool m_indexed = false;
+};
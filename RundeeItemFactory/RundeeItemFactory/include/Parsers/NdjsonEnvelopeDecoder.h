@@ -0,0 +1,127 @@
+/**
+ * @file NdjsonEnvelopeDecoder.h
+ * @brief Incremental decoder for Ollama's newline-delimited JSON response envelopes
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Ollama answers with one JSON object per line, each carrying a chunk of the
+ * generated text in a string field ("response"); the last line ("done": true)
+ * also carries timings and the conversation context. The decoder takes the
+ * HTTP body in arbitrary chunks, as it arrives, and in a single pass:
+ * - unescapes the text field straight into one output buffer, copying plain
+ *   runs found with JsonStringCodec::FindQuoteOrBackslash and decoding every
+ *   JSON escape, \\uXXXX and surrogate pairs included (escapes may be split
+ *   across chunks);
+ * - keeps the rest of each line (with the text field emptied) so the final
+ *   line's statistics can be parsed afterwards.
+ * A body that does not start with '{' is passed through unchanged.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class NdjsonEnvelopeDecoder
+ * @brief Single-pass, chunk-at-a-time extractor of one string field per NDJSON line
+ */
+class NdjsonEnvelopeDecoder
+{
+public:
+    /**
+     * @brief Create a decoder for one response body
+     * @param fieldName Top-level string field whose values are concatenated
+     */
+    explicit NdjsonEnvelopeDecoder(const std::string& fieldName = "response");
+
+    /**
+     * @brief Pre-size the output (decoded text is never longer than the body)
+     * @param bodyBytes Expected body size
+     */
+    void Reserve(size_t bodyBytes);
+
+    /**
+     * @brief Decode the next chunk of the body
+     * @param data Chunk bytes
+     * @param size Chunk size
+     */
+    void Feed(const char* data, size_t size);
+
+    /**
+     * @brief Flush state after the last chunk (an unterminated last line still counts)
+     */
+    void Finish();
+
+    /**
+     * @brief Whether the body looked like a JSON envelope (false = passed through)
+     */
+    bool IsEnvelope() const { return m_mode == Mode::Envelope; }
+
+    /**
+     * @brief Decoded text so far
+     */
+    const std::string& GetText() const { return m_text; }
+
+    /**
+     * @brief Move the decoded text out of the decoder
+     */
+    std::string TakeText() { return std::move(m_text); }
+
+    /**
+     * @brief Last non-empty line with the text field's value emptied (e.g. the "done" line)
+     */
+    const std::string& GetLastEnvelope() const { return m_lastEnvelope; }
+
+    /**
+     * @brief Total bytes passed to Feed()
+     */
+    size_t GetBytesFed() const { return m_bytesFed; }
+
+    /**
+     * @brief Escapes that were malformed or left a lone surrogate (replaced or kept verbatim)
+     */
+    int GetInvalidEscapes() const { return m_invalidEscapes; }
+
+private:
+    enum class Mode
+    {
+        Detect,       ///< Skipping leading whitespace
+        Envelope,     ///< Decoding JSON lines
+        Passthrough   ///< Not JSON; copy the body as-is
+    };
+
+    enum class State
+    {
+        Structure,    ///< Outside any string
+        KeyString,    ///< Inside a top-level key
+        TargetString, ///< Inside the value of the text field
+        OtherString   ///< Inside any other string
+    };
+
+    void FeedEnvelope(const char* data, size_t size);
+    size_t ConsumeStructure(const char* data, size_t size);
+    size_t ConsumeSkippedString(const char* data, size_t size, bool isKey);
+    size_t ConsumeTargetString(const char* data, size_t size);
+    void ConsumeEscapeByte(char c);
+    void FlushPendingHighSurrogate();
+    void EndLine();
+
+    std::string m_fieldName;
+    std::string m_text;
+    std::string m_lineEnvelope;
+    std::string m_lastEnvelope;
+    std::string m_key;
+    std::string m_escape;            ///< Partial escape sequence of the text field ("\\u00")
+    Mode m_mode = Mode::Detect;
+    State m_state = State::Structure;
+    int m_depth = 0;
+    bool m_expectKey = false;
+    bool m_valueIsTarget = false;
+    bool m_skipEscaped = false;      ///< Next byte of a skipped string is escaped
+    uint32_t m_pendingHigh = 0;      ///< High surrogate waiting for its low half
+    size_t m_bytesFed = 0;
+    int m_invalidEscapes = 0;
+};
@@ -0,0 +1,75 @@
+/**
+ * @file ProfileConstraints.h
+ * @brief A profile's relationship and custom constraints, compiled for the validator
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * A relationship constraint {"operator": ">=", "targetField": "thirstRestore"}
+ * on field hungerRestore compiles to "hungerRestore >= (thirstRestore)"; the
+ * target may itself be an expression ("maxDurability * 0.5"). A field's
+ * customConstraint is compiled as a ConstraintExpression in which "value" is
+ * the field ("value % 5 == 0"). Custom constraints that are not expressions
+ * (free-form guidance) stay prompt-only and are reported once when the
+ * profile is compiled.
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include "Parsers/ConstraintExpression.h"
+#include <json.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class ProfileConstraints
+ * @brief Compiled cross-field constraints of one profile
+ */
+class ProfileConstraints
+{
+public:
+    /**
+     * @brief Compile the constraints of every field of a profile
+     * @param profile Profile to compile
+     */
+    explicit ProfileConstraints(const ItemProfile& profile);
+
+    /**
+     * @brief Check an item against every compiled constraint
+     * @param item Item object
+     * @param errors Receives one message per violated constraint
+     * @param outInvalidFields Receives the owning field of each violated constraint (if not listed yet)
+     * @return Number of violated constraints
+     */
+    int Check(const nlohmann::json& item,
+              std::vector<std::string>& errors,
+              std::vector<std::string>* outInvalidFields = nullptr) const;
+
+    /**
+     * @brief Number of compiled constraints
+     */
+    size_t GetCount() const { return m_constraints.size(); }
+
+    /**
+     * @brief Constraints of a profile, compiled once and cached by profile ID
+     * @param profile Profile whose constraints are used
+     * @return Compiled constraints (recompiled when the profile's constraints change)
+     */
+    static std::shared_ptr<const ProfileConstraints> ForProfile(const ItemProfile& profile);
+
+private:
+    /**
+     * @struct Constraint
+     * @brief One compiled constraint and the field it belongs to
+     */
+    struct Constraint
+    {
+        std::string fieldName;
+        std::string description;
+        ConstraintExpression expression;
+    };
+
+    std::vector<Constraint> m_constraints;
+};
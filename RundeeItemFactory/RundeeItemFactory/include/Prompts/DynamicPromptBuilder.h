@@ -14,6 +14,8 @@
 #include "Data/ItemProfile.h"
 #include "Data/PlayerProfile.h"
 #include "Helpers/ItemGenerateParams.h"
+#include "Parsers/DynamicItemJsonParser.h"
+#include <map>
 #include <string>
 #include <set>
 
@@ -44,4 +46,39 @@ public:
         const std::string& modelName,
         const std::string& generationTimestamp,
         int existingCount);
+
+    /**
+     * @brief Build a short follow-up prompt that continues an earlier request
+     * @param profile Item profile being generated
+     * @param count Number of additional items to ask for
+     * @param rejectedIds IDs from the previous answer that were rejected as duplicates
+     * @return Follow-up prompt ("N more, different from the above")
+     * @note Only meaningful when sent with the conversation context returned for
+     *       the full prompt (see OllamaClient::RunWithRetry); the field rules and
+     *       world context are not repeated
+     */
+    static std::string BuildContinuationPrompt(
+        const ItemProfile& profile,
+        int count,
+        const std::set<std::string>& rejectedIds);
+
+    /**
+     * @brief Build the per-value count instructions appended to a batch prompt
+     * @param plan Field name -> value -> number of items wanted in this batch (see QuotaScheduler)
+     * @return Instruction lines, or an empty string when there is no plan
+     */
+    static std::string BuildQuotaDirective(
+        const std::map<std::string, std::map<std::string, int>>& plan);
+
+    /**
+     * @brief Build a compact prompt asking the model to fix items that failed validation
+     * @param profile Item profile the items belong to
+     * @param rejected Failed objects with their validation errors
+     * @return Prompt carrying only the failed objects, their errors and the rules of the fields involved
+     * @note Sent without conversation context; a fraction of the size of a full batch prompt,
+     *       and the content of the items is kept instead of being regenerated
+     */
+    static std::string BuildRepairPrompt(
+        const ItemProfile& profile,
+        const std::vector<RejectedItem>& rejected);
 };
@@ -0,0 +1,34 @@
+/**
+ * @file BalanceReport.h
+ * @brief Balance analytics over an existing item catalog (--report mode)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Maps an item JSON file, splits it into items with a structural scan and
+ * parses the items on all cores (CatalogSlices). Per-field statistics are computed
+ * against the item profile (numeric ranges, allowed values) and the player
+ * profile's PlayerSettings maxima. The LLM is not used.
+ *
+ * The report is printed and also written next to the catalog as
+ * "<name>.report.json".
+ */
+
+#pragma once
+
+#include "Helpers/CommandLineParser.h"
+
+/**
+ * @class BalanceReport
+ * @brief Static entry point for report mode
+ */
+class BalanceReport
+{
+public:
+    /**
+     * @brief Analyze the catalog at args.reportPath
+     * @param args Arguments (reportPath, profileId or itemType, playerProfileId)
+     * @return Exit code (0 = report produced)
+     */
+    static int Run(const CommandLineArgs& args);
+};
@@ -0,0 +1,76 @@
+/**
+ * @file CatalogSlices.h
+ * @brief Shared catalog pass of the offline reports (--report, --validate)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Loads the item profile a report checks against, maps the catalog with
+ * LazyCatalogReader and hands one contiguous slice of its items to each
+ * thread. Pages are released behind every thread, so resident memory stays
+ * flat on catalogs of any size; only the element index (16 bytes per item)
+ * is kept on the heap.
+ */
+
+#pragma once
+
+#include "Data/ItemProfile.h"
+#include "Helpers/CommandLineParser.h"
+#include "Parsers/LazyCatalogReader.h"
+#include <functional>
+#include <string>
+
+/**
+ * @class CatalogSlices
+ * @brief One catalog split into per-thread slices of items
+ */
+class CatalogSlices
+{
+public:
+    /** @brief Item IDs a report keeps per field as examples */
+    static constexpr size_t kMaxSampleIds = 5;
+
+    /**
+     * @brief Resolve a catalog path: as given, else under ItemJson/ like --out
+     */
+    static std::string ResolveCatalogPath(const std::string& path);
+
+    /**
+     * @brief Load the item profile of a report (args.profileId, else default_<itemType>)
+     * @param args Report arguments
+     * @param logTag Prefix of error messages (e.g. "[BalanceReport]")
+     * @param outProfile Loaded profile
+     * @param outPlayerProfilesDir Player profiles directory next to the item profiles
+     * @return False (after printing why) if the profile cannot be loaded
+     */
+    static bool LoadItemProfile(const CommandLineArgs& args, const std::string& logTag,
+                                ItemProfile& outProfile, std::string& outPlayerProfilesDir);
+
+    /**
+     * @brief Map a catalog and split it into slices
+     * @param catalogPath Resolved catalog path
+     * @param logTag Prefix of error messages
+     * @return False (after printing why) if the file is missing or not a JSON array
+     */
+    bool Open(const std::string& catalogPath, const std::string& logTag);
+
+    /**
+     * @brief Number of elements in the catalog
+     */
+    size_t GetItemCount() { return m_reader.GetCount(); }
+
+    /**
+     * @brief Number of slices (= threads) ForEachItem uses
+     */
+    size_t GetSliceCount() const { return m_sliceCount; }
+
+    /**
+     * @brief Visit every element, slice s on thread s, in file order within a slice
+     * @param onItem Receives (slice, element index, text, length); called concurrently for different slices
+     */
+    void ForEachItem(const std::function<void(size_t, size_t, const char*, size_t)>& onItem);
+
+private:
+    LazyCatalogReader m_reader;
+    size_t m_sliceCount = 1;
+};
@@ -0,0 +1,34 @@
+/**
+ * @file CatalogValidator.h
+ * @brief Bulk re-validation of an existing item catalog (--validate mode)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Runs every item of a catalog through the same validator generation uses:
+ * field types, ranges and allowed values, plus the profile's relationship
+ * and custom constraints. The catalog is mapped, split with a structural
+ * scan and checked on all cores (CatalogSlices). The LLM is not used.
+ *
+ * Failures are counted per field with example item IDs, printed, and
+ * written next to the catalog as "<name>.validation.json".
+ */
+
+#pragma once
+
+#include "Helpers/CommandLineParser.h"
+
+/**
+ * @class CatalogValidator
+ * @brief Static entry point for validate mode
+ */
+class CatalogValidator
+{
+public:
+    /**
+     * @brief Validate the catalog at args.validatePath
+     * @param args Arguments (validatePath, profileId or itemType)
+     * @return Exit code (0 = every item valid, 1 = invalid items or an error)
+     */
+    static int Run(const CommandLineArgs& args);
+};
@@ -0,0 +1,45 @@
+/**
+ * @file JobServer.h
+ * @brief Long-running local job server (--serve mode)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Accepts generation jobs over a minimal HTTP/1.1 API bound to the loopback
+ * interface and streams progress back as newline-delimited JSON. Config,
+ * profiles and known IDs stay warm in memory between jobs (GenerationCache).
+ *
+ * Every request must send the per-run token printed at startup in an
+ * X-Rundee-Token header. Requests carrying an Origin header are rejected, and
+ * POST /jobs requires Content-Type: application/json, so browser pages cannot
+ * drive the API with simple cross-origin requests.
+ *
+ * Each connection is served on its own thread, up to a fixed limit; further
+ * connections get 503 until one finishes.
+ *
+ * Endpoints:
+ * - GET  /health   -> {"status":"ok","activeJobs":N}
+ * - POST /jobs     -> body is a job object (see CommandLineParser::ParseJobJson);
+ *                     response is a stream of progress lines ending with a
+ *                     {"event":"result","exitCode":N} line
+ * - POST /shutdown -> stops accepting jobs and exits once running jobs finish
+ */
+
+#pragma once
+
+#include "Helpers/CommandLineParser.h"
+
+/**
+ * @class JobServer
+ * @brief Static entry point for serve mode
+ */
+class JobServer
+{
+public:
+    /**
+     * @brief Run the job server until /shutdown is requested
+     * @param defaults Arguments used for job fields that are not specified
+     * @return Exit code (0 = clean shutdown)
+     */
+    static int Run(const CommandLineArgs& defaults);
+};
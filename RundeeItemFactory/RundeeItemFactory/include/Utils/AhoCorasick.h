@@ -0,0 +1,79 @@
+/**
+ * @file AhoCorasick.h
+ * @brief Multi-pattern, case-insensitive substring matcher
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ * 
+ * Compiles a list of terms into an Aho-Corasick automaton so a text can be
+ * checked against all of them in one pass, in time linear in the text size
+ * (plus the number of matches) no matter how many terms there are.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @class AhoCorasickMatcher
+ * @brief Compiled automaton over a fixed set of terms (ASCII case-insensitive)
+ * 
+ * Transitions are stored as a dense table over byte classes: every byte that
+ * occurs in some term gets its own class, all other bytes share class 0. This
+ * keeps the table small for large term lists while each input byte costs a
+ * single table lookup.
+ */
+class AhoCorasickMatcher
+{
+public:
+    /**
+     * @brief Compile the automaton
+     * @param terms Terms to match (empty terms are ignored; duplicates are kept once)
+     */
+    void Build(const std::vector<std::string>& terms);
+
+    /**
+     * @brief Check whether any terms were compiled
+     * @return True if the matcher has no terms
+     */
+    bool Empty() const { return m_terms.empty(); }
+
+    /**
+     * @brief Get the compiled terms (lowercased, index = term id used by Scan)
+     * @return Compiled terms
+     */
+    const std::vector<std::string>& GetTerms() const { return m_terms; }
+
+    /**
+     * @brief Report every occurrence of every term in a text
+     * @param text Text to scan
+     * @param onMatch Called with (term id, end offset one past the match) for each occurrence
+     */
+    void Scan(const std::string& text, const std::function<void(int, size_t)>& onMatch) const;
+
+    /**
+     * @brief Check whether a text contains any term
+     * @param text Text to scan
+     * @return True on the first match
+     */
+    bool ContainsAny(const std::string& text) const;
+
+private:
+    /** @brief Byte -> byte class (0 = byte not used by any term) */
+    uint8_t m_byteClass[256] = {};
+    int m_classCount = 1;
+
+    /** @brief Dense transitions: m_next[state * m_classCount + class] */
+    std::vector<int32_t> m_next;
+
+    /** @brief Term ending exactly at each state (-1 if none) */
+    std::vector<int32_t> m_termAt;
+
+    /** @brief Nearest proper suffix state that ends a term (-1 if none) */
+    std::vector<int32_t> m_outputLink;
+
+    std::vector<std::string> m_terms;
+};
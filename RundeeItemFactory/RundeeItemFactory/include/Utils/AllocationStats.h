@@ -0,0 +1,62 @@
+/**
+ * @file AllocationStats.h
+ * @brief Process-wide heap allocation counters
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * In builds that define RUNDEE_ALLOC_STATS (the Bench configuration),
+ * AllocationStats.cpp replaces the global operator new/delete with versions
+ * that count calls and bytes (relaxed atomics, no locks) before forwarding to
+ * malloc/free. Benchmarks and metrics take a snapshot before and after a
+ * piece of work and report the difference. Other builds keep the library
+ * allocator and every snapshot reads zero; check kEnabled before reporting.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @namespace AllocationStats
+ * @brief Heap allocation counters
+ */
+namespace AllocationStats
+{
+    /** @brief Whether this build counts allocations */
+#ifdef RUNDEE_ALLOC_STATS
+    constexpr bool kEnabled = true;
+#else
+    constexpr bool kEnabled = false;
+#endif
+
+    /**
+     * @struct Snapshot
+     * @brief Counter values at one point in time
+     */
+    struct Snapshot
+    {
+        uint64_t allocations = 0;     ///< operator new calls since process start
+        uint64_t allocatedBytes = 0;  ///< Bytes requested by those calls
+        uint64_t liveBytes = 0;       ///< Bytes currently allocated
+        uint64_t peakLiveBytes = 0;   ///< Highest liveBytes since start or the last ResetPeak()
+    };
+
+    /**
+     * @brief Read the current counters
+     */
+    Snapshot Get();
+
+    /**
+     * @brief Read the counters of the calling thread only
+     *
+     * Only allocations and allocatedBytes are filled in; use this to measure
+     * work on one job thread while other jobs run concurrently.
+     */
+    Snapshot GetThread();
+
+    /**
+     * @brief Restart peak tracking from the current live byte count
+     */
+    void ResetPeak();
+}
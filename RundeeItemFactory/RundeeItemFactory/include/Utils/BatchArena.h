@@ -0,0 +1,158 @@
+/**
+ * @file BatchArena.h
+ * @brief Per-batch bump allocator and the arena-backed JSON value type
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Parsing one LLM response builds a DOM of a few hundred small strings, map
+ * nodes and vectors that all die together when the batch is done. A
+ * BatchArena hands that memory out of a few large blocks and frees it in one
+ * go. ArenaAllocator draws from the arena installed on the current thread
+ * by BatchArena::Scope (and falls back to the heap when none is), so
+ * ArenaJson is a drop-in nlohmann::basic_json for short-lived documents.
+ *
+ * An ArenaJson value must be destroyed before the Scope that created it
+ * ends; anything that has to outlive the batch is converted to
+ * nlohmann::json first.
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * @class BatchArena
+ * @brief Growing bump allocator; memory is released only when the arena is destroyed
+ */
+class BatchArena
+{
+public:
+    /**
+     * @class Scope
+     * @brief RAII guard that makes an arena the current one for this thread
+     *
+     * Scopes nest; the previous arena is restored when the guard ends.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(BatchArena& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        BatchArena* m_previous;
+    };
+
+    /**
+     * @brief Create an empty arena
+     * @param firstBlockSize Size of the first block; later blocks double up to 1 MB
+     */
+    explicit BatchArena(size_t firstBlockSize = 16 * 1024);
+    ~BatchArena();
+
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    /**
+     * @brief Allocate memory from the arena
+     * @param size Bytes requested
+     * @param alignment Power-of-two alignment
+     * @return Pointer valid until the arena is destroyed (never null; throws std::bad_alloc)
+     */
+    void* Allocate(size_t size, size_t alignment);
+
+    /**
+     * @brief Whether a pointer lies inside one of this arena's blocks
+     */
+    bool Owns(const void* ptr) const;
+
+    /**
+     * @brief Number of blocks taken from the heap so far
+     */
+    size_t GetBlockCount() const { return m_blocks.size(); }
+
+    /**
+     * @brief Bytes handed out by Allocate() so far
+     */
+    size_t GetUsedBytes() const { return m_usedBytes; }
+
+    /**
+     * @brief Arena installed on the calling thread (nullptr if none)
+     */
+    static BatchArena* Current();
+
+private:
+    struct Block
+    {
+        char* data = nullptr;
+        size_t size = 0;
+    };
+
+    /** @brief First offset at or after @p offset that is aligned in memory */
+    static size_t AlignedOffset(const Block& block, size_t offset, size_t alignment);
+
+    std::vector<Block> m_blocks;
+    size_t m_offset = 0;       ///< Bytes used in the last block
+    size_t m_nextBlockSize;
+    size_t m_usedBytes = 0;
+};
+
+/**
+ * @class ArenaAllocator
+ * @brief Stateless allocator that draws from BatchArena::Current()
+ *
+ * Allocations made while no arena is installed come from the heap, and
+ * deallocating memory that the current arena does not own returns it to the
+ * heap, so containers that straddle a Scope boundary stay correct.
+ */
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        if (BatchArena* arena = BatchArena::Current())
+            return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept
+    {
+        BatchArena* arena = BatchArena::Current();
+        if (arena && arena->Owns(ptr))
+            return; // Released with the arena
+        ::operator delete(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>&) const noexcept { return false; }
+};
+
+/** @brief String type whose buffer lives in the current arena */
+using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+/** @brief JSON value whose strings, objects and arrays live in the current arena */
+using ArenaJson = nlohmann::basic_json<std::map, std::vector, ArenaString, bool,
+                                       std::int64_t, std::uint64_t, double, ArenaAllocator>;
@@ -0,0 +1,118 @@
+/**
+ * @file FileUtils.h
+ * @brief Durable file write helpers
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ * 
+ * Small helpers for files that must survive a crash (checkpoints, run
+ * manifests): data is flushed to the OS and synced to disk before the
+ * call returns.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+
+/**
+ * @namespace FileUtils
+ * @brief Namespace for durable file I/O helpers
+ */
+namespace FileUtils
+{
+    /**
+     * @brief Create the parent directories of a file path
+     * @param filePath File path
+     * @return True if the parent directory exists afterwards
+     */
+    bool EnsureParentDirectories(const std::string& filePath);
+
+    /**
+     * @brief Append text to a file and sync it to disk
+     * @param filePath File to append to (created if missing)
+     * @param text Text to append
+     * @return True if the text was written and synced
+     */
+    bool AppendDurable(const std::string& filePath, const std::string& text);
+
+    /**
+     * @brief Replace a file's contents atomically and durably
+     * 
+     * Writes to "<filePath>.tmp", syncs it, then renames it over the target,
+     * so readers see either the old or the new contents, never a partial file.
+     * 
+     * @param filePath File to replace
+     * @param text New contents
+     * @return True if the file was replaced
+     */
+    bool WriteFileAtomic(const std::string& filePath, const std::string& text);
+
+    /**
+     * @class AtomicFileWriter
+     * @brief Streaming form of WriteFileAtomic for outputs too large to build in memory
+     * 
+     * Data goes to "<filePath>.tmp"; Commit() syncs it and renames it over the
+     * target. If Commit() is never reached the temporary file is removed and
+     * the target is left untouched.
+     */
+    class AtomicFileWriter
+    {
+    public:
+        AtomicFileWriter() = default;
+        ~AtomicFileWriter();
+
+        AtomicFileWriter(const AtomicFileWriter&) = delete;
+        AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+        /**
+         * @brief Create the temporary file
+         * @param filePath File that Commit() will replace
+         * @return True if the temporary file was opened
+         */
+        bool Open(const std::string& filePath);
+
+        /**
+         * @brief Append bytes to the temporary file
+         * @return False after any write error (later writes are ignored)
+         */
+        bool Write(const char* data, size_t size);
+
+        /** @brief Append a string to the temporary file */
+        bool Write(const std::string& text) { return Write(text.data(), text.size()); }
+
+        /**
+         * @brief Sync and close the temporary file without replacing the target yet
+         * 
+         * Lets a caller finish several files before renaming any of them.
+         * @return True if the temporary file is complete on disk
+         */
+        bool Prepare();
+
+        /**
+         * @brief Sync the temporary file (unless prepared) and rename it over the target
+         * @return True if the target was replaced
+         */
+        bool Commit();
+
+        /**
+         * @brief Close and delete the temporary file without touching the target
+         */
+        void Abort();
+
+    private:
+        std::FILE* m_file = nullptr;
+        std::string m_filePath;
+        std::string m_tempPath;
+        bool m_ok = false;
+        bool m_prepared = false;
+    };
+
+    /**
+     * @brief Read a whole file into a string
+     * @param filePath File to read
+     * @param outText File contents
+     * @return True if the file was read
+     */
+    bool ReadFile(const std::string& filePath, std::string& outText);
+}
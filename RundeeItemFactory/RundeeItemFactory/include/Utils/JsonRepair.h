@@ -0,0 +1,81 @@
+/**
+ * @file JsonRepair.h
+ * @brief Single-pass repair of the JSON text returned by the LLM
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Models wrap the item array in prose, leave trailing or missing commas,
+ * stop mid-item when they run out of tokens, and occasionally garble a key
+ * quote. RepairJsonText() fixes all of that in one forward pass: a small
+ * lexer tracks strings and a bounded stack of open containers, and every
+ * fix is decided at the byte where it is needed, so the work is linear in
+ * the input and the only allocation is the output buffer.
+ *
+ * Fixes:
+ * - prose before the root and after the root container closes is dropped;
+ *   the root is the first '[' followed by '{' or ']' (so "[2]" in prose is
+ *   skipped), else the first '[', else the first '{'
+ * - trailing commas before '}' or ']' and repeated commas are removed
+ * - missing commas between values and missing colons after keys are inserted
+ * - a key whose opening quote came out as ')' ()rarity": ...) is requoted
+ * - spaces inside "id" values become underscores ("fresh_ juice" -> "fresh__juice")
+ * - raw control characters inside strings are escaped
+ * - a line that is only "..." ends the text (the model elided the rest)
+ * - at the end, an unfinished element of the root array is dropped and all
+ *   open containers are closed
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @namespace JsonRepair
+ * @brief Lexer-driven JSON repair for LLM responses
+ */
+namespace JsonRepair
+{
+    /**
+     * @struct RepairReport
+     * @brief What a repair pass changed
+     */
+    struct RepairReport
+    {
+        size_t skippedLeadingBytes = 0;    ///< Prose before the root container
+        size_t skippedTrailingBytes = 0;   ///< Text after the root container closed
+        int removedCommas = 0;             ///< Trailing or repeated commas dropped
+        int insertedCommas = 0;            ///< Commas added between adjacent values
+        int insertedColons = 0;            ///< Colons added after keys
+        int requotedKeys = 0;              ///< )key" patterns turned into "key"
+        int fixedIds = 0;                  ///< "id" values whose spaces were replaced
+        int escapedControlChars = 0;       ///< Raw control characters escaped inside strings
+        int closedContainers = 0;          ///< Brackets/braces appended or inserted
+        int droppedPartialElements = 0;    ///< Unfinished root-array elements cut off
+        bool truncatedAtEllipsis = false;  ///< A "..." line ended the text
+
+        /**
+         * @brief Whether the pass changed anything besides trimming whitespace
+         */
+        bool Changed() const;
+
+        /**
+         * @brief One-line summary of the non-zero counters (empty if nothing changed)
+         */
+        std::string Summary() const;
+    };
+
+    /**
+     * @brief Maximum container nesting the lexer tracks; deeper input is cut off there
+     */
+    const int kMaxDepth = 64;
+
+    /**
+     * @brief Repair LLM JSON output in one pass
+     * @param input Raw response text
+     * @param outReport Optional output describing the fixes
+     * @return Repaired JSON text (the trimmed input if it contains no '[' or '{')
+     */
+    std::string RepairJsonText(const std::string& input, RepairReport* outReport = nullptr);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file JsonStringCodec.h
+ * @brief Vectorized scanning helpers for JSON string bodies
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * The hot loops over LLM text look for the few bytes that end a run of
+ * plain string content. With SSE2 (every x64 build, and x86 builds with
+ * /arch:SSE2, the MSVC default) 16 bytes are classified per step; other
+ * targets use the scalar loop. Both paths return the same offsets.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @namespace JsonStringCodec
+ * @brief JSON string scanning and code point helpers
+ */
+namespace JsonStringCodec
+{
+    /**
+     * @brief Find the first '"' or '\\'
+     * @param data Bytes to scan
+     * @param size Number of bytes
+     * @return Offset of the first match, or size if there is none
+     */
+    size_t FindQuoteOrBackslash(const char* data, size_t size);
+
+    /**
+     * @brief Find the first byte that must be escaped inside a JSON string ('"', '\\' or below 0x20)
+     * @param data Bytes to scan
+     * @param size Number of bytes
+     * @return Offset of the first match, or size if there is none
+     */
+    size_t FindEscapeNeeded(const char* data, size_t size);
+
+    /**
+     * @brief Longest escape sequence written by EscapeChar()
+     */
+    const size_t kMaxEscapeLength = 6;
+
+    /**
+     * @brief Write the escape sequence for a byte that FindEscapeNeeded() stopped at
+     *
+     * Uses the short forms (\", \\, \b, \f, \n, \r, \t) and \u00XX for other
+     * control characters, the same output as nlohmann::json::dump().
+     *
+     * @param c Byte to escape
+     * @param out Destination with room for kMaxEscapeLength bytes
+     * @return Number of bytes written
+     */
+    size_t EscapeChar(unsigned char c, char* out);
+
+    /**
+     * @brief Length of a byte range once escaped for a JSON string
+     * @param data Bytes to measure
+     * @param size Number of bytes
+     * @return Escaped length (quotes not included)
+     */
+    size_t EscapedLength(const char* data, size_t size);
+
+    /**
+     * @brief Append a byte range escaped for a JSON string (quotes not included)
+     * @param out Destination
+     * @param data Bytes to escape
+     * @param size Number of bytes
+     */
+    void AppendEscaped(std::string& out, const char* data, size_t size);
+
+    /**
+     * @brief Parse four hex digits of a \\uXXXX escape
+     * @param digits Pointer to the four digits
+     * @param outValue Parsed value
+     * @return False if any digit is not hexadecimal
+     */
+    bool ParseHex4(const char* digits, uint32_t& outValue);
+
+    /**
+     * @brief Append the UTF-8 encoding of a Unicode code point
+     * @param out Destination
+     * @param codePoint Code point (U+0000..U+10FFFF; surrogates are encoded as U+FFFD)
+     */
+    void AppendUtf8(std::string& out, uint32_t codePoint);
+}
@@ -11,7 +11,10 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 #include "json.hpp"
 
 using nlohmann::json;
@@ -76,4 +79,46 @@ namespace JsonUtils
      * @return Clamped value (guaranteed to be between minV and maxV)
      */
     int ClampInt(int v, int minV, int maxV);
+
+    /**
+     * @brief Locate the elements of a top-level JSON array without parsing them
+     * 
+     * Performs a structural scan (brackets, strings, escapes only) and records
+     * the byte range of every element, so elements can be parsed independently
+     * (e.g. on several threads).
+     * 
+     * @param data Text of a JSON document whose root is an array
+     * @param size Length of data in bytes
+     * @param outSpans Receives [begin, end) offsets of each element
+     * @return False if the root is not an array or the text ends inside it
+     */
+    bool SplitTopLevelArray(const char* data, size_t size, std::vector<std::pair<size_t, size_t>>& outSpans);
+
+    /**
+     * @brief Streaming form of SplitTopLevelArray
+     * 
+     * Calls onElement with the [begin, end) offsets of each element as the
+     * scan reaches it, so no span list is kept in memory.
+     * 
+     * @param data Text of a JSON document whose root is an array
+     * @param size Length of data in bytes
+     * @param onElement Called per element; return false to stop early
+     * @return False if the root is not an array or the text ends inside it
+     */
+    bool ScanTopLevelArray(const char* data, size_t size, const std::function<bool(size_t, size_t)>& onElement);
+
+    /**
+     * @brief Read a string member of a JSON object without parsing the object
+     * 
+     * Scans only the object's own keys (nested values are skipped) and decodes
+     * the value of the first member named key. Used to pull IDs out of raw
+     * catalog elements.
+     * 
+     * @param data Text of one JSON object
+     * @param size Length of data in bytes
+     * @param key Member name (compared byte-wise, unescaped)
+     * @param outValue Decoded string value
+     * @return False if the text is not an object, the key is absent or its value is not a string
+     */
+    bool FindTopLevelString(const char* data, size_t size, const char* key, std::string& outValue);
 }
@@ -0,0 +1,87 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory-mapped view of a file
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * Maps a whole file into the address space (MapViewOfFile on Windows, mmap
+ * elsewhere) so large catalogs can be scanned without copying them into a
+ * heap buffer. Pages are loaded by the OS on first touch and are clean, so
+ * they can be dropped again at any time (see Release()).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief Owner of one read-only file mapping
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map a file read-only
+     * @param path File path
+     * @return False if the file cannot be opened or mapped (an empty file maps to Size() == 0)
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Unmap the view and close the file handle
+     *
+     * Must be called before the file is replaced or renamed over on Windows.
+     */
+    void Close();
+
+    /**
+     * @brief Whether a file is mapped
+     */
+    bool IsOpen() const { return m_open; }
+
+    /**
+     * @brief First byte of the mapping (nullptr for an empty file)
+     */
+    const char* Data() const { return m_data; }
+
+    /**
+     * @brief Size of the mapping in bytes
+     */
+    size_t Size() const { return m_size; }
+
+    /**
+     * @brief Hint that the file will be read front to back
+     */
+    void AdviseSequential();
+
+    /**
+     * @brief Drop the resident pages of a range that has already been read
+     *
+     * Keeps resident memory flat while streaming over a file larger than RAM
+     * budget; the pages are read back from disk if touched again.
+     *
+     * @param offset Start of the range (rounded inwards to page boundaries)
+     * @param length Length of the range
+     */
+    void Release(size_t offset, size_t length);
+
+private:
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    bool m_open = false;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
@@ -32,28 +32,16 @@ namespace StringUtils
     /**
      * @brief Clean JSON array text from LLM responses
      * 
-     * Removes trailing commas and closes unclosed brackets in JSON array text.
-     * Handles common JSON formatting errors from LLM responses.
+     * Extracts the item array and repairs trailing/missing commas, unclosed
+     * brackets, truncated items and garbled keys in a single pass.
      * 
      * @param input Raw JSON text from LLM
      * @return Cleaned JSON text
      * 
-     * @note Removes trailing commas before closing brackets
-     * @note Attempts to close unclosed brackets
+     * @see JsonRepair::RepairJsonText for the full list of fixes
      */
     std::string CleanJsonArrayText(const std::string& input);
 
-    /**
-     * @brief Fix common JSON errors
-     * 
-     * Attempts to fix common JSON formatting errors like trailing commas,
-     * unclosed brackets, and malformed structures.
-     * 
-     * @param input JSON text with potential errors
-     * @return Fixed JSON text
-     */
-    std::string FixCommonJsonErrors(const std::string& input);
-
     /**
      * @brief Escape special characters for command line
      * 
@@ -0,0 +1,90 @@
+/**
+ * @file BinaryCatalogWriter.h
+ * @brief Writer for the indexed binary item catalog (.ricat)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * File layout (all integers little-endian):
+ * - Header:  "RICAT\0\0\0" magic (8 bytes), uint32 version, uint32 reserved
+ * - Records: one MessagePack-encoded item per record, in catalog order
+ * - Index:   count entries of {uint64 recordOffset, uint64 idOffset,
+ *            uint32 idLength, uint32 recordLength}, sorted by id (bytewise)
+ * - Id pool: concatenated id bytes referenced by the index
+ * - Footer:  uint64 indexOffset, uint64 poolOffset, uint64 poolSize,
+ *            uint64 count, "RIIDX\0\0\0" magic (40 bytes)
+ *
+ * A reader loads only the footer and index, binary-searches the id and
+ * decodes the one record it needs (see BinaryCatalogReader).
+ */
+
+#pragma once
+
+#include "Utils/FileUtils.h"
+#include <json.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace BinaryCatalogFormat
+ * @brief Constants shared by the binary catalog writer and reader
+ */
+namespace BinaryCatalogFormat
+{
+    const char kHeaderMagic[8] = { 'R', 'I', 'C', 'A', 'T', 0, 0, 0 };
+    const char kFooterMagic[8] = { 'R', 'I', 'I', 'D', 'X', 0, 0, 0 };
+    const uint32_t kVersion = 1;
+    const size_t kHeaderSize = 16;
+    const size_t kIndexEntrySize = 24;
+    const size_t kFooterSize = 40;
+
+    /** @brief Append a little-endian integer of N bytes */
+    template <typename T>
+    inline void PutLE(std::string& out, T value)
+    {
+        for (size_t i = 0; i < sizeof(T); ++i)
+            out.push_back(static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF));
+    }
+
+    /** @brief Read a little-endian integer of N bytes */
+    template <typename T>
+    inline T GetLE(const char* data)
+    {
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i)
+            value |= static_cast<uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        return static_cast<T>(value);
+    }
+}
+
+/**
+ * @class BinaryCatalogWriter
+ * @brief Static class for writing items to an indexed binary catalog
+ */
+class BinaryCatalogWriter
+{
+public:
+    /**
+     * @brief Binary catalog path for a JSON output path (items_food.json -> items_food.ricat)
+     * @param jsonPath JSON output path
+     * @return Path with the .ricat extension
+     */
+    static std::string GetBinaryPath(const std::string& jsonPath);
+
+    /**
+     * @brief Write items to a binary catalog
+     * @param items Batch of items to write (objects with a string "id"; consumed)
+     * @param path Output .ricat path
+     * @param mergeWithExisting If true, keep the records already in the file (skip duplicate IDs);
+     *                          existing records are copied without being decoded
+     * @param staged If given, the new file is written through it and only prepared;
+     *               the caller commits it (e.g. together with the JSON catalog)
+     * @return true on success, false on failure
+     */
+    static bool WriteItemsToFile(
+        std::vector<nlohmann::json>&& items,
+        const std::string& path,
+        bool mergeWithExisting = true,
+        FileUtils::AtomicFileWriter* staged = nullptr);
+};
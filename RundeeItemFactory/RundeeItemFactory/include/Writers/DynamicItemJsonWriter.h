@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "Utils/FileUtils.h"
 #include <vector>
 #include <string>
 #include <set>
@@ -24,15 +25,18 @@ class DynamicItemJsonWriter
 public:
     /**
      * @brief Write dynamic items (JSON objects) to JSON file
-     * @param items Vector of JSON objects representing items
+     * @param items Batch of JSON objects representing items (consumed; IDs are moved out)
      * @param path Output file path
      * @param mergeWithExisting If true, merge with existing items in file (skip duplicates)
+     * @param staged If given, the new file is written through it and only prepared;
+     *               the caller commits it (e.g. together with the binary catalog)
      * @return true on success, false on failure
      */
     static bool WriteItemsToFile(
-        const std::vector<nlohmann::json>& items,
+        std::vector<nlohmann::json>&& items,
         const std::string& path,
-        bool mergeWithExisting = true);
+        bool mergeWithExisting = true,
+        FileUtils::AtomicFileWriter* staged = nullptr);
     
     /**
      * @brief Get existing item IDs from JSON file
@@ -43,12 +47,12 @@ public:
     
     /**
      * @brief Merge items with existing file, skipping duplicates
-     * @param newItems New items to add
+     * @param newItems New items to add (consumed)
      * @param path File path
      * @return true on success, false on failure
      */
     static bool MergeItemsWithFile(
-        const std::vector<nlohmann::json>& newItems,
+        std::vector<nlohmann::json>&& newItems,
         const std::string& path);
 };
 
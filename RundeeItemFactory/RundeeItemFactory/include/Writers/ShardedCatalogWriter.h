@@ -0,0 +1,113 @@
+/**
+ * @file ShardedCatalogWriter.h
+ * @brief Hash-partitioned catalog output (items_x.00.json ... items_x.NN.json)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ *
+ * With --shards N an item goes to shard FNV-1a-64(id) % N instead of the
+ * single output file. Every shard has its own lock, so concurrent jobs for
+ * the same type commit to different shards in parallel, and a merge rewrites
+ * only the shards that received items (about 1/N of the catalog each).
+ *
+ * A manifest next to the shards ties them together for readers:
+ * items_x.shards.json = { "version": 1, "hash": "fnv1a64", "shardCount": N,
+ * "shards": [ "items_x.00.json", ... ] } (file names relative to the
+ * manifest). A binary catalog shard uses the same stem (items_x.00.ricat).
+ */
+
+#pragma once
+
+#include <json.hpp>
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @struct ShardManifest
+ * @brief Contents of a shard manifest
+ */
+struct ShardManifest
+{
+    int shardCount = 0;
+    std::vector<std::string> shardPaths;  ///< Shard JSON paths, resolved against the manifest directory
+};
+
+/**
+ * @class ShardedCatalogWriter
+ * @brief Static helpers for writing and locating catalog shards
+ */
+class ShardedCatalogWriter
+{
+public:
+    /** @brief Largest accepted shard count */
+    static const int kMaxShards = 256;
+
+    /**
+     * @brief Writes one shard's items (e.g. JSON and/or binary merge); the partition is handed over
+     * @return False if the shard could not be written
+     */
+    using ShardWriteFn = std::function<bool(std::vector<nlohmann::json>&& items, const std::string& shardPath)>;
+
+    /**
+     * @brief 64-bit FNV-1a hash of an item ID
+     */
+    static uint64_t HashId(const std::string& id);
+
+    /**
+     * @brief Shard an ID belongs to
+     * @param id Item ID
+     * @param shardCount Number of shards (>= 1)
+     */
+    static int GetShardIndex(const std::string& id, int shardCount);
+
+    /**
+     * @brief Path of one shard (items_x.json -> items_x.03.json)
+     * @param basePath Unsharded output path
+     * @param index Shard index
+     * @param shardCount Number of shards (sets the zero-padded width, at least 2 digits)
+     */
+    static std::string GetShardPath(const std::string& basePath, int index, int shardCount);
+
+    /**
+     * @brief Path of the shard manifest (items_x.json -> items_x.shards.json)
+     */
+    static std::string GetManifestPath(const std::string& basePath);
+
+    /**
+     * @brief Read the manifest of a sharded catalog
+     * @param basePath Unsharded output path
+     * @param outManifest Parsed manifest
+     * @return False if there is no valid manifest
+     */
+    static bool LoadManifest(const std::string& basePath, ShardManifest& outManifest);
+
+    /**
+     * @brief Shard paths to read for a catalog
+     * @param basePath Unsharded output path
+     * @param shardCount Shard count to assume when there is no manifest yet
+     * @return Paths from the manifest if present, otherwise the shardCount shard paths
+     */
+    static std::vector<std::string> GetShardPaths(const std::string& basePath, int shardCount);
+
+    /**
+     * @brief Partition items by ID hash and write each non-empty shard
+     *
+     * Shards are written in parallel; each write holds only that shard's lock.
+     * The manifest is created on first use and must agree with shardCount
+     * afterwards (changing the shard count of an existing catalog is refused).
+     *
+     * @param items Items to write (objects with a string "id"; moved into their partitions)
+     * @param basePath Unsharded output path
+     * @param shardCount Number of shards (2..kMaxShards)
+     * @param writeShard Called once per non-empty shard while its lock is held
+     * @return True if the manifest is valid and every shard was written
+     */
+    static bool WriteItems(
+        std::vector<nlohmann::json>&& items,
+        const std::string& basePath,
+        int shardCount,
+        const ShardWriteFn& writeShard);
+};
@@ -0,0 +1,149 @@
+/**
+ * @file BenchRunner.cpp
+ * @brief Implementation of bench mode
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Bench/BenchRunner.h"
+#include "Bench/ColumnarBench.h"
+#include "Bench/IdScanBench.h"
+#include "Bench/PipelineBench.h"
+#include "Bench/ReIdBench.h"
+#include "Bench/RepairBench.h"
+#include "Utils/AllocationStats.h"
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+    std::string FormatMegabytes(uint64_t bytes)
+    {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << (bytes / (1024.0 * 1024.0));
+        return oss.str();
+    }
+}
+
+int BenchRunner::Run(const CommandLineArgs& args)
+{
+    std::string catalogPath = args.benchFile.empty() ? args.params.outputPath : args.benchFile;
+    std::error_code ec;
+    if (!std::filesystem::exists(catalogPath, ec))
+        catalogPath = CommandLineParser::ResolveOutputPath(catalogPath);
+
+    if (args.benchSuite == "ids")
+        return IdScanBench::Run(catalogPath);
+    if (args.benchSuite == "pipeline")
+        return PipelineBench::Run(catalogPath, args.profileId);
+    if (args.benchSuite == "repair")
+        return RepairBench::Run(catalogPath);
+    if (args.benchSuite == "reid")
+        return ReIdBench::Run(catalogPath);
+    if (args.benchSuite == "columnar")
+        return ColumnarBench::Run(catalogPath, args.profileId);
+
+    std::cerr << "[Bench] Unknown suite: " << args.benchSuite << " (available: ids, pipeline, repair, reid, columnar)\n";
+    return 1;
+}
+
+BenchMeasurement BenchRunner::Measure(const std::string& name, size_t inputBytes, const std::function<size_t()>& body)
+{
+    BenchMeasurement result;
+    result.name = name;
+    result.inputBytes = inputBytes;
+
+    AllocationStats::ResetPeak();
+    const AllocationStats::Snapshot before = AllocationStats::Get();
+    const auto startTime = std::chrono::steady_clock::now();
+    result.items = body();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const AllocationStats::Snapshot after = AllocationStats::Get();
+
+    result.allocations = after.allocations - before.allocations;
+    result.allocatedBytes = after.allocatedBytes - before.allocatedBytes;
+    result.peakHeapBytes = after.peakLiveBytes - before.liveBytes;
+    return result;
+}
+
+void BenchRunner::PrintResults(const std::string& title, const std::vector<BenchMeasurement>& results)
+{
+    std::cout << "\n=== " << title << " ===\n";
+    std::cout << std::left << std::setw(24) << "variant"
+              << std::right << std::setw(10) << "items"
+              << std::setw(10) << "time(s)"
+              << std::setw(10) << "MB/s"
+              << std::setw(14) << "allocations"
+              << std::setw(14) << "alloc MB"
+              << std::setw(14) << "peak heap MB"
+              << std::setw(10) << "copies" << "\n";
+    for (const auto& r : results)
+    {
+        std::ostringstream seconds;
+        seconds << std::fixed << std::setprecision(3) << r.seconds;
+        std::ostringstream throughput;
+        if (r.inputBytes > 0 && r.seconds > 0.0)
+            throughput << std::fixed << std::setprecision(0) << (r.inputBytes / (1024.0 * 1024.0)) / r.seconds;
+        else
+            throughput << "-";
+
+        std::cout << std::left << std::setw(24) << r.name
+                  << std::right << std::setw(10) << r.items
+                  << std::setw(10) << seconds.str()
+                  << std::setw(10) << throughput.str();
+        if (AllocationStats::kEnabled)
+        {
+            std::cout << std::setw(14) << r.allocations
+                      << std::setw(14) << FormatMegabytes(r.allocatedBytes)
+                      << std::setw(14) << FormatMegabytes(r.peakHeapBytes);
+        }
+        else
+        {
+            std::cout << std::setw(14) << "-" << std::setw(14) << "-" << std::setw(14) << "-";
+        }
+        std::cout << std::setw(10) << r.copies << "\n";
+    }
+    if (!AllocationStats::kEnabled)
+        std::cout << "(heap columns need the Bench build configuration, which defines RUNDEE_ALLOC_STATS)\n";
+}
+
+int BenchRunner::RunComparison(const BenchComparison& comparison)
+{
+    std::vector<BenchMeasurement> results;
+    int disagreements = 0;
+    for (size_t i = 0; i < comparison.inputs.size(); ++i)
+    {
+        const BenchInput& input = comparison.inputs[i];
+        std::string referenceResult;
+        std::string candidateResult;
+        results.push_back(Measure(comparison.referenceName + "/" + input.name, input.bytes, [&]()
+        {
+            referenceResult = comparison.reference(i);
+            return size_t(0);
+        }));
+        if (comparison.countItems)
+            results.back().items = comparison.countItems(i, referenceResult);
+        results.push_back(Measure(comparison.candidateName + "/" + input.name, input.bytes, [&]()
+        {
+            candidateResult = comparison.candidate(i);
+            return size_t(0);
+        }));
+        if (comparison.countItems)
+            results.back().items = comparison.countItems(i, candidateResult);
+
+        const bool same = comparison.equivalent ? comparison.equivalent(referenceResult, candidateResult)
+                                                : referenceResult == candidateResult;
+        if (!same)
+        {
+            std::cerr << "[Bench] " << comparison.referenceName << " and " << comparison.candidateName
+                      << " disagree on the " << input.name << " input\n";
+            ++disagreements;
+        }
+    }
+    PrintResults(comparison.title, results);
+    return disagreements;
+}
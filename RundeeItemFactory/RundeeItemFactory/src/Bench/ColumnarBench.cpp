@@ -0,0 +1,215 @@
+/**
+ * @file ColumnarBench.cpp
+ * @brief Implementation of the columnar catalog round-trip and scan check
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Bench/ColumnarBench.h"
+#include "Bench/BenchRunner.h"
+#include "Data/ColumnarCatalog.h"
+#include "Generators/GenerationCache.h"
+#include "Generators/ItemGenerator.h"
+#include "Utils/FileUtils.h"
+#include <json.hpp>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    /**
+     * @struct ColumnSummary
+     * @brief Aggregates of one field over the whole catalog
+     */
+    struct ColumnSummary
+    {
+        size_t present = 0;
+        double sum = 0.0;            ///< Numbers
+        size_t trues = 0;            ///< Booleans
+        size_t bytes = 0;            ///< Strings
+        size_t elements = 0;         ///< Arrays and objects
+        std::map<std::string, size_t> valueCounts; ///< Enum columns: rows per value
+    };
+
+    /**
+     * @brief Add one JSON value the way its column would count it
+     */
+    void AddValue(const nlohmann::json& value, ColumnType type, ColumnSummary& summary)
+    {
+        ++summary.present;
+        if (value.is_number())
+            summary.sum += value.get<double>();
+        else if (value.is_boolean())
+            summary.trues += value.get<bool>() ? 1 : 0;
+        else if (value.is_string())
+        {
+            const std::string& s = value.get_ref<const std::string&>();
+            summary.bytes += s.size();
+            if (type == ColumnType::Enum)
+                ++summary.valueCounts[s];
+        }
+        else if (value.is_array() || value.is_object())
+            summary.elements += value.size();
+    }
+
+    std::string Describe(const std::vector<CatalogColumn>& columns, const std::vector<ColumnSummary>& summaries)
+    {
+        std::ostringstream text;
+        text << std::setprecision(17);
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            const ColumnSummary& s = summaries[c];
+            text << columns[c].name << ": present=" << s.present << " sum=" << s.sum << " trues=" << s.trues
+                 << " bytes=" << s.bytes << " elements=" << s.elements;
+            for (const auto& entry : s.valueCounts)
+                text << " [" << entry.first << "]=" << entry.second;
+            text << "\n";
+        }
+        return text.str();
+    }
+
+    /**
+     * @brief Summarize every column by looking each field up in the JSON items
+     */
+    std::string ScanJson(const nlohmann::json& items, const std::vector<CatalogColumn>& columns)
+    {
+        std::vector<ColumnSummary> summaries(columns.size());
+        for (const auto& item : items)
+        {
+            if (!item.is_object())
+                continue;
+            for (size_t c = 0; c < columns.size(); ++c)
+            {
+                auto it = item.find(columns[c].name);
+                if (it != item.end())
+                    AddValue(*it, columns[c].type, summaries[c]);
+            }
+        }
+        return Describe(columns, summaries);
+    }
+
+    /**
+     * @brief Summarize every column from its typed vectors
+     */
+    std::string ScanColumns(const ColumnarCatalog& catalog)
+    {
+        const std::vector<CatalogColumn>& columns = catalog.GetColumns();
+        std::vector<ColumnSummary> summaries(columns.size());
+        for (size_t c = 0; c < columns.size(); ++c)
+        {
+            const CatalogColumn& column = columns[c];
+            ColumnSummary& summary = summaries[c];
+            std::vector<size_t> codeCounts(column.dictionary.size());
+            for (size_t row = 0; row < column.states.size(); ++row)
+            {
+                const CellState state = column.states[row];
+                if (state == CellState::Missing)
+                    continue;
+                if (state == CellState::Fallback)
+                {
+                    AddValue(column.fallback.at(row), column.type, summary);
+                    continue;
+                }
+
+                ++summary.present;
+                switch (column.type)
+                {
+                case ColumnType::Int:    summary.sum += static_cast<double>(column.ints[row]); break;
+                case ColumnType::Float:  summary.sum += column.floats[row]; break;
+                case ColumnType::Bool:   summary.trues += column.bools[row]; break;
+                case ColumnType::String: summary.bytes += column.GetString(row).second; break;
+                case ColumnType::Enum:
+                    summary.bytes += column.dictionary[column.codes[row]].size();
+                    ++codeCounts[column.codes[row]];
+                    break;
+                case ColumnType::Json:
+                    if (column.values[row].is_array() || column.values[row].is_object())
+                        summary.elements += column.values[row].size();
+                    break;
+                }
+            }
+            for (size_t code = 0; code < codeCounts.size(); ++code)
+            {
+                if (codeCounts[code] > 0)
+                    summary.valueCounts[column.dictionary[code]] += codeCounts[code];
+            }
+        }
+        return Describe(columns, summaries);
+    }
+}
+
+int ColumnarBench::Run(const std::string& catalogPath, const std::string& profileId)
+{
+    if (profileId.empty())
+    {
+        std::cerr << "[Bench] The columnar suite needs --profile to define the columns\n";
+        return 1;
+    }
+    const ItemProfile profile = GenerationCache::GetItemProfile(ItemGenerator::GetExecutableDirectory() + "ItemProfiles/", profileId);
+    if (profile.id.empty())
+    {
+        std::cerr << "[Bench] Failed to load item profile: " << profileId << "\n";
+        return 1;
+    }
+
+    std::string text;
+    if (!FileUtils::ReadFile(catalogPath, text))
+    {
+        std::cerr << "[Bench] Cannot read catalog: " << catalogPath << "\n";
+        return 1;
+    }
+    nlohmann::json items = nlohmann::json::parse(text, nullptr, false);
+    if (!items.is_array())
+    {
+        std::cerr << "[Bench] Catalog is not a JSON array: " << catalogPath << "\n";
+        return 1;
+    }
+    // Non-objects are not rows, so they cannot come back
+    nlohmann::json objects = nlohmann::json::array();
+    for (auto& item : items)
+    {
+        if (item.is_object())
+            objects.push_back(std::move(item));
+    }
+    items = nlohmann::json();
+    std::cout << "[Bench] columnar: " << catalogPath << " (" << objects.size() << " items, "
+              << profile.fields.size() << " profile fields)\n";
+
+    int failures = 0;
+    std::vector<BenchMeasurement> results;
+    ColumnarCatalog catalog(profile);
+    nlohmann::json rebuilt;
+    results.push_back(BenchRunner::Measure("build", text.size(), [&]()
+    {
+        catalog = ColumnarCatalog::FromJson(profile, objects);
+        return catalog.GetRowCount();
+    }));
+    results.push_back(BenchRunner::Measure("rebuild", text.size(), [&]()
+    {
+        rebuilt = catalog.ToJson();
+        return rebuilt.size();
+    }));
+    BenchRunner::PrintResults("Columnar round-trip", results);
+    if (rebuilt != objects)
+    {
+        std::cerr << "[Bench] The rebuilt catalog differs from the original\n";
+        ++failures;
+    }
+    rebuilt = nlohmann::json();
+
+    BenchComparison comparison;
+    comparison.title = "Field scan";
+    comparison.referenceName = "json";
+    comparison.candidateName = "columns";
+    comparison.inputs = { { "catalog", text.size() } };
+    comparison.reference = [&](size_t) { return ScanJson(objects, catalog.GetColumns()); };
+    comparison.candidate = [&](size_t) { return ScanColumns(catalog); };
+    comparison.countItems = [&](size_t, const std::string&) { return catalog.GetRowCount(); };
+    failures += BenchRunner::RunComparison(comparison);
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file IdScanBench.cpp
+ * @brief Implementation of the ID enumeration benchmark
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Bench/IdScanBench.h"
+#include "Bench/BenchRunner.h"
+#include "Utils/MappedFile.h"
+#include "Writers/DynamicItemJsonWriter.h"
+#include <json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+
+namespace
+{
+    /**
+     * @class IdFilterSax
+     * @brief SAX handler that keeps only the string "id" of each top-level object
+     *
+     * Depth 1 is the root array and depth 2 an item, so only keys seen at depth
+     * 2 are candidates; all other values are dropped as soon as they are reported.
+     */
+    class IdFilterSax : public nlohmann::json_sax<nlohmann::json>
+    {
+    public:
+        explicit IdFilterSax(std::set<std::string>& ids) : m_ids(ids) {}
+
+        bool null() override { m_expectId = false; return true; }
+        bool boolean(bool) override { m_expectId = false; return true; }
+        bool number_integer(number_integer_t) override { m_expectId = false; return true; }
+        bool number_unsigned(number_unsigned_t) override { m_expectId = false; return true; }
+        bool number_float(number_float_t, const string_t&) override { m_expectId = false; return true; }
+        bool binary(binary_t&) override { m_expectId = false; return true; }
+
+        bool string(string_t& value) override
+        {
+            if (m_expectId)
+                m_ids.insert(std::move(value));
+            m_expectId = false;
+            return true;
+        }
+
+        bool key(string_t& name) override
+        {
+            m_expectId = (m_depth == 2 && name == "id");
+            return true;
+        }
+
+        bool start_object(std::size_t) override { ++m_depth; m_expectId = false; return true; }
+        bool end_object() override { --m_depth; return true; }
+        bool start_array(std::size_t) override { ++m_depth; m_expectId = false; return true; }
+        bool end_array() override { --m_depth; return true; }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override
+        {
+            return false;
+        }
+
+    private:
+        std::set<std::string>& m_ids;
+        int m_depth = 0;
+        bool m_expectId = false;
+    };
+
+    /** @brief The original GetExistingIds: full DOM, then a walk over the items */
+    void CollectIdsDom(const std::string& path, std::set<std::string>& ids)
+    {
+        std::ifstream file(path);
+        nlohmann::json root;
+        file >> root;
+        if (!root.is_array())
+            return;
+        for (const auto& item : root)
+        {
+            if (item.is_object() && item.contains("id") && item["id"].is_string())
+                ids.insert(item["id"].get<std::string>());
+        }
+    }
+}
+
+int IdScanBench::Run(const std::string& catalogPath)
+{
+    std::error_code ec;
+    const size_t fileSize = static_cast<size_t>(std::filesystem::file_size(catalogPath, ec));
+    if (ec)
+    {
+        std::cerr << "[Bench] Cannot read catalog: " << catalogPath << "\n";
+        return 1;
+    }
+    std::cout << "[Bench] ids: " << catalogPath << " (" << fileSize / (1024 * 1024) << " MB)\n";
+
+    std::vector<BenchMeasurement> results;
+    std::set<std::string> structuralIds;
+    std::set<std::string> saxIds;
+
+    results.push_back(BenchRunner::Measure("structural", fileSize, [&]()
+    {
+        structuralIds = DynamicItemJsonWriter::GetExistingIds(catalogPath);
+        return structuralIds.size();
+    }));
+
+    results.push_back(BenchRunner::Measure("sax-filter", fileSize, [&]()
+    {
+        MappedFile file;
+        if (!file.Open(catalogPath))
+            return size_t(0);
+        IdFilterSax filter(saxIds);
+        nlohmann::json::sax_parse(file.Data(), file.Data() + file.Size(), &filter);
+        return saxIds.size();
+    }));
+
+    // Last, so its DOM does not distort the page cache for the others
+    results.push_back(BenchRunner::Measure("dom", fileSize, [&]()
+    {
+        std::set<std::string> domIds;
+        try
+        {
+            CollectIdsDom(catalogPath, domIds);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[Bench] dom: " << e.what() << "\n";
+        }
+        return domIds.size();
+    }));
+
+    BenchRunner::PrintResults("ID enumeration", results);
+    std::cout << "(peak heap excludes the file mapping, which is page cache)\n";
+
+    if (saxIds != structuralIds || results[2].items != structuralIds.size())
+    {
+        std::cerr << "[Bench] Variants disagree on the ID set\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file PipelineBench.cpp
+ * @brief Implementation of the item pipeline benchmark
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Bench/PipelineBench.h"
+#include "Bench/BenchRunner.h"
+#include "Generators/GenerationCache.h"
+#include "Generators/ItemGenerator.h"
+#include "Parsers/DynamicItemJsonParser.h"
+#include "Parsers/LazyCatalogReader.h"
+#include "Writers/DynamicItemJsonWriter.h"
+#include "Utils/FileUtils.h"
+#include <json.hpp>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <sstream>
+
+namespace
+{
+    const size_t kMaxItems = 20000;
+    const size_t kItemsPerResponse = 50;
+
+    /**
+     * @brief Silences std::cout (the parser logs every response) while alive
+     */
+    class QuietStdout
+    {
+    public:
+        QuietStdout() : m_saved(std::cout.rdbuf(m_sink.rdbuf())) {}
+        ~QuietStdout() { std::cout.rdbuf(m_saved); }
+
+    private:
+        std::ostringstream m_sink;
+        std::streambuf* m_saved;
+    };
+
+    /**
+     * @brief Cut up to kMaxItems catalog elements into JSON array texts
+     */
+    std::vector<std::string> BuildResponses(const std::string& catalogPath, size_t& outBytes)
+    {
+        std::vector<std::string> responses;
+        outBytes = 0;
+        LazyCatalogReader reader;
+        if (!reader.Open(catalogPath))
+            return responses;
+
+        size_t itemCount = 0;
+        reader.ForEachItem([&](const char* text, size_t length)
+        {
+            if (itemCount % kItemsPerResponse == 0)
+                responses.push_back("[");
+            else
+                responses.back() += ",";
+            responses.back().append(text, length);
+            outBytes += length;
+            return ++itemCount < kMaxItems;
+        });
+        for (auto& response : responses)
+            response += "]";
+        return responses;
+    }
+
+    /**
+     * @brief The id/displayName fill that ItemGenerator used to run on its own copy of each item
+     *
+     * Body copied verbatim from the removed ItemGenerator loop (type prefix, 30-character suffix cap).
+     */
+    void LegacyFillIdAndDisplayName(nlohmann::json& item, const ItemProfile& itemProfile,
+                                    const std::vector<nlohmann::json>& newItems)
+    {
+        // Ensure displayName is present first (needed for ID generation)
+        if (!item.contains("displayName") || item["displayName"].is_null() ||
+            (item["displayName"].is_string() && item["displayName"].get<std::string>().empty()))
+        {
+            // Generate displayName if missing
+            item["displayName"] = itemProfile.itemTypeName + " Item " + std::to_string(newItems.size() + 1);
+        }
+        
+        // Ensure id is present and based on displayName
+        if (!item.contains("id") || item["id"].is_null() || 
+            (item["id"].is_string() && item["id"].get<std::string>().empty()))
+        {
+            // Generate id from displayName using the same logic as parser
+            std::string itemTypePrefix = itemProfile.itemTypeName;
+            std::transform(itemTypePrefix.begin(), itemTypePrefix.end(), itemTypePrefix.begin(), ::tolower);
+            itemTypePrefix.erase(std::remove_if(itemTypePrefix.begin(), itemTypePrefix.end(),
+                [](char c) { return !std::isalnum(c); }), itemTypePrefix.end());
+            
+            std::string displayName = item["displayName"].get<std::string>();
+            std::string idSuffix = DynamicItemJsonParser::GenerateShortIdFromDisplayName(displayName);
+            
+            // Limit length
+            if (idSuffix.length() > 30)
+                idSuffix = idSuffix.substr(0, 30);
+            
+            if (idSuffix.empty())
+                idSuffix = std::to_string(newItems.size() + 1);
+            
+            std::ostringstream idStream;
+            idStream << itemTypePrefix << "_" << idSuffix;
+            item["id"] = idStream.str();
+        }
+    }
+}
+
+int PipelineBench::Run(const std::string& catalogPath, const std::string& profileId)
+{
+    ItemProfile profile;
+    profile.itemTypeName = "Item";
+    if (!profileId.empty())
+    {
+        profile = GenerationCache::GetItemProfile(ItemGenerator::GetExecutableDirectory() + "ItemProfiles/", profileId);
+        if (profile.id.empty())
+        {
+            std::cerr << "[Bench] Failed to load item profile: " << profileId << "\n";
+            return 1;
+        }
+    }
+
+    size_t inputBytes = 0;
+    const std::vector<std::string> responses = BuildResponses(catalogPath, inputBytes);
+    if (responses.empty())
+    {
+        std::cerr << "[Bench] Cannot read catalog: " << catalogPath << "\n";
+        return 1;
+    }
+    std::cout << "[Bench] pipeline: " << catalogPath << " (" << responses.size() << " responses of up to "
+              << kItemsPerResponse << " items)\n";
+
+    const std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+    const std::string copyingPath = (tempDir / "rundee_bench_pipeline_copying.json").string();
+    const std::string movingPath = (tempDir / "rundee_bench_pipeline_moving.json").string();
+
+    std::vector<BenchMeasurement> results;
+    uint64_t copies = 0;
+
+    results.push_back(BenchRunner::Measure("copying", inputBytes, [&]()
+    {
+        QuietStdout quiet;
+        std::vector<nlohmann::json> newItems;
+        std::set<std::string> seenIds;
+        for (const auto& response : responses)
+        {
+            std::vector<nlohmann::json> items;
+            if (!DynamicItemJsonParser::ParseItemsFromJsonText(response, profile, items))
+                continue;
+            for (size_t i = 0; i < items.size(); ++i)
+            {
+                nlohmann::json item = items[i];
+                ++copies;
+                LegacyFillIdAndDisplayName(item, profile, newItems);
+                std::string id = item["id"].get<std::string>();
+                if (seenIds.insert(id).second)
+                {
+                    newItems.push_back(item);
+                    ++copies;
+                }
+            }
+        }
+
+        // The writer used to rebuild the whole catalog as one array before dumping it
+        nlohmann::json outputArray = nlohmann::json::array();
+        for (const auto& item : newItems)
+        {
+            outputArray.push_back(item);
+            ++copies;
+        }
+        FileUtils::WriteFileAtomic(copyingPath, outputArray.dump(2));
+        return newItems.size();
+    }));
+    results.back().copies = copies;
+
+    results.push_back(BenchRunner::Measure("move-only", inputBytes, [&]()
+    {
+        QuietStdout quiet;
+        std::vector<nlohmann::json> newItems;
+        std::set<std::string> seenIds;
+        for (const auto& response : responses)
+        {
+            std::vector<nlohmann::json> items;
+            if (!DynamicItemJsonParser::ParseItemsFromJsonText(response, profile, items))
+                continue;
+            for (auto& item : items)
+            {
+                if (seenIds.insert(item["id"].get_ref<const std::string&>()).second)
+                    newItems.push_back(std::move(item));
+            }
+        }
+        const size_t count = newItems.size();
+        DynamicItemJsonWriter::WriteItemsToFile(std::move(newItems), movingPath, false);
+        return count;
+    }));
+
+    BenchRunner::PrintResults("Item pipeline (parse -> dedup -> write)", results);
+    std::cout << "(copies = deep copies of an item after parsing; both variants share the parser's arena materialization)\n";
+
+    std::string copyingText;
+    std::string movingText;
+    const bool same = FileUtils::ReadFile(copyingPath, copyingText) && FileUtils::ReadFile(movingPath, movingText) && copyingText == movingText;
+    std::error_code ec;
+    std::filesystem::remove(copyingPath, ec);
+    std::filesystem::remove(movingPath, ec);
+    if (!same)
+    {
+        std::cerr << "[Bench] Variants wrote different catalogs\n";
+        return 1;
+    }
+    return 0;
+}
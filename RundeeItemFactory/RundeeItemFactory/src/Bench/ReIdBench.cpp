@@ -0,0 +1,259 @@
+/**
+ * @file ReIdBench.cpp
+ * @brief Implementation of the ID shortening equivalence test and benchmark
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Bench/ReIdBench.h"
+#include "Bench/BenchRunner.h"
+#include "Parsers/IdShortener.h"
+#include "Parsers/LazyCatalogReader.h"
+#include "Utils/JsonUtils.h"
+#include "Writers/ShardedCatalogWriter.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+    const int kSyntheticNames = 20000;
+    const int kPasses = 5;
+    const int kMaxReportedMismatches = 10;
+
+    /** @brief Names where removed words close up a later multi-word rule, checked on every run */
+    const std::vector<std::string> kCloseUpNames = {
+        "pump-semi-auto-action", "remington (bolt-semi-auto-action", "Lever-Full-Auto-Action",
+        "bolt-mk-action", "bolt--mk-action", "bolt- mk -action", "bolt -mk- action", "pump-v-ed-action",
+        "Semi-Mk-Auto", "semi-auto-auto", "Heckler & Koch lever-semi-auto-action", "Smith-Wesson-mk-action"
+    };
+
+    /** @brief DynamicItemJsonParser::GenerateShortIdFromDisplayName before IdShortener, unchanged */
+    std::string LegacyGenerateShortIdFromDisplayName(const std::string& displayName)
+    {
+        // Common words to remove (generic descriptors)
+        std::vector<std::string> commonWords = {
+            "enhanced", "advanced", "professional", "premium", "standard", "basic",
+            "deluxe", "ultimate", "superior", "elite", "master", "expert",
+            "semiautomatic", "automatic", "semi-auto", "full-auto",
+            "assault", "rifle", "pistol", "carbine", "shotgun", "sniper",
+            "model", "mk", "mark", "version", "ver", "v", "edition", "ed",
+            "lever-action", "bolt-action", "pump-action", "action"
+        };
+
+        // Manufacturer abbreviations
+        std::map<std::string, std::string> manufacturerAbbrevs = {
+            {"heckler", "hk"}, {"koch", ""}, {"&", ""}, {"and", ""},
+            {"colt", "colt"}, {"sig", "sig"}, {"sauer", ""},
+            {"winchester", "win"}, {"remington", "rem"},
+            {"fn", "fn"}, {"herstal", ""},
+            {"glock", "glock"}, {"beretta", "ber"}, {"smith", "sw"}, {"wesson", ""}
+        };
+
+        std::string result = displayName;
+
+        // Convert to lowercase
+        std::transform(result.begin(), result.end(), result.begin(), ::tolower);
+
+        // Remove common words
+        for (const auto& word : commonWords)
+        {
+            size_t pos = 0;
+            while ((pos = result.find(word, pos)) != std::string::npos)
+            {
+                // Check if it's a whole word (surrounded by non-alphanumeric or at boundaries)
+                bool isWholeWord = true;
+                if (pos > 0 && std::isalnum(result[pos - 1]))
+                    isWholeWord = false;
+                if (pos + word.length() < result.length() && std::isalnum(result[pos + word.length()]))
+                    isWholeWord = false;
+
+                if (isWholeWord)
+                {
+                    result.erase(pos, word.length());
+                    // Remove following space/hyphen if exists
+                    if (pos < result.length() && (result[pos] == ' ' || result[pos] == '-'))
+                        result.erase(pos, 1);
+                }
+                else
+                {
+                    pos += word.length();
+                }
+            }
+        }
+
+        // Apply manufacturer abbreviations
+        for (const auto& [full, abbrev] : manufacturerAbbrevs)
+        {
+            size_t pos = 0;
+            while ((pos = result.find(full, pos)) != std::string::npos)
+            {
+                bool isWholeWord = true;
+                if (pos > 0 && std::isalnum(result[pos - 1]))
+                    isWholeWord = false;
+                if (pos + full.length() < result.length() && std::isalnum(result[pos + full.length()]))
+                    isWholeWord = false;
+
+                if (isWholeWord)
+                {
+                    result.erase(pos, full.length());
+                    if (!abbrev.empty())
+                    {
+                        result.insert(pos, abbrev);
+                        pos += abbrev.length();
+                    }
+                    // Remove following space/hyphen if exists
+                    if (pos < result.length() && (result[pos] == ' ' || result[pos] == '-'))
+                        result.erase(pos, 1);
+                }
+                else
+                {
+                    pos += full.length();
+                }
+            }
+        }
+
+        // Remove all spaces, hyphens, and special characters, keep only alphanumeric
+        result.erase(std::remove_if(result.begin(), result.end(),
+            [](char c) { return !std::isalnum(c); }), result.end());
+
+        return result;
+    }
+
+    /** @brief Weapon-style name from rule words, model numbers and mixed separators */
+    std::string BuildSyntheticName(std::mt19937& rng)
+    {
+        static const std::vector<std::string> manufacturers = {
+            "Heckler & Koch", "Smith & Wesson", "Sig Sauer", "FN Herstal", "Colt", "Glock",
+            "Beretta", "Winchester", "Remington", "Heckler and Koch", "SIG", "Smith-Wesson"
+        };
+        static const std::vector<std::string> models = {
+            "HK416", "MP5", "M4A1", "P226", "G17", "92FS", "M1911", "AK-47", "870", "70",
+            "1894", "SCAR-H", "UMP45", "Mk 18", "V2", "Ed. 3", "Gen5", "Canned Beans", "Water Bottle"
+        };
+        static const std::vector<std::string> separators = {
+            " ", " ", " ", " ", "-", "-", " - ", " & ", "/", "  ", ". ", " (", ") ", ", ",
+            "--", " -", "- ", "-(", " -- ", "&"
+        };
+
+        // Rule words, plus the halves of multi-word rules so removals can close them up
+        const IdShorteningRules& rules = IdShortener::GetDefaultRules();
+        std::vector<std::string> words(rules.removeWords);
+        for (const auto& abbreviation : rules.abbreviations)
+            words.push_back(abbreviation.first);
+        for (const char* half : { "semi", "auto", "full", "lever", "bolt", "pump", "action" })
+            words.push_back(half);
+
+        std::string name;
+        const int pieces = 2 + static_cast<int>(rng() % 5);
+        for (int i = 0; i < pieces; ++i)
+        {
+            if (i > 0)
+                name += separators[rng() % separators.size()];
+            const uint32_t kind = rng() % 10;
+            std::string piece;
+            if (kind < 2)
+                piece = manufacturers[rng() % manufacturers.size()];
+            else if (kind < 5)
+                piece = models[rng() % models.size()];
+            else
+                piece = words[rng() % words.size()];
+
+            // Mixed case, as LLMs write it
+            for (char& c : piece)
+            {
+                if (rng() % 3 == 0)
+                    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            }
+            name += piece;
+        }
+        return name;
+    }
+}
+
+int ReIdBench::Run(const std::string& catalogPath)
+{
+    std::vector<std::string> catalogNames;
+    LazyCatalogReader reader;
+    if (!reader.Open(catalogPath))
+    {
+        std::cerr << "[Bench] Cannot read catalog: " << catalogPath << "\n";
+        return 1;
+    }
+    std::string displayName;
+    reader.ForEachItem([&](const char* text, size_t length)
+    {
+        if (JsonUtils::FindTopLevelString(text, length, "displayName", displayName))
+            catalogNames.push_back(displayName);
+        return true;
+    });
+
+    std::vector<std::string> syntheticNames(kCloseUpNames);
+    std::mt19937 rng(BenchRunner::kSeed);
+    for (int i = 0; i < kSyntheticNames; ++i)
+        syntheticNames.push_back(BuildSyntheticName(rng));
+
+    const IdShortener& shortener = IdShortener::Default();
+    std::cout << "[Bench] reid: " << catalogPath << " (" << catalogNames.size() << " names, "
+              << syntheticNames.size() << " synthetic names, " << shortener.GetRuleCount() << " rules)\n";
+
+    int mismatches = 0;
+    for (const auto* names : { &catalogNames, &syntheticNames })
+    {
+        for (const auto& name : *names)
+        {
+            const std::string legacy = LegacyGenerateShortIdFromDisplayName(name);
+            const std::string compiled = shortener.Shorten(name);
+            if (legacy == compiled)
+                continue;
+            if (++mismatches <= kMaxReportedMismatches)
+            {
+                std::cerr << "[Bench] \"" << name << "\": legacy \"" << legacy
+                          << "\", compiled \"" << compiled << "\"\n";
+            }
+        }
+    }
+    std::cout << "[Bench] Equivalence: " << (catalogNames.size() + syntheticNames.size())
+              << " names checked, " << mismatches << " mismatches\n";
+
+    // Timed over several passes; the digest of all suffixes must match too
+    const std::vector<const std::vector<std::string>*> nameLists{ &catalogNames, &syntheticNames };
+    auto shortenAll = [&](size_t input, auto&& shorten)
+    {
+        uint64_t digest = 0;
+        for (int pass = 0; pass < kPasses; ++pass)
+        {
+            for (const auto& name : *nameLists[input])
+                digest += ShardedCatalogWriter::HashId(shorten(name));
+        }
+        return std::to_string(digest);
+    };
+
+    BenchComparison comparison;
+    comparison.title = "Bulk re-ID";
+    comparison.referenceName = "legacy";
+    comparison.candidateName = "compiled";
+    for (size_t input = 0; input < nameLists.size(); ++input)
+    {
+        size_t bytes = 0;
+        for (const auto& name : *nameLists[input])
+            bytes += name.size();
+        comparison.inputs.push_back({ input == 0 ? "catalog" : "synthetic", bytes * kPasses });
+    }
+    comparison.reference = [&](size_t input)
+    {
+        return shortenAll(input, [](const std::string& name) { return LegacyGenerateShortIdFromDisplayName(name); });
+    };
+    comparison.candidate = [&](size_t input)
+    {
+        return shortenAll(input, [&](const std::string& name) { return shortener.Shorten(name); });
+    };
+    comparison.countItems = [&](size_t input, const std::string&) { return nameLists[input]->size() * kPasses; };
+    mismatches += BenchRunner::RunComparison(comparison);
+
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,428 @@
+/**
+ * @file RepairBench.cpp
+ * @brief Implementation of the JSON repair property test and benchmark
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Bench/RepairBench.h"
+#include "Bench/BenchRunner.h"
+#include "Parsers/LazyCatalogReader.h"
+#include "Utils/JsonRepair.h"
+#include "Utils/StringUtils.h"
+#include <json.hpp>
+#include <iostream>
+#include <random>
+#include <string_view>
+
+using nlohmann::json;
+
+namespace
+{
+    const size_t kMaxItems = 20000;
+    const int kCasesPerKind = 2000;
+    const int kCommaHeavyElements = 10000;
+
+    /** @brief StringUtils::FixCommonJsonErrors before JsonRepair, unchanged */
+    std::string LegacyFixCommonJsonErrors(const std::string& input)
+    {
+        std::string s = input;
+
+        size_t pos = 0;
+        while (pos < s.length())
+        {
+            if (s[pos] == ')' && pos + 1 < s.length())
+            {
+                char next = s[pos + 1];
+                if ((next >= 'a' && next <= 'z') || (next >= 'A' && next <= 'Z') || next == '_')
+                {
+                    size_t keyEnd = pos + 1;
+                    while (keyEnd < s.length() &&
+                           ((s[keyEnd] >= 'a' && s[keyEnd] <= 'z') ||
+                            (s[keyEnd] >= 'A' && s[keyEnd] <= 'Z') ||
+                            (s[keyEnd] >= '0' && s[keyEnd] <= '9') ||
+                            s[keyEnd] == '_'))
+                    {
+                        keyEnd++;
+                    }
+
+                    if (keyEnd < s.length())
+                    {
+                        size_t checkPos = keyEnd;
+                        while (checkPos < s.length() && (s[checkPos] == ' ' || s[checkPos] == '\t'))
+                            checkPos++;
+
+                        if (checkPos + 1 < s.length() && s[checkPos] == '"' && s[checkPos + 1] == ':')
+                        {
+                            std::string keyName = s.substr(pos + 1, keyEnd - pos - 1);
+                            s.replace(pos, checkPos + 2 - pos, "\"" + keyName + "\":" + s.substr(checkPos + 2));
+                            pos = checkPos + 2;
+                            continue;
+                        }
+                        else if (checkPos < s.length() && s[checkPos] == '"')
+                        {
+                            std::string keyName = s.substr(pos + 1, keyEnd - pos - 1);
+                            std::string afterKey = s.substr(keyEnd, checkPos - keyEnd);
+                            s.replace(pos, checkPos - pos, "\"" + keyName + "\"" + afterKey);
+                            pos = checkPos + 1;
+                            continue;
+                        }
+                    }
+                }
+            }
+            pos++;
+        }
+
+        pos = 0;
+        while ((pos = s.find("\"id\": \"", pos)) != std::string::npos)
+        {
+            size_t idStart = pos + 7;
+            size_t idEnd = s.find("\"", idStart);
+            if (idEnd != std::string::npos)
+            {
+                std::string idValue = s.substr(idStart, idEnd - idStart);
+                for (size_t i = 0; i < idValue.length(); i++)
+                {
+                    if (idValue[i] == ' ')
+                        idValue[i] = '_';
+                }
+                s.replace(idStart, idEnd - idStart, idValue);
+                pos = idStart + idValue.length();
+            }
+            else
+            {
+                pos++;
+            }
+        }
+
+        return s;
+    }
+
+    /** @brief StringUtils::CleanJsonArrayText before JsonRepair, unchanged */
+    std::string LegacyCleanJsonArrayText(const std::string& input)
+    {
+        std::string s = input;
+        StringUtils::TrimString(s);
+        if (s.empty())
+            return s;
+
+        s = LegacyFixCommonJsonErrors(s);
+
+        size_t first = s.find('[');
+        size_t last = s.find_last_of(']');
+        if (first != std::string::npos && last != std::string::npos && last >= first)
+            s = s.substr(first, last - first + 1);
+
+        size_t pos = 0;
+        while (pos < s.size())
+        {
+            size_t lineStart = pos;
+            size_t lineEnd = s.find('\n', lineStart);
+            if (lineEnd == std::string::npos) lineEnd = s.size();
+
+            std::string_view line(&s[lineStart], lineEnd - lineStart);
+            size_t ls = 0;
+            while (ls < line.size() && (line[ls] == ' ' || line[ls] == '\t' || line[ls] == '\r')) ls++;
+            size_t le = line.size();
+            while (le > ls && (line[le - 1] == ' ' || line[le - 1] == '\t' || line[le - 1] == '\r')) le--;
+            if (line.substr(ls, le - ls) == "...")
+            {
+                s.erase(lineStart);
+                break;
+            }
+            pos = (lineEnd < s.size()) ? (lineEnd + 1) : s.size();
+        }
+
+        auto replaceAll = [&](const std::string& from, const std::string& to)
+        {
+            size_t p = 0;
+            while ((p = s.find(from, p)) != std::string::npos)
+                s.replace(p, from.size(), to);
+        };
+        replaceAll(",\r\n]", "\r\n]");
+        replaceAll(",\n]", "\n]");
+        replaceAll(", ]", " ]");
+        replaceAll(",]", "]");
+
+        int idx = static_cast<int>(s.size()) - 1;
+        while (idx >= 0 && (s[idx] == ' ' || s[idx] == '\t' || s[idx] == '\r' || s[idx] == '\n'))
+            --idx;
+        if (idx >= 0 && s[idx] == ',')
+            s.erase(static_cast<size_t>(idx), 1);
+
+        int bracketBalance = 0;
+        for (char c : s)
+        {
+            if (c == '[')
+                ++bracketBalance;
+            else if (c == ']')
+                --bracketBalance;
+        }
+        if (bracketBalance > 0)
+        {
+            int lastIdx = static_cast<int>(s.size()) - 1;
+            while (lastIdx >= 0 && (s[lastIdx] == ' ' || s[lastIdx] == '\t' || s[lastIdx] == '\r' || s[lastIdx] == '\n'))
+                --lastIdx;
+            if (lastIdx >= 0 && s[lastIdx] == ',')
+                s.erase(static_cast<size_t>(lastIdx), 1);
+        }
+        while (bracketBalance > 0)
+        {
+            s += "\n]";
+            bracketBalance--;
+        }
+        return s;
+    }
+
+    // ------------------------------------------------------------------
+    // Response construction and damage
+    // ------------------------------------------------------------------
+
+    /**
+     * @struct Response
+     * @brief A pretty-printed item array and where each element sits in it
+     */
+    struct Response
+    {
+        std::string text;
+        std::vector<size_t> elementBegin;   ///< Offset of each element's '{'
+        std::vector<size_t> elementEnd;     ///< Offset one past each element's '}'
+    };
+
+    /** @brief Same layout as json::array(items).dump(2), with element offsets recorded */
+    Response BuildResponse(const std::vector<json>& items)
+    {
+        Response response;
+        response.text = "[\n";
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            if (i > 0)
+                response.text += ",\n";
+            response.text += "  ";
+            response.elementBegin.push_back(response.text.size());
+            const std::string dumped = items[i].dump(2);
+            for (char c : dumped)
+            {
+                response.text += c;
+                if (c == '\n')
+                    response.text += "  ";
+            }
+            response.elementEnd.push_back(response.text.size());
+        }
+        response.text += "\n]";
+        return response;
+    }
+
+    /** @brief Replace one random occurrence of @p from (false if there is none) */
+    bool ReplaceRandom(std::string& text, const std::string& from, const std::string& to, std::mt19937& rng)
+    {
+        std::vector<size_t> hits;
+        for (size_t p = text.find(from); p != std::string::npos; p = text.find(from, p + 1))
+            hits.push_back(p);
+        if (hits.empty())
+            return false;
+        text.replace(hits[rng() % hits.size()], from.size(), to);
+        return true;
+    }
+
+    json ParseOrDiscard(const std::string& text)
+    {
+        return json::parse(text, nullptr, false);
+    }
+
+    std::vector<json> PickItems(const std::vector<json>& pool, std::mt19937& rng)
+    {
+        std::vector<json> items;
+        const size_t count = 1 + rng() % 8;
+        for (size_t i = 0; i < count; ++i)
+            items.push_back(pool[rng() % pool.size()]);
+        return items;
+    }
+
+    void ReportFailure(const char* kind, int index, const std::string& text)
+    {
+        std::cerr << "[Bench] " << kind << " case " << index << " failed; input:\n"
+                  << text.substr(0, 600) << (text.size() > 600 ? "\n...(cut)" : "") << "\n";
+    }
+
+    /**
+     * @brief Damage the old cleaner handled; returns false on a property violation
+     */
+    bool RunLegacyCase(const std::vector<json>& pool, std::mt19937& rng, int index, int& outComparable)
+    {
+        std::vector<json> items = PickItems(pool, rng);
+        if (rng() % 4 == 0)
+        {
+            json& item = items[rng() % items.size()];
+            if (item.contains("id") && item["id"].is_string())
+                item["id"] = "fresh " + item["id"].get<std::string>() + " box";
+        }
+
+        Response response = BuildResponse(items);
+        std::string text = response.text;
+        const bool missingClose = rng() % 4 == 0;
+        if (rng() % 3 == 0 && items.size() > 1)
+        {
+            // The model elided the rest of the list
+            const size_t keep = 1 + rng() % (items.size() - 1);
+            text = text.substr(0, response.elementEnd[keep - 1]) + ",\n  ...\n]";
+        }
+        if (rng() % 2 == 0)
+            text.insert(text.size() - 2, ",");
+        if (missingClose)
+            text.pop_back();
+        if (rng() % 2 == 0)
+            text = "Here are the generated items:\n```json\n" + text;
+        if (!missingClose && rng() % 2 == 0)
+            text += "\n```\nLet me know if you need more.";
+
+        const json legacy = ParseOrDiscard(LegacyCleanJsonArrayText(text));
+        if (legacy.is_discarded())
+            return true; // Nothing to compare against
+        ++outComparable;
+
+        const json repaired = ParseOrDiscard(JsonRepair::RepairJsonText(text));
+        if (repaired.is_discarded() || repaired != legacy)
+        {
+            ReportFailure("legacy", index, text);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Damage only the single-pass repair handles; must parse to the intended items
+     */
+    bool RunRepairCase(const std::vector<json>& pool, std::mt19937& rng, int index)
+    {
+        std::vector<json> items = PickItems(pool, rng);
+        std::string text;
+        std::vector<json> expected;
+
+        if (rng() % 3 == 0)
+        {
+            // Cut off inside one element: everything before it survives
+            Response response = BuildResponse(items);
+            const size_t cutElement = rng() % items.size();
+            const size_t begin = response.elementBegin[cutElement] + 1;
+            const size_t end = response.elementEnd[cutElement] - 1;
+            text = response.text.substr(0, begin + rng() % (end - begin));
+            expected.assign(items.begin(), items.begin() + cutElement);
+        }
+        else
+        {
+            const bool rawNewline = rng() % 2 == 0;
+            if (rawNewline)
+            {
+                for (json& item : items)
+                {
+                    if (item.is_object())
+                        item["displayName"] = item.value("displayName", std::string()) + "\nSecond line";
+                }
+            }
+            expected = items;
+            text = BuildResponse(items).text;
+            if (rawNewline)
+            {
+                for (size_t p = text.find("\\nSecond line"); p != std::string::npos; p = text.find("\\nSecond line", p))
+                    text.replace(p, 2, "\n");
+            }
+            if (rng() % 2 == 0)
+                ReplaceRandom(text, "},\n  {", "}\n  {", rng);
+            if (rng() % 2 == 0)
+                ReplaceRandom(text, "\n  }", ",\n  }", rng);
+            if (rng() % 2 == 0)
+                ReplaceRandom(text, "\"displayName\":", ")displayName\":", rng);
+        }
+        const unsigned prose = rng() % 4;
+        if (prose == 1)
+            text = "Sure! " + text;
+        else if (prose == 2)
+            text = "Here are [" + std::to_string(items.size()) + "] items:\n" + text; // Bracket in prose is not the root
+
+        const json repaired = ParseOrDiscard(JsonRepair::RepairJsonText(text));
+        if (repaired.is_discarded() || repaired != json(expected))
+        {
+            ReportFailure("repair-only", index, text);
+            return false;
+        }
+        return true;
+    }
+
+    size_t CountElements(const std::string& text)
+    {
+        const json parsed = ParseOrDiscard(text);
+        return parsed.is_array() ? parsed.size() : 0;
+    }
+}
+
+int RepairBench::Run(const std::string& catalogPath)
+{
+    std::vector<json> pool;
+    LazyCatalogReader reader;
+    if (reader.Open(catalogPath))
+    {
+        reader.ForEachItem([&](const char* text, size_t length)
+        {
+            json item = ParseOrDiscard(std::string(text, length));
+            if (item.is_object())
+                pool.push_back(std::move(item));
+            return pool.size() < kMaxItems;
+        });
+    }
+    if (pool.empty())
+    {
+        std::cerr << "[Bench] Cannot read catalog: " << catalogPath << "\n";
+        return 1;
+    }
+    std::cout << "[Bench] repair: " << catalogPath << " (" << pool.size() << " items)\n";
+
+    std::mt19937 rng(BenchRunner::kSeed);
+    int failures = 0;
+    int comparable = 0;
+    for (int i = 0; i < kCasesPerKind; ++i)
+    {
+        if (!RunLegacyCase(pool, rng, i, comparable))
+            ++failures;
+    }
+    for (int i = 0; i < kCasesPerKind; ++i)
+    {
+        if (!RunRepairCase(pool, rng, i))
+            ++failures;
+    }
+    std::cout << "[Bench] Property cases: " << comparable << "/" << kCasesPerKind
+              << " legacy cases parsed by the old cleaner matched, " << kCasesPerKind
+              << " repair-only cases checked, " << failures << " failures\n";
+
+    // Whole catalog as one response wrapped in prose, with a trailing comma
+    std::string catalogText = "Here is the catalog:\n" + BuildResponse(pool).text;
+    catalogText.insert(catalogText.size() - 2, ",");
+    catalogText += "\nAll items follow the schema.";
+
+    // Many trailing commas: the old cleaner shifted the tail once per comma
+    std::string commaText = "[\n";
+    for (int i = 0; i < kCommaHeavyElements; ++i)
+        commaText += "  {\"id\": \"bench_item_" + std::to_string(i) + "\", \"tags\": [\"a\", \"b\",]},\n";
+    commaText += "]";
+
+    const std::vector<const std::string*> texts{ &catalogText, &commaText };
+    BenchComparison comparison;
+    comparison.title = "LLM JSON repair";
+    comparison.referenceName = "legacy";
+    comparison.candidateName = "single-pass";
+    comparison.inputs = { { "catalog", catalogText.size() }, { "comma-heavy", commaText.size() } };
+    comparison.reference = [&](size_t input) { return LegacyCleanJsonArrayText(*texts[input]); };
+    comparison.candidate = [&](size_t input) { return JsonRepair::RepairJsonText(*texts[input]); };
+    comparison.countItems = [](size_t, const std::string& result) { return CountElements(result); };
+    comparison.equivalent = [](const std::string& legacyOut, const std::string& repairedOut)
+    {
+        // Discarded values never compare equal or unequal, so check them explicitly
+        const json legacy = ParseOrDiscard(legacyOut);
+        const json repaired = ParseOrDiscard(repairedOut);
+        return !legacy.is_discarded() && !repaired.is_discarded() && legacy == repaired;
+    };
+    failures += BenchRunner::RunComparison(comparison);
+
+    return failures == 0 ? 0 : 1;
+}
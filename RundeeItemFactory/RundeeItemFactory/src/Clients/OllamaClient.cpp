@@ -11,11 +11,16 @@
 #include "Clients/OllamaClient.h"
 #include "Helpers/AppConfig.h"
 #include "Utils/StringUtils.h"
+#include "Clients/OllamaRequestBody.h"
+#include "Parsers/NdjsonEnvelopeDecoder.h"
+#include <json.hpp>
 #include <iostream>
 #include <thread>
 #include <chrono>
-#include <sstream>
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <windows.h>
 #include <winhttp.h>
 
@@ -38,193 +43,129 @@ namespace
         }
     }
 
+    /** @brief Mutex protecting the shared session and connection map */
+    std::mutex g_connectionMutex;
+
+    /** @brief Process-wide WinHTTP session; its connection pool keeps sockets to Ollama alive between calls */
+    HINTERNET g_session = NULL;
+
+    /** @brief Connection handles keyed by "host:port", reused by every request to that server */
+    std::map<std::string, HINTERNET> g_connections;
+
     /**
-     * @brief Build JSON request body for Ollama API
-     * @param modelName Name of the LLM model (e.g., "llama3")
-     * @param prompt Prompt text to send to the LLM
-     * @return JSON string in format: {"model":"name","prompt":"text","stream":false}
+     * @brief Get the shared connection handle for a server, creating it on first use
+     * @param host Server hostname (used for the cache key and logging)
+     * @param hostW Server hostname as a wide string
+     * @param port Server port
+     * @return Connection handle, or NULL on error
      * 
-     * Escapes JSON special characters in the prompt text to ensure valid JSON.
-     * Pre-allocates string memory for performance optimization.
+     * WinHTTP session and connection handles are thread-safe, so concurrent
+     * jobs share them and only open/close their own request handles. Reusing
+     * the session lets WinHTTP keep TCP connections alive across requests
+     * instead of reconnecting for every call.
      */
-    std::string BuildJsonRequest(const std::string& modelName, const std::string& prompt)
+    HINTERNET AcquireConnection(const std::string& host, const std::wstring& hostW, INTERNET_PORT port)
     {
-        // Pre-allocate string with estimated size (model name + prompt length + overhead)
-        std::string json;
-        json.reserve(modelName.length() + prompt.length() * 2 + 50); // Reserve extra space for escaped chars
+        std::lock_guard<std::mutex> lock(g_connectionMutex);
+        
+        if (g_session == NULL)
+        {
+            g_session = WinHttpOpen(L"RundeeItemFactory/1.0",
+                                    WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
+                                    WINHTTP_NO_PROXY_NAME,
+                                    WINHTTP_NO_PROXY_BYPASS, 0);
+            if (g_session == NULL)
+            {
+                DWORD error = GetLastError();
+                std::cerr << "[OllamaClient] WinHttpOpen failed. Error code: " << error 
+                          << ". Check if WinHTTP is properly installed.\n";
+                return NULL;
+            }
+        }
         
-        json = "{\"model\":\"";
-        json += modelName;
-        json += "\",\"prompt\":\"";
+        const std::string key = host + ":" + std::to_string(port);
+        auto it = g_connections.find(key);
+        if (it != g_connections.end())
+        {
+            return it->second;
+        }
         
-        // Escape JSON special characters in prompt
-        for (char c : prompt)
+        HINTERNET hConnect = WinHttpConnect(g_session, hostW.c_str(), port, 0);
+        if (hConnect == NULL)
         {
-            if (c == '"')
-                json += "\\\"";
-            else if (c == '\\')
-                json += "\\\\";
-            else if (c == '\n')
-                json += "\\n";
-            else if (c == '\r')
-                json += "\\r";
-            else if (c == '\t')
-                json += "\\t";
-            else
-                json += c;
+            DWORD error = GetLastError();
+            std::cerr << "[OllamaClient] WinHttpConnect failed. Error code: " << error 
+                      << " (host=" << host << ", port=" << port << ")\n";
+            return NULL;
         }
         
-        json += "\",\"stream\":false}";
-        return json;
+        g_connections[key] = hConnect;
+        return hConnect;
     }
 
     /**
-     * @brief Extract response text from Ollama JSON response
-     * @param jsonResponse Raw JSON response string from Ollama API
-     * @return Extracted response text with all chunks concatenated
+     * @brief Read Ollama's token counters, timings and context from a response line
+     * @param line One JSON object line from the Ollama response (its "response" text may be emptied)
+     * @param outStats Stats structure to fill
+     * @param outContext Optional output for the returned conversation context
      * 
-     * Ollama API can return multiple JSON objects (one per line) when stream: false.
-     * Each line format: {"response": "text_chunk", "done": false}
-     * Last line format: {"response": "text_chunk", "done": true}
-     * 
-     * This function:
-     * - Parses each line as a separate JSON object
-     * - Extracts the "response" field from each line
-     * - Unescapes JSON escape sequences
-     * - Concatenates all chunks into a single string
-     * 
-     * Pre-allocates result string for performance optimization.
+     * Only the final object ("done": true) carries these fields, so lines
+     * without "eval_count" or "context" are skipped before paying for a full parse.
      */
-    std::string ExtractResponseFromJson(const std::string& jsonResponse)
+    void ParseDoneLine(const std::string& line, OllamaCallStats& outStats, std::vector<int>* outContext)
     {
-        std::string result;
-        result.reserve(jsonResponse.length() / 2); // Pre-allocate estimated size
-        std::istringstream stream(jsonResponse);
-        std::string line;
-        
-        // Process each line (each line is a JSON object)
-        while (std::getline(stream, line))
+        if (line.find("\"eval_count\"") == std::string::npos &&
+            line.find("\"prompt_eval_count\"") == std::string::npos &&
+            line.find("\"context\"") == std::string::npos)
         {
-            // Skip empty lines
-            if (line.empty() || line.find_first_not_of(" \t\r\n") == std::string::npos)
-                continue;
-            
-            // Find "response" field in this line
-            size_t responseStart = line.find("\"response\":\"");
-            if (responseStart == std::string::npos)
-            {
-                // Try without quotes (in case of unquoted value, though unlikely)
-                responseStart = line.find("\"response\":");
-                if (responseStart == std::string::npos)
-                {
-                    continue; // Skip this line if no response field
-                }
-                responseStart += 11; // Skip "response":
-                
-                // Skip whitespace
-                while (responseStart < line.length() && 
-                       (line[responseStart] == ' ' || line[responseStart] == '\t'))
-                {
-                    responseStart++;
-                }
-                
-                // Check if it's a quoted string
-                if (responseStart < line.length() && line[responseStart] == '"')
-                {
-                    responseStart++; // Skip opening quote
-                }
-            }
-            else
+            return;
+        }
+
+        try
+        {
+            nlohmann::json j = nlohmann::json::parse(line);
+            if (!j.is_object())
+                return;
+
+            auto readCount = [&j](const char* key, long long& out)
             {
-                responseStart += 12; // Skip "response":"
-            }
-            
-            // Find the end of the response string value
-            size_t responseEnd = responseStart;
-            bool escaped = false;
-            
-            while (responseEnd < line.length())
+                if (j.contains(key) && j[key].is_number_integer())
+                    out = j[key].get<long long>();
+            };
+            readCount("prompt_eval_count", outStats.promptEvalCount);
+            readCount("prompt_eval_duration", outStats.promptEvalDurationNs);
+            readCount("eval_count", outStats.evalCount);
+            readCount("eval_duration", outStats.evalDurationNs);
+            readCount("load_duration", outStats.loadDurationNs);
+            readCount("total_duration", outStats.totalDurationNs);
+            if (j.contains("eval_count") || j.contains("prompt_eval_count"))
             {
-                if (escaped)
-                {
-                    escaped = false;
-                    responseEnd++;
-                    continue;
-                }
-                
-                if (line[responseEnd] == '\\')
-                {
-                    escaped = true;
-                    responseEnd++;
-                    continue;
-                }
-                
-                if (line[responseEnd] == '"')
-                {
-                    break;
-                }
-                
-                responseEnd++;
+                outStats.hasServerStats = true;
             }
             
-            if (responseEnd > responseStart)
+            if (outContext && j.contains("context") && j["context"].is_array())
             {
-                std::string extracted = line.substr(responseStart, responseEnd - responseStart);
-                
-                // Unescape JSON escape sequences and append to result
-                for (size_t i = 0; i < extracted.length(); ++i)
+                outContext->clear();
+                outContext->reserve(j["context"].size());
+                for (const auto& token : j["context"])
                 {
-                    if (extracted[i] == '\\' && i + 1 < extracted.length())
-                    {
-                        switch (extracted[i + 1])
-                        {
-                        case 'n':
-                            result += '\n';
-                            i++;
-                            break;
-                        case 'r':
-                            result += '\r';
-                            i++;
-                            break;
-                        case 't':
-                            result += '\t';
-                            i++;
-                            break;
-                        case '\\':
-                            result += '\\';
-                            i++;
-                            break;
-                        case '"':
-                            result += '"';
-                            i++;
-                            break;
-                        default:
-                            result += extracted[i];
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        result += extracted[i];
-                    }
+                    if (token.is_number_integer())
+                        outContext->push_back(token.get<int>());
                 }
             }
         }
-        
-        // If we couldn't extract anything, return the original response
-        // (might be that the response is already the final text)
-        if (result.empty())
+        catch (const std::exception&)
         {
-            return jsonResponse;
+            // Malformed stats line; stats are optional, keep going
         }
-        
-        return result;
     }
 }
 
 std::string OllamaClient::RunSimple(const std::string& modelName, 
                                     const std::string& prompt,
-                                    const OllamaSettings& settings)
+                                    const OllamaSettings& settings,
+                                    OllamaCallStats* outStats,
+                                    std::vector<int>* context)
 {
     const std::string host = settings.host.empty() ? "localhost" : settings.host;
     const INTERNET_PORT port = static_cast<INTERNET_PORT>(settings.port > 0 ? settings.port : 11434);
@@ -235,9 +176,13 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
 
     std::cout << "[OllamaClient] Calling Ollama HTTP API (model=" << modelName
         << ", host=" << host << ", port=" << port << ")\n";
+    if (context && !context->empty())
+    {
+        std::cout << "[OllamaClient] Continuing conversation (" << context->size() << " context tokens)\n";
+    }
     
-    // Build JSON request
-    std::string jsonRequest = BuildJsonRequest(modelName, prompt);
+    // Request body is streamed from the prompt below; only its length is computed here
+    const OllamaRequestBody requestBody(modelName, prompt, context);
     
     // Convert host to wide string
     int wideLen = MultiByteToWideChar(CP_UTF8, 0, host.c_str(), -1, nullptr, 0);
@@ -251,29 +196,10 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
 
     auto requestStart = std::chrono::steady_clock::now();
 
-    // Initialize WinHTTP
-    HINTERNET hSession = WinHttpOpen(L"RundeeItemFactory/1.0",
-                                     WINHTTP_ACCESS_TYPE_DEFAULT_PROXY,
-                                     WINHTTP_NO_PROXY_NAME,
-                                     WINHTTP_NO_PROXY_BYPASS, 0);
-    
-    if (!hSession)
-    {
-        DWORD error = GetLastError();
-        std::cerr << "[OllamaClient] WinHttpOpen failed. Error code: " << error 
-                  << ". Check if WinHTTP is properly installed.\n";
-        return {};
-    }
-    
-    // Connect to Ollama server
-    HINTERNET hConnect = WinHttpConnect(hSession, hostW.c_str(), port, 0);
-    
+    // Shared session/connection (kept alive across calls and jobs)
+    HINTERNET hConnect = AcquireConnection(host, hostW, port);
     if (!hConnect)
     {
-        DWORD error = GetLastError();
-        std::cerr << "[OllamaClient] WinHttpConnect failed. Error code: " << error 
-                  << " (host=" << host << ", port=" << port << ")\n";
-        SafeCloseHandle(hSession);
         return {};
     }
     
@@ -290,8 +216,6 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
     {
         DWORD error = GetLastError();
         std::cerr << "[OllamaClient] WinHttpOpenRequest failed. Error code: " << error << "\n";
-        SafeCloseHandle(hConnect);
-        SafeCloseHandle(hSession);
         return {};
     }
     
@@ -302,27 +226,37 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
         DWORD error = GetLastError();
         std::cerr << "[OllamaClient] WinHttpAddRequestHeaders failed. Error code: " << error << "\n";
         SafeCloseHandle(hRequest);
-        SafeCloseHandle(hConnect);
-        SafeCloseHandle(hSession);
         return {};
     }
     
     // Set timeout values
     WinHttpSetTimeouts(hRequest, connectTimeout, connectTimeout, sendTimeout, receiveTimeout);
     
-    // Send request
+    // Send headers with the exact Content-Length, then the body piece by piece
+    const DWORD requestLength = static_cast<DWORD>(requestBody.GetLength());
     if (!WinHttpSendRequest(hRequest,
                             WINHTTP_NO_ADDITIONAL_HEADERS, 0,
-                            (LPVOID)jsonRequest.c_str(),
-                            (DWORD)jsonRequest.length(),
-                            (DWORD)jsonRequest.length(), 0))
+                            WINHTTP_NO_REQUEST_DATA, 0,
+                            requestLength, 0))
     {
         DWORD error = GetLastError();
         std::cerr << "[OllamaClient] WinHttpSendRequest failed. Error code: " << error 
-                  << " (request size: " << jsonRequest.length() << " bytes)\n";
+                  << " (request size: " << requestLength << " bytes)\n";
+        SafeCloseHandle(hRequest);
+        return {};
+    }
+    
+    const bool bodySent = requestBody.WriteTo([hRequest](const char* data, size_t size)
+    {
+        DWORD written = 0;
+        return WinHttpWriteData(hRequest, data, static_cast<DWORD>(size), &written) && written == size;
+    });
+    if (!bodySent)
+    {
+        DWORD error = GetLastError();
+        std::cerr << "[OllamaClient] WinHttpWriteData failed. Error code: " << error 
+                  << " (request size: " << requestLength << " bytes)\n";
         SafeCloseHandle(hRequest);
-        SafeCloseHandle(hConnect);
-        SafeCloseHandle(hSession);
         return {};
     }
     
@@ -332,8 +266,6 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
         DWORD error = GetLastError();
         std::cerr << "[OllamaClient] WinHttpReceiveResponse failed. Error code: " << error << "\n";
         SafeCloseHandle(hRequest);
-        SafeCloseHandle(hConnect);
-        SafeCloseHandle(hSession);
         return {};
     }
     
@@ -350,8 +282,6 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
         DWORD error = GetLastError();
         std::cerr << "[OllamaClient] WinHttpQueryHeaders failed. Error code: " << error << "\n";
         SafeCloseHandle(hRequest);
-        SafeCloseHandle(hConnect);
-        SafeCloseHandle(hSession);
         return {};
     }
     
@@ -360,14 +290,27 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
         std::cerr << "[OllamaClient] HTTP request failed with status code: " << statusCode 
                   << " (expected 200 OK). Server may be unavailable or request invalid.\n";
         SafeCloseHandle(hRequest);
-        SafeCloseHandle(hConnect);
-        SafeCloseHandle(hSession);
         return {};
     }
     
-    // Read response data
-    std::string response;
-    response.reserve(32768); // Pre-allocate 32KB for typical responses
+    // Decode the body as it arrives: the NDJSON envelope is stripped and the
+    // text unescaped straight into one buffer sized from Content-Length
+    NdjsonEnvelopeDecoder decoder;
+    DWORD contentLength = 0;
+    DWORD contentLengthSize = sizeof(contentLength);
+    if (WinHttpQueryHeaders(hRequest,
+                            WINHTTP_QUERY_CONTENT_LENGTH | WINHTTP_QUERY_FLAG_NUMBER,
+                            WINHTTP_HEADER_NAME_BY_INDEX,
+                            &contentLength,
+                            &contentLengthSize,
+                            WINHTTP_NO_HEADER_INDEX) && contentLength > 0)
+    {
+        decoder.Reserve(contentLength);
+    }
+    else
+    {
+        decoder.Reserve(32768); // Pre-allocate 32KB for typical responses
+    }
     DWORD bytesAvailable = 0;
     DWORD bytesRead = 0;
     char buffer[8192];
@@ -401,23 +344,35 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
         
         if (bytesRead > 0)
         {
-            response.append(buffer, bytesRead);
+            decoder.Feed(buffer, bytesRead);
         }
     } while (bytesRead > 0);
+    decoder.Finish();
     
-    // Clean up handles (always executed, even if errors occurred during reading)
+    // Clean up the request handle (always executed, even if errors occurred during reading);
+    // the shared connection stays open for the next call
     SafeCloseHandle(hRequest);
-    SafeCloseHandle(hConnect);
-    SafeCloseHandle(hSession);
     
-    if (response.empty())
+    if (decoder.GetBytesFed() == 0)
     {
         std::cerr << "[OllamaClient] Received empty response.\n";
         return {};
     }
+    if (decoder.GetInvalidEscapes() > 0)
+    {
+        std::cerr << "[OllamaClient] Warning: " << decoder.GetInvalidEscapes()
+                  << " malformed escape(s) in the response text\n";
+    }
     
-    // Extract the actual response text from Ollama JSON
-    std::string extractedResponse = ExtractResponseFromJson(response);
+    // Token counters, timings and context are on the final ("done") line;
+    // a body that was not an envelope is already the final text
+    OllamaCallStats callStats;
+    std::vector<int> returnedContext;
+    if (decoder.IsEnvelope())
+    {
+        ParseDoneLine(decoder.GetLastEnvelope(), callStats, &returnedContext);
+    }
+    std::string extractedResponse = decoder.TakeText();
     
     // Clean up the response (remove any leading/trailing whitespace)
     std::string trimmed = extractedResponse;
@@ -462,13 +417,51 @@ std::string OllamaClient::RunSimple(const std::string& modelName,
     std::cout << "[OllamaClient] HTTP call succeeded in " << std::fixed << std::setprecision(2)
         << durationSeconds << "s (" << host << ":" << port << ")\n";
 
+    callStats.wallSeconds = durationSeconds;
+    if (callStats.hasServerStats)
+    {
+        const double decodeSeconds = callStats.evalDurationNs / 1e9;
+        const double prefillSeconds = callStats.promptEvalDurationNs / 1e9;
+        std::cout << "[OllamaClient] Tokens: prompt=" << callStats.promptEvalCount
+            << " (" << prefillSeconds << "s), generated=" << callStats.evalCount
+            << " (" << decodeSeconds << "s), load=" << (callStats.loadDurationNs / 1e9) << "s";
+        if (decodeSeconds > 0.0)
+        {
+            std::cout << ", decode " << (callStats.evalCount / decodeSeconds) << " tok/s";
+        }
+        std::cout << "\n";
+    }
+    if (outStats)
+    {
+        *outStats = callStats;
+    }
+    if (context)
+    {
+        // Empty if the server returned no context; the caller then falls back to a full prompt
+        *context = std::move(returnedContext);
+    }
+
     return trimmed;
 }
 
+void OllamaClient::ReleaseConnections()
+{
+    std::lock_guard<std::mutex> lock(g_connectionMutex);
+    for (auto& kv : g_connections)
+    {
+        SafeCloseHandle(kv.second);
+    }
+    g_connections.clear();
+    SafeCloseHandle(g_session);
+    g_session = NULL;
+}
+
 std::string OllamaClient::RunWithRetry(const std::string& modelName, 
                                        const std::string& prompt,
                                        int maxRetries,
-                                       int timeoutSeconds)
+                                       int timeoutSeconds,
+                                       OllamaCallStats* outStats,
+                                       std::vector<int>* context)
 {
     const OllamaSettings& config = AppConfig::GetOllamaSettings();
     OllamaSettings effective = config;
@@ -493,7 +486,13 @@ std::string OllamaClient::RunWithRetry(const std::string& modelName,
     {
         std::cout << "[OllamaClient] Attempt " << attempt << " of " << effective.maxRetries << "\n";
         
-        result = RunSimple(modelName, prompt, effective);
+        OllamaCallStats attemptStats;
+        std::vector<int> attemptContext;
+        if (context)
+        {
+            attemptContext = *context; // Every attempt continues from the same point
+        }
+        result = RunSimple(modelName, prompt, effective, &attemptStats, context ? &attemptContext : nullptr);
         
         // Check if result is valid (not empty)
         if (!result.empty())
@@ -507,6 +506,15 @@ std::string OllamaClient::RunWithRetry(const std::string& modelName,
                 if (trimmed[0] == '[' || trimmed[0] == '{')
                 {
                     std::cout << "[OllamaClient] Successfully received response on attempt " << attempt << "\n";
+                    if (outStats)
+                    {
+                        *outStats = attemptStats;
+                        outStats->attempts = attempt;
+                    }
+                    if (context)
+                    {
+                        *context = std::move(attemptContext);
+                    }
                     return result;
                 }
                 else
@@ -0,0 +1,114 @@
+/**
+ * @file OllamaRequestBody.cpp
+ * @brief Implementation of the streamed Ollama request body
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Clients/OllamaRequestBody.h"
+#include "Utils/JsonStringCodec.h"
+#include <cstring>
+
+namespace
+{
+    /** @brief Size of the staging buffer for escapes and short runs */
+    const size_t kStagingSize = 16 * 1024;
+
+    /** @brief Plain runs at least this long are handed to the sink without staging */
+    const size_t kDirectRunSize = 2 * 1024;
+}
+
+OllamaRequestBody::OllamaRequestBody(const std::string& modelName, const std::string& prompt,
+                                     const std::vector<int>* context)
+    : m_prompt(prompt)
+{
+    m_head = "{\"model\":\"";
+    JsonStringCodec::AppendEscaped(m_head, modelName.data(), modelName.size());
+    m_head += "\",\"prompt\":\"";
+
+    m_tail = "\",\"stream\":false";
+    // Previous exchange as token IDs: the server continues from it without re-prefilling
+    if (context && !context->empty())
+    {
+        m_tail.reserve(m_tail.size() + context->size() * 7 + 16);
+        m_tail += ",\"context\":[";
+        for (size_t i = 0; i < context->size(); ++i)
+        {
+            if (i > 0)
+                m_tail += ',';
+            m_tail += std::to_string((*context)[i]);
+        }
+        m_tail += ']';
+    }
+    m_tail += '}';
+
+    m_length = m_head.size() + JsonStringCodec::EscapedLength(prompt.data(), prompt.size()) + m_tail.size();
+}
+
+bool OllamaRequestBody::WriteTo(const Sink& sink) const
+{
+    char staging[kStagingSize];
+    size_t staged = 0;
+    auto flush = [&]()
+    {
+        const bool ok = staged == 0 || sink(staging, staged);
+        staged = 0;
+        return ok;
+    };
+    auto stage = [&](const char* data, size_t size)
+    {
+        if (staged + size > kStagingSize && !flush())
+            return false;
+        if (size > kStagingSize)
+            return sink(data, size);
+        std::memcpy(staging + staged, data, size);
+        staged += size;
+        return true;
+    };
+
+    if (!stage(m_head.data(), m_head.size()))
+        return false;
+
+    const char* data = m_prompt.data();
+    const size_t size = m_prompt.size();
+    size_t i = 0;
+    while (i < size)
+    {
+        const size_t run = JsonStringCodec::FindEscapeNeeded(data + i, size - i);
+        if (run >= kDirectRunSize)
+        {
+            if (!flush() || !sink(data + i, run))
+                return false;
+        }
+        else if (run > 0 && !stage(data + i, run))
+        {
+            return false;
+        }
+        i += run;
+        if (i == size)
+            break;
+
+        char escape[JsonStringCodec::kMaxEscapeLength];
+        if (!stage(escape, JsonStringCodec::EscapeChar(static_cast<unsigned char>(data[i]), escape)))
+            return false;
+        ++i;
+    }
+
+    // The tail holds the whole context array; stage what fits and pass the rest through
+    if (staged + m_tail.size() <= kStagingSize)
+        return stage(m_tail.data(), m_tail.size()) && flush();
+    return flush() && sink(m_tail.data(), m_tail.size());
+}
+
+std::string OllamaRequestBody::ToString() const
+{
+    std::string out;
+    out.reserve(m_length);
+    WriteTo([&out](const char* data, size_t size)
+    {
+        out.append(data, size);
+        return true;
+    });
+    return out;
+}
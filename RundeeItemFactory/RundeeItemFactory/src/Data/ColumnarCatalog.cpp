@@ -0,0 +1,320 @@
+/**
+ * @file ColumnarCatalog.cpp
+ * @brief Implementation of the columnar item catalog
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Data/ColumnarCatalog.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    /** @brief Largest integer magnitude a double represents exactly (2^53) */
+    const double kMaxExactDouble = 9007199254740992.0;
+
+    /**
+     * @brief Pick the storage for a profile field
+     */
+    ColumnType GetColumnType(const ProfileField& field)
+    {
+        switch (field.type)
+        {
+        case ProfileFieldType::Integer:
+            return ColumnType::Int;
+        case ProfileFieldType::Float:
+            return ColumnType::Float;
+        case ProfileFieldType::Boolean:
+            return ColumnType::Bool;
+        case ProfileFieldType::String:
+            return field.validation.allowedValues.empty() ? ColumnType::String : ColumnType::Enum;
+        default:
+            return ColumnType::Json;
+        }
+    }
+
+    /**
+     * @brief Rebuild an integer with the JSON number type the parser would produce
+     */
+    nlohmann::json IntegerToJson(int64_t v)
+    {
+        if (v >= 0)
+            return nlohmann::json(static_cast<uint64_t>(v));
+        return nlohmann::json(v);
+    }
+}
+
+ColumnarCatalog::ColumnarCatalog(const ItemProfile& profile)
+{
+    for (const auto& field : profile.fields)
+    {
+        if (m_columnIndex.find(field.name) != m_columnIndex.end())
+            continue;
+
+        CatalogColumn column;
+        column.name = field.name;
+        column.type = GetColumnType(field);
+        if (column.type == ColumnType::String)
+        {
+            column.offsets.push_back(0);
+        }
+        else if (column.type == ColumnType::Enum)
+        {
+            for (const auto& value : field.validation.allowedValues)
+            {
+                if (column.dictionaryIndex.emplace(value, static_cast<uint32_t>(column.dictionary.size())).second)
+                    column.dictionary.push_back(value);
+            }
+            column.allowedCount = column.dictionary.size();
+        }
+        m_columnIndex[field.name] = m_columns.size();
+        m_columns.push_back(std::move(column));
+    }
+}
+
+ColumnarCatalog ColumnarCatalog::FromJson(const ItemProfile& profile, const nlohmann::json& items)
+{
+    ColumnarCatalog catalog(profile);
+    if (!items.is_array())
+        return catalog;
+
+    catalog.Reserve(items.size());
+    for (const auto& item : items)
+        catalog.Append(item);
+    return catalog;
+}
+
+void ColumnarCatalog::Reserve(size_t rows)
+{
+    for (auto& column : m_columns)
+    {
+        column.states.reserve(rows);
+        switch (column.type)
+        {
+        case ColumnType::Int:    column.ints.reserve(rows); break;
+        case ColumnType::Float:  column.floats.reserve(rows); break;
+        case ColumnType::Bool:   column.bools.reserve(rows); break;
+        case ColumnType::String: column.offsets.reserve(rows + 1); break;
+        case ColumnType::Enum:   column.codes.reserve(rows); break;
+        case ColumnType::Json:   column.values.reserve(rows); break;
+        }
+    }
+}
+
+bool ColumnarCatalog::Append(const nlohmann::json& item)
+{
+    if (!item.is_object())
+        return false;
+
+    size_t matched = 0;
+    for (auto& column : m_columns)
+    {
+        auto it = item.find(column.name);
+        if (it != item.end())
+        {
+            ++matched;
+            AppendCell(column, &(*it));
+        }
+        else
+        {
+            AppendCell(column, nullptr);
+        }
+    }
+
+    // Keep fields the profile does not know about so ToJson is loss-free
+    if (item.size() > matched)
+    {
+        nlohmann::json extras = nlohmann::json::object();
+        for (auto it = item.begin(); it != item.end(); ++it)
+        {
+            if (m_columnIndex.find(it.key()) == m_columnIndex.end())
+                extras[it.key()] = it.value();
+        }
+        m_extras[m_rowCount] = std::move(extras);
+    }
+
+    ++m_rowCount;
+    return true;
+}
+
+void ColumnarCatalog::AppendPlaceholder(CatalogColumn& column)
+{
+    switch (column.type)
+    {
+    case ColumnType::Int:    column.ints.push_back(0); break;
+    case ColumnType::Float:  column.floats.push_back(0.0); break;
+    case ColumnType::Bool:   column.bools.push_back(0); break;
+    case ColumnType::String: column.offsets.push_back(column.blob.size()); break;
+    case ColumnType::Enum:   column.codes.push_back(0); break;
+    case ColumnType::Json:   column.values.emplace_back(); break;
+    }
+}
+
+void ColumnarCatalog::AppendCell(CatalogColumn& column, const nlohmann::json* value)
+{
+    if (!value)
+    {
+        column.states.push_back(CellState::Missing);
+        AppendPlaceholder(column);
+        return;
+    }
+
+    bool stored = false;
+    CellState state = CellState::Value;
+    switch (column.type)
+    {
+    case ColumnType::Int:
+        if (value->is_number_integer() &&
+            (!value->is_number_unsigned() || value->get<uint64_t>() <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())))
+        {
+            column.ints.push_back(value->get<int64_t>());
+            stored = true;
+        }
+        break;
+    case ColumnType::Float:
+        if (value->is_number_float())
+        {
+            column.floats.push_back(value->get<double>());
+            stored = true;
+        }
+        else if (value->is_number_integer())
+        {
+            // Integers are common in float fields ("weight": 400); keep them typed if exact
+            const double d = value->is_number_unsigned()
+                ? static_cast<double>(value->get<uint64_t>())
+                : static_cast<double>(value->get<int64_t>());
+            if (std::fabs(d) <= kMaxExactDouble)
+            {
+                column.floats.push_back(d);
+                state = CellState::Integral;
+                stored = true;
+            }
+        }
+        break;
+    case ColumnType::Bool:
+        if (value->is_boolean())
+        {
+            column.bools.push_back(value->get<bool>() ? 1 : 0);
+            stored = true;
+        }
+        break;
+    case ColumnType::String:
+        if (value->is_string())
+        {
+            column.blob += value->get_ref<const std::string&>();
+            column.offsets.push_back(column.blob.size());
+            stored = true;
+        }
+        break;
+    case ColumnType::Enum:
+        if (value->is_string())
+        {
+            const std::string& s = value->get_ref<const std::string&>();
+            auto it = column.dictionaryIndex.find(s);
+            if (it == column.dictionaryIndex.end())
+            {
+                it = column.dictionaryIndex.emplace(s, static_cast<uint32_t>(column.dictionary.size())).first;
+                column.dictionary.push_back(s);
+            }
+            column.codes.push_back(it->second);
+            stored = true;
+        }
+        break;
+    case ColumnType::Json:
+        if (!value->is_null())
+        {
+            column.values.push_back(*value);
+            stored = true;
+        }
+        break;
+    }
+
+    if (stored)
+    {
+        column.states.push_back(state);
+        return;
+    }
+
+    // Wrong type (or null): keep the original value aside
+    column.states.push_back(CellState::Fallback);
+    AppendPlaceholder(column);
+    column.fallback[column.states.size() - 1] = *value;
+}
+
+bool ColumnarCatalog::GetCell(const CatalogColumn& column, size_t row, nlohmann::json& outValue)
+{
+    switch (column.states[row])
+    {
+    case CellState::Missing:
+        return false;
+    case CellState::Fallback:
+        outValue = column.fallback.at(row);
+        return true;
+    case CellState::Integral:
+    {
+        const double d = column.floats[row];
+        outValue = d < 0.0 ? nlohmann::json(static_cast<int64_t>(d)) : nlohmann::json(static_cast<uint64_t>(d));
+        return true;
+    }
+    case CellState::Value:
+        break;
+    }
+
+    switch (column.type)
+    {
+    case ColumnType::Int:
+        outValue = IntegerToJson(column.ints[row]);
+        break;
+    case ColumnType::Float:
+        outValue = column.floats[row];
+        break;
+    case ColumnType::Bool:
+        outValue = column.bools[row] != 0;
+        break;
+    case ColumnType::String:
+    {
+        auto view = column.GetString(row);
+        outValue = std::string(view.first, view.second);
+        break;
+    }
+    case ColumnType::Enum:
+        outValue = column.dictionary[column.codes[row]];
+        break;
+    case ColumnType::Json:
+        outValue = column.values[row];
+        break;
+    }
+    return true;
+}
+
+nlohmann::json ColumnarCatalog::GetItem(size_t row) const
+{
+    nlohmann::json item = nlohmann::json::object();
+    auto extras = m_extras.find(row);
+    if (extras != m_extras.end())
+        item = extras->second;
+
+    for (const auto& column : m_columns)
+    {
+        nlohmann::json value;
+        if (GetCell(column, row, value))
+            item[column.name] = std::move(value);
+    }
+    return item;
+}
+
+nlohmann::json ColumnarCatalog::ToJson() const
+{
+    nlohmann::json items = nlohmann::json::array();
+    for (size_t row = 0; row < m_rowCount; ++row)
+        items.push_back(GetItem(row));
+    return items;
+}
+
+const CatalogColumn* ColumnarCatalog::FindColumn(const std::string& name) const
+{
+    auto it = m_columnIndex.find(name);
+    return it != m_columnIndex.end() ? &m_columns[it->second] : nullptr;
+}
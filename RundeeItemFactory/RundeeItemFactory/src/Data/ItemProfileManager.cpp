@@ -7,6 +7,7 @@
  */
 
 #include "Data/ItemProfileManager.h"
+#include "Parsers/IdShortener.h"
 #include <fstream>
 #include <filesystem>
 #include <iostream>
@@ -14,6 +15,8 @@
 #include <sstream>
 #include <set>
 #include <climits>
+#include <cmath>
+#include <stdexcept>
 #include <json.hpp>
 
 std::string ItemProfileManager::s_profilesDir;
@@ -43,6 +46,13 @@ ItemProfile ItemProfileManager::LoadProfile(const std::string& profileId)
     return LoadProfileFromPath(filePath);
 }
 
+ItemProfile ItemProfileManager::LoadProfile(const std::string& profileId, const std::string& profilesDir)
+{
+    std::filesystem::path profilePath(profilesDir);
+    profilePath /= (profileId + ".json");
+    return LoadProfileFromPath(profilePath.string());
+}
+
 ItemProfile ItemProfileManager::LoadProfileFromPath(const std::string& filePath)
 {
     ItemProfile profile;
@@ -484,6 +494,63 @@ ItemProfile ItemProfileManager::ParseProfileFromJson(const nlohmann::json& json)
         profile.isDefault = json["isDefault"];
     if (json.contains("customContext") && json["customContext"].is_string())
         profile.customContext = json["customContext"];
+    if (json.contains("bannedTerms") && json["bannedTerms"].is_array())
+    {
+        for (const auto& term : json["bannedTerms"])
+        {
+            if (term.is_string())
+                profile.bannedTerms.push_back(term.get<std::string>());
+        }
+    }
+    if (json.contains("quotas") && json["quotas"].is_object())
+    {
+        for (auto fieldIt = json["quotas"].begin(); fieldIt != json["quotas"].end(); ++fieldIt)
+        {
+            if (!fieldIt.value().is_object())
+                continue;
+            // Shares are weights: negative ones or an all-zero field would give negative or NaN targets
+            double shareSum = 0.0;
+            for (auto valueIt = fieldIt.value().begin(); valueIt != fieldIt.value().end(); ++valueIt)
+            {
+                const nlohmann::json& share = valueIt.value();
+                if (!share.is_number() || !std::isfinite(share.get<double>()) || share.get<double>() < 0.0)
+                {
+                    throw std::runtime_error("Quota share " + fieldIt.key() + "." + valueIt.key() +
+                                             " must be a non-negative number");
+                }
+                shareSum += share.get<double>();
+                if (share.get<double>() > 0.0)
+                    profile.quotas[fieldIt.key()][valueIt.key()] = share.get<double>();
+            }
+            if (shareSum <= 0.0)
+                throw std::runtime_error("Quota for " + fieldIt.key() + " needs at least one positive share");
+        }
+    }
+    if (json.contains("idShortening") && json["idShortening"].is_object())
+    {
+        // Keys left out keep the built-in list
+        const auto& rules = json["idShortening"];
+        profile.idShortening = IdShortener::GetDefaultRules();
+        profile.idShortening.isSet = true;
+        if (rules.contains("removeWords") && rules["removeWords"].is_array())
+        {
+            profile.idShortening.removeWords.clear();
+            for (const auto& word : rules["removeWords"])
+            {
+                if (word.is_string())
+                    profile.idShortening.removeWords.push_back(word.get<std::string>());
+            }
+        }
+        if (rules.contains("abbreviations") && rules["abbreviations"].is_object())
+        {
+            profile.idShortening.abbreviations.clear();
+            for (auto it = rules["abbreviations"].begin(); it != rules["abbreviations"].end(); ++it)
+            {
+                if (it.value().is_string())
+                    profile.idShortening.abbreviations[it.key()] = it.value().get<std::string>();
+            }
+        }
+    }
     
     if (json.contains("fields") && json["fields"].is_array())
     {
@@ -513,6 +580,15 @@ nlohmann::json ItemProfileManager::ProfileToJson(const ItemProfile& profile)
     j["isDefault"] = profile.isDefault;
     if (!profile.customContext.empty())
         j["customContext"] = profile.customContext;
+    if (!profile.bannedTerms.empty())
+        j["bannedTerms"] = profile.bannedTerms;
+    if (!profile.quotas.empty())
+        j["quotas"] = profile.quotas;
+    if (profile.idShortening.isSet)
+    {
+        j["idShortening"]["removeWords"] = profile.idShortening.removeWords;
+        j["idShortening"]["abbreviations"] = profile.idShortening.abbreviations;
+    }
     
     j["fields"] = nlohmann::json::array();
     for (const auto& field : profile.fields)
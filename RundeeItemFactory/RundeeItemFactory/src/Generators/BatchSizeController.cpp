@@ -0,0 +1,395 @@
+/**
+ * @file BatchSizeController.cpp
+ * @brief Implementation of the adaptive batch size controller
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/BatchSizeController.h"
+#include "Utils/FileUtils.h"
+#include <json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    /** @brief Batch sizes the controller moves between (roughly geometric) */
+    const std::vector<int> kSizeLadder = { 1, 2, 3, 4, 5, 6, 8, 10, 12, 15, 20, 25, 30, 40, 50 };
+
+    /** @brief Ladder index used before anything was learned (10 items) */
+    const int kDefaultSizeIndex = 7;
+
+    /** @brief Weight of the newest sample in the moving averages */
+    const double kSmoothing = 0.3;
+
+    /** @brief Samples needed at a size before comparing it with its neighbours */
+    const int kMinSamples = 2;
+
+    /** @brief Re-probe a neighbour after this many samples at one size (conditions drift) */
+    const int kReprobeInterval = 8;
+
+    /** @brief A neighbour must beat the current size by this factor to move there */
+    const double kImprovementFactor = 1.05;
+
+    /** @brief Yield assumed before a pair has been measured */
+    const double kPriorYield = 0.85;
+
+    /** @brief Lower bound on predicted yield (caps over-generation at 2x) */
+    const double kMinYield = 0.5;
+
+    /** @brief Learned state file (next to the ID registries) */
+    const std::string kStateFile = "Registry/batch_tuning.json";
+
+    /**
+     * @struct SizeStats
+     * @brief Measurements for one ladder size
+     */
+    struct SizeStats
+    {
+        int samples = 0;
+        double itemsPerGpuSecond = 0.0;
+        double parseSuccessRate = 1.0;
+    };
+
+    /**
+     * @struct TuningState
+     * @brief Learned state for one (model, profile)
+     */
+    struct TuningState
+    {
+        int sizeIndex = kDefaultSizeIndex;
+        int batches = 0;
+        int parsedBatches = 0;
+        double parseSuccessRate = 1.0;
+        double duplicateRate = 0.0;
+        double acceptanceRate = 1.0;
+        double secondsPerBatch = 0.0;
+        double tokensPerItem = 0.0;
+        std::map<int, SizeStats> bySize; ///< Keyed by ladder index
+    };
+
+    std::mutex g_tuningMutex;
+    bool g_loaded = false;
+    std::map<std::string, TuningState> g_states;
+    uint64_t g_revision = 0;                     ///< Bumped by every recorded batch (under g_tuningMutex)
+
+    std::mutex g_saveMutex;                      ///< Orders file writes; never held together with g_tuningMutex
+    std::atomic<uint64_t> g_savedRevision{ 0 };  ///< Revision the file holds
+
+    std::string MakeKey(const std::string& modelName, const std::string& profileId)
+    {
+        return modelName + "|" + profileId;
+    }
+
+    /**
+     * @brief Exponential moving average update (first sample is taken as is)
+     */
+    void Smooth(double& average, double sample, bool first)
+    {
+        average = first ? sample : (average + kSmoothing * (sample - average));
+    }
+
+    /**
+     * @brief Ladder index of the largest size not above the given count
+     */
+    int LadderIndexFor(int requested)
+    {
+        int index = 0;
+        for (int i = 0; i < static_cast<int>(kSizeLadder.size()); ++i)
+        {
+            if (kSizeLadder[i] <= requested)
+                index = i;
+        }
+        return index;
+    }
+
+    void LoadStatesLocked()
+    {
+        if (g_loaded)
+            return;
+        g_loaded = true;
+
+        std::string text;
+        if (!FileUtils::ReadFile(kStateFile, text))
+            return;
+
+        try
+        {
+            nlohmann::json root = nlohmann::json::parse(text);
+            for (auto it = root.begin(); it != root.end(); ++it)
+            {
+                const nlohmann::json& j = it.value();
+                TuningState state;
+                int batchSize = j.value("batchSize", kSizeLadder[kDefaultSizeIndex]);
+                state.sizeIndex = LadderIndexFor(batchSize);
+                state.batches = j.value("batches", 0);
+                state.parsedBatches = j.value("parsedBatches", 0);
+                state.parseSuccessRate = j.value("parseSuccessRate", 1.0);
+                state.duplicateRate = j.value("duplicateRate", 0.0);
+                state.acceptanceRate = j.value("acceptanceRate", 1.0);
+                state.secondsPerBatch = j.value("secondsPerBatch", 0.0);
+                state.tokensPerItem = j.value("tokensPerItem", 0.0);
+                if (j.contains("sizes") && j["sizes"].is_object())
+                {
+                    for (auto sizeIt = j["sizes"].begin(); sizeIt != j["sizes"].end(); ++sizeIt)
+                    {
+                        SizeStats stats;
+                        stats.samples = sizeIt.value().value("samples", 0);
+                        stats.itemsPerGpuSecond = sizeIt.value().value("itemsPerGpuSecond", 0.0);
+                        stats.parseSuccessRate = sizeIt.value().value("parseSuccessRate", 1.0);
+                        state.bySize[LadderIndexFor(std::atoi(sizeIt.key().c_str()))] = stats;
+                    }
+                }
+                g_states[it.key()] = state;
+            }
+            std::cout << "[BatchTuner] Loaded tuning for " << g_states.size() << " model/profile pair(s)\n";
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[BatchTuner] Ignoring unreadable " << kStateFile << ": " << e.what() << "\n";
+            g_states.clear();
+        }
+    }
+
+    /**
+     * @brief Serialize every pair's state (caller holds g_tuningMutex)
+     */
+    std::string DumpStatesLocked()
+    {
+        nlohmann::json root = nlohmann::json::object();
+        for (const auto& kv : g_states)
+        {
+            const TuningState& state = kv.second;
+            nlohmann::json j;
+            j["batchSize"] = kSizeLadder[state.sizeIndex];
+            j["batches"] = state.batches;
+            j["parsedBatches"] = state.parsedBatches;
+            j["parseSuccessRate"] = state.parseSuccessRate;
+            j["duplicateRate"] = state.duplicateRate;
+            j["acceptanceRate"] = state.acceptanceRate;
+            j["secondsPerBatch"] = state.secondsPerBatch;
+            j["tokensPerItem"] = state.tokensPerItem;
+            nlohmann::json sizes = nlohmann::json::object();
+            for (const auto& sizeKv : state.bySize)
+            {
+                sizes[std::to_string(kSizeLadder[sizeKv.first])] = {
+                    {"samples", sizeKv.second.samples},
+                    {"itemsPerGpuSecond", sizeKv.second.itemsPerGpuSecond},
+                    {"parseSuccessRate", sizeKv.second.parseSuccessRate}
+                };
+            }
+            j["sizes"] = sizes;
+            root[kv.first] = j;
+        }
+        return root.dump(2);
+    }
+
+    /**
+     * @brief Write a snapshot taken at the given revision unless a newer one is already on disk
+     */
+    void SaveStates(const std::string& text, uint64_t revision)
+    {
+        std::lock_guard<std::mutex> lock(g_saveMutex);
+        if (revision <= g_savedRevision)
+            return;
+        if (FileUtils::WriteFileAtomic(kStateFile, text))
+            g_savedRevision = revision;
+    }
+
+    /**
+     * @brief Pick the next ladder index after a batch at the current size
+     *
+     * - Mostly failing to parse (truncation): step down
+     * - A measured neighbour is clearly better: move there
+     * - Otherwise probe an unmeasured (or stale) neighbour, upwards while
+     *   responses still parse reliably, downwards otherwise
+     */
+    int NextSizeIndex(const TuningState& state)
+    {
+        const int current = state.sizeIndex;
+        const int lowest = 0;
+        const int highest = static_cast<int>(kSizeLadder.size()) - 1;
+
+        auto statsAt = [&state](int index) -> SizeStats
+        {
+            auto it = state.bySize.find(index);
+            return it != state.bySize.end() ? it->second : SizeStats();
+        };
+
+        const SizeStats cur = statsAt(current);
+        if (cur.samples > 0 && cur.parseSuccessRate < 0.5 && current > lowest)
+            return current - 1;
+        if (cur.samples < kMinSamples)
+            return current;
+
+        int best = current;
+        double bestThroughput = cur.itemsPerGpuSecond;
+        for (int neighbour : { current - 1, current + 1 })
+        {
+            if (neighbour < lowest || neighbour > highest)
+                continue;
+            SizeStats n = statsAt(neighbour);
+            if (n.samples > 0 && n.itemsPerGpuSecond > bestThroughput * kImprovementFactor)
+            {
+                best = neighbour;
+                bestThroughput = n.itemsPerGpuSecond;
+            }
+        }
+        if (best != current)
+            return best;
+
+        const int up = current < highest ? current + 1 : current;
+        const int down = current > lowest ? current - 1 : current;
+        const int preferred = cur.parseSuccessRate >= 0.9 ? up : down;
+        const int other = preferred == up ? down : up;
+        if (preferred != current && statsAt(preferred).samples == 0)
+            return preferred;
+        if (other != current && statsAt(other).samples == 0)
+            return other;
+        if (cur.samples % kReprobeInterval == 0 && preferred != current)
+            return preferred;
+        return current;
+    }
+}
+
+int BatchSizeController::RecommendBatchSize(const std::string& modelName, const std::string& profileId, int remaining)
+{
+    if (remaining <= 1)
+        return 1;
+
+    std::lock_guard<std::mutex> lock(g_tuningMutex);
+    LoadStatesLocked();
+    const TuningState& state = g_states[MakeKey(modelName, profileId)];
+    return std::min(remaining, kSizeLadder[state.sizeIndex]);
+}
+
+double BatchSizeController::PredictYield(const std::string& modelName, const std::string& profileId)
+{
+    std::lock_guard<std::mutex> lock(g_tuningMutex);
+    LoadStatesLocked();
+    auto it = g_states.find(MakeKey(modelName, profileId));
+    if (it == g_states.end() || it->second.batches == 0)
+        return kPriorYield;
+
+    // acceptanceRate already folds in parse failures (0 usable), validation drops, guardrail rejections,
+    // duplicates and quota drops
+    return std::max(kMinYield, std::min(1.0, it->second.acceptanceRate));
+}
+
+void BatchSizeController::RecordBatch(const std::string& modelName, const std::string& profileId, const BatchOutcome& outcome)
+{
+    if (outcome.requested <= 0)
+        return;
+
+    std::string snapshot;
+    uint64_t revision = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_tuningMutex);
+        LoadStatesLocked();
+        TuningState& state = g_states[MakeKey(modelName, profileId)];
+        ++g_revision;
+
+        // GPU time: server-side prefill + decode when reported, client wall time otherwise
+        double gpuSeconds = outcome.stats.hasServerStats
+            ? (outcome.stats.promptEvalDurationNs + outcome.stats.evalDurationNs) / 1e9
+            : outcome.stats.wallSeconds;
+        gpuSeconds = std::max(gpuSeconds, 1e-3);
+
+        const int usable = outcome.parsed ? std::max(0, outcome.parsedItems - outcome.duplicates - outcome.rejected - outcome.quotaDropped) : 0;
+        const bool first = state.batches == 0;
+        Smooth(state.parseSuccessRate, outcome.parsed ? 1.0 : 0.0, first);
+        Smooth(state.acceptanceRate, std::min(1.0, static_cast<double>(usable) / outcome.requested), first);
+        Smooth(state.secondsPerBatch, gpuSeconds, first);
+        if (outcome.parsed && outcome.parsedItems > 0)
+        {
+            const bool firstParsed = state.parsedBatches == 0;
+            Smooth(state.duplicateRate, static_cast<double>(outcome.duplicates) / outcome.parsedItems, firstParsed);
+            if (outcome.stats.hasServerStats)
+            {
+                Smooth(state.tokensPerItem, static_cast<double>(outcome.stats.evalCount) / outcome.parsedItems,
+                       firstParsed || state.tokensPerItem == 0.0);
+            }
+            ++state.parsedBatches;
+        }
+        ++state.batches;
+
+        const int sizeIndex = LadderIndexFor(outcome.requested);
+        SizeStats& sizeStats = state.bySize[sizeIndex];
+        const bool firstAtSize = sizeStats.samples == 0;
+        Smooth(sizeStats.itemsPerGpuSecond, usable / gpuSeconds, firstAtSize);
+        Smooth(sizeStats.parseSuccessRate, outcome.parsed ? 1.0 : 0.0, firstAtSize);
+        ++sizeStats.samples;
+
+        // Only steer when the batch used the tuned size (the last batch of a run is often clamped)
+        if (sizeIndex == state.sizeIndex)
+        {
+            const int next = NextSizeIndex(state);
+            if (next != state.sizeIndex)
+            {
+                std::cout << "[BatchTuner] " << modelName << "/" << profileId << ": batch size "
+                          << kSizeLadder[state.sizeIndex] << " -> " << kSizeLadder[next]
+                          << std::fixed << std::setprecision(2)
+                          << " (" << sizeStats.itemsPerGpuSecond << " items/GPU-s at current size)\n";
+                state.sizeIndex = next;
+                // A new size is worth keeping right away; the smoothed rates wait for Save()
+                snapshot = DumpStatesLocked();
+                revision = g_revision;
+            }
+        }
+    }
+
+    // Written after the lock is released so other jobs' batches do not wait on the disk
+    if (revision > 0)
+        SaveStates(snapshot, revision);
+}
+
+void BatchSizeController::Save()
+{
+    std::string snapshot;
+    uint64_t revision = 0;
+    {
+        std::lock_guard<std::mutex> lock(g_tuningMutex);
+        if (g_revision <= g_savedRevision)
+            return;
+        snapshot = DumpStatesLocked();
+        revision = g_revision;
+    }
+    SaveStates(snapshot, revision);
+}
+
+BatchTuningSnapshot BatchSizeController::GetSnapshot(const std::string& modelName, const std::string& profileId)
+{
+    std::lock_guard<std::mutex> lock(g_tuningMutex);
+    LoadStatesLocked();
+
+    BatchTuningSnapshot snapshot;
+    auto it = g_states.find(MakeKey(modelName, profileId));
+    if (it == g_states.end())
+    {
+        snapshot.batchSize = kSizeLadder[kDefaultSizeIndex];
+        return snapshot;
+    }
+
+    const TuningState& state = it->second;
+    snapshot.batchSize = kSizeLadder[state.sizeIndex];
+    snapshot.batches = state.batches;
+    snapshot.parseSuccessRate = state.parseSuccessRate;
+    snapshot.duplicateRate = state.duplicateRate;
+    snapshot.acceptanceRate = state.acceptanceRate;
+    snapshot.secondsPerBatch = state.secondsPerBatch;
+    snapshot.tokensPerItem = state.tokensPerItem;
+    auto sizeIt = state.bySize.find(state.sizeIndex);
+    if (sizeIt != state.bySize.end())
+    {
+        snapshot.itemsPerGpuSecond = sizeIt->second.itemsPerGpuSecond;
+    }
+    return snapshot;
+}
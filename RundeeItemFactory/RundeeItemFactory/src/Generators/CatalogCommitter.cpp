@@ -0,0 +1,318 @@
+/**
+ * @file CatalogCommitter.cpp
+ * @brief Implementation of the background catalog committer
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/CatalogCommitter.h"
+#include "Generators/GenerationCache.h"
+#include "Helpers/AppConfig.h"
+#include "Utils/FileUtils.h"
+#include "Writers/BinaryCatalogWriter.h"
+#include "Writers/DynamicItemJsonWriter.h"
+#include "Writers/ShardedCatalogWriter.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+
+namespace
+{
+    struct PendingCommit
+    {
+        CatalogCommitRequest request;
+        std::promise<CatalogCommitResult> promise;
+    };
+
+    /** @brief Requests that share an output catalog */
+    struct CatalogGroup
+    {
+        std::vector<nlohmann::json> items;
+        std::vector<size_t> members;         ///< Indices into the commit's request list
+    };
+
+    using CatalogKey = std::tuple<std::string, bool, bool, int>;
+
+    std::set<std::string> CollectIds(const std::vector<nlohmann::json>& items)
+    {
+        std::set<std::string> ids;
+        for (const auto& item : items)
+        {
+            if (item.is_object() && item.contains("id") && item["id"].is_string())
+                ids.insert(item["id"].get<std::string>());
+        }
+        return ids;
+    }
+
+    /**
+     * @brief Merge one catalog's items into its JSON and/or binary files (or their shards)
+     * @param key Destination
+     * @param items The group's items (consumed by the writers)
+     */
+    bool WriteCatalog(const CatalogKey& key, std::vector<nlohmann::json>&& items)
+    {
+        const std::string& outputPath = std::get<0>(key);
+        const bool writeJson = std::get<1>(key);
+        const bool writeBinary = std::get<2>(key);
+        const int shardCount = std::get<3>(key);
+
+        auto writeOne = [&](std::vector<nlohmann::json>&& fileItems, const std::string& path)
+        {
+            std::set<std::string> ids = writeJson ? CollectIds(fileItems) : std::set<std::string>();
+            if (writeJson && writeBinary)
+            {
+                // Both formats are finished before either replaces its file, so a failed
+                // write leaves the old pair in place instead of one format ahead of the other
+                FileUtils::AtomicFileWriter jsonFile;
+                FileUtils::AtomicFileWriter binaryFile;
+                std::vector<nlohmann::json> jsonItems = fileItems;
+                if (!DynamicItemJsonWriter::WriteItemsToFile(std::move(jsonItems), path, true, &jsonFile) ||
+                    !BinaryCatalogWriter::WriteItemsToFile(std::move(fileItems), BinaryCatalogWriter::GetBinaryPath(path), true, &binaryFile) ||
+                    !jsonFile.Commit())
+                {
+                    return false;
+                }
+                GenerationCache::RecordWrittenIds(path, ids);
+                return binaryFile.Commit();
+            }
+            if (writeJson)
+            {
+                if (!DynamicItemJsonWriter::WriteItemsToFile(std::move(fileItems), path, true))
+                    return false;
+                GenerationCache::RecordWrittenIds(path, ids);
+                return true;
+            }
+            return BinaryCatalogWriter::WriteItemsToFile(std::move(fileItems), BinaryCatalogWriter::GetBinaryPath(path), true);
+        };
+
+        if (shardCount > 1)
+            return ShardedCatalogWriter::WriteItems(std::move(items), outputPath, shardCount, writeOne);
+        return writeOne(std::move(items), outputPath);
+    }
+
+    /**
+     * @class Committer
+     * @brief Queue plus the thread that drains it
+     */
+    class Committer
+    {
+    public:
+        ~Committer()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            if (m_thread.joinable())
+                m_thread.join();
+        }
+
+        std::future<CatalogCommitResult> Submit(CatalogCommitRequest request)
+        {
+            PendingCommit pending;
+            pending.request = std::move(request);
+            std::future<CatalogCommitResult> future = pending.promise.get_future();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_thread.joinable())
+                    m_thread = std::thread(&Committer::Run, this);
+                m_queuedItems += pending.request.items.size();
+                m_queue.push_back(std::move(pending));
+            }
+            m_wake.notify_all();
+            return future;
+        }
+
+        void AddProducer(int delta)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_activeProducers += delta;
+            }
+            m_wake.notify_all(); // A finished job may be the one the group window waits for
+        }
+
+        void Flush()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_idle.wait(lock, [this]() { return m_queue.empty() && !m_committing; });
+        }
+
+    private:
+        void Run()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for (;;)
+            {
+                m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+                if (m_queue.empty())
+                    return; // Stopping with nothing left to commit
+
+                // Group window: only worth waiting while another running job has yet to submit;
+                // a single job, or a full queue, is committed at once
+                const CommitSettings& settings = AppConfig::GetCommitSettings();
+                const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(settings.intervalMs);
+                m_wake.wait_until(lock, deadline, [this, &settings]()
+                {
+                    return m_stopping ||
+                        static_cast<int>(m_queue.size()) >= m_activeProducers ||
+                        m_queuedItems >= static_cast<size_t>(settings.maxItems);
+                });
+
+                std::vector<PendingCommit> batch;
+                batch.reserve(m_queue.size());
+                for (auto& pending : m_queue)
+                    batch.push_back(std::move(pending));
+                m_queue.clear();
+                m_queuedItems = 0;
+                m_committing = true;
+
+                lock.unlock();
+                try
+                {
+                    Commit(batch);
+                }
+                catch (...)
+                {
+                    // Anything outside the per-catalog write (grouping, registry merge) fails the
+                    // whole batch; the committer thread keeps running for later requests
+                    const std::exception_ptr error = std::current_exception();
+                    for (auto& pending : batch)
+                    {
+                        try
+                        {
+                            pending.promise.set_exception(error);
+                        }
+                        catch (const std::future_error&)
+                        {
+                            // Already resolved before the failure
+                        }
+                    }
+                }
+                lock.lock();
+
+                m_committing = false;
+                if (m_queue.empty())
+                    m_idle.notify_all();
+            }
+        }
+
+        void Commit(std::vector<PendingCommit>& batch)
+        {
+            std::vector<CatalogCommitResult> results(batch.size());
+            for (auto& result : results)
+                result.groupedRequests = batch.size();
+
+            // One merge per output catalog
+            std::map<CatalogKey, CatalogGroup> groups;
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                CatalogCommitRequest& request = batch[i].request;
+                CatalogGroup& group = groups[CatalogKey(request.outputPath, request.writeJson, request.writeBinary, request.shardCount)];
+                group.members.push_back(i);
+                for (auto& item : request.items)
+                    group.items.push_back(std::move(item));
+            }
+
+            std::map<std::string, std::set<std::string>> registryIds;
+            std::map<std::string, std::vector<size_t>> registryMembers;
+            for (auto& entry : groups)
+            {
+                const std::set<std::string> ids = CollectIds(entry.second.items);
+                bool ok = false;
+                try
+                {
+                    ok = WriteCatalog(entry.first, std::move(entry.second.items));
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "[CatalogCommitter] Commit failed: " << e.what() << "\n";
+                }
+
+                for (size_t member : entry.second.members)
+                {
+                    results[member].success = ok;
+                    if (!ok)
+                    {
+                        results[member].error = "Failed to write items to " + std::get<0>(entry.first);
+                        continue;
+                    }
+                    const std::string& typeName = batch[member].request.typeNameLower;
+                    if (!typeName.empty())
+                    {
+                        registryIds[typeName].insert(ids.begin(), ids.end());
+                        registryMembers[typeName].push_back(member);
+                    }
+                }
+            }
+
+            // One registry save per type
+            for (const auto& entry : registryIds)
+            {
+                size_t before = 0;
+                size_t after = 0;
+                if (!GenerationCache::MergeRegistryIds(entry.first, entry.second, before, after))
+                    std::cerr << "[CatalogCommitter] Failed to save registry for type: " << entry.first << "\n";
+                for (size_t member : registryMembers[entry.first])
+                {
+                    results[member].registryBefore = before;
+                    results[member].registryAfter = after;
+                }
+            }
+
+            if (batch.size() > 1)
+            {
+                std::cout << "[CatalogCommitter] Group commit: " << batch.size() << " requests, "
+                          << groups.size() << " catalog(s), " << registryIds.size() << " registr"
+                          << (registryIds.size() == 1 ? "y" : "ies") << "\n";
+            }
+            for (size_t i = 0; i < batch.size(); ++i)
+                batch[i].promise.set_value(results[i]);
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_idle;
+        std::deque<PendingCommit> m_queue;
+        size_t m_queuedItems = 0;
+        int m_activeProducers = 0;           ///< Jobs inside a ProducerScope (submitted or not)
+        bool m_committing = false;
+        bool m_stopping = false;
+        std::thread m_thread;
+    };
+
+    Committer& GetCommitter()
+    {
+        static Committer committer;
+        return committer;
+    }
+}
+
+std::future<CatalogCommitResult> CatalogCommitter::Submit(CatalogCommitRequest request)
+{
+    return GetCommitter().Submit(std::move(request));
+}
+
+void CatalogCommitter::Flush()
+{
+    GetCommitter().Flush();
+}
+
+CatalogCommitter::ProducerScope::ProducerScope()
+{
+    GetCommitter().AddProducer(1);
+}
+
+CatalogCommitter::ProducerScope::~ProducerScope()
+{
+    GetCommitter().AddProducer(-1);
+}
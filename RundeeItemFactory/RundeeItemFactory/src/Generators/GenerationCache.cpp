@@ -0,0 +1,290 @@
+/**
+ * @file GenerationCache.cpp
+ * @brief Implementation of the process-wide profile and ID cache
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/GenerationCache.h"
+#include "Generators/IdCollisionResolver.h"
+#include "Generators/ItemGeneratorRegistry.h"
+#include "Data/ItemProfileManager.h"
+#include "Data/PlayerProfileManager.h"
+#include "Writers/DynamicItemJsonWriter.h"
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <system_error>
+
+namespace
+{
+    using FileTime = std::filesystem::file_time_type;
+
+    /** @brief Cached value together with the write time of its backing file */
+    template <typename T>
+    struct CachedEntry
+    {
+        T value;
+        bool fileExisted = false;
+        FileTime writeTime{};
+    };
+
+    std::mutex g_cacheMutex;
+    std::map<std::string, CachedEntry<ItemProfile>> g_itemProfiles;        ///< Keyed by profile file path
+    std::map<std::string, CachedEntry<PlayerProfile>> g_playerProfiles;    ///< Keyed by profile file path
+    std::map<std::string, std::string> g_defaultPlayerProfileIds;          ///< Directory -> default profile ID
+    std::map<std::string, CachedEntry<std::set<std::string>>> g_fileIds;
+    std::map<std::string, CachedEntry<std::set<std::string>>> g_registryIds;
+    std::map<std::string, std::weak_ptr<CatalogIdIndex>> g_idIndexes;      ///< Keyed by output path
+
+    /**
+     * @brief Read a file's write time without throwing
+     * @param path File path
+     * @param outTime Output write time
+     * @return True if the file exists and its write time was read
+     */
+    bool TryGetWriteTime(const std::string& path, FileTime& outTime)
+    {
+        std::error_code ec;
+        if (!std::filesystem::exists(path, ec) || ec)
+            return false;
+        outTime = std::filesystem::last_write_time(path, ec);
+        return !ec;
+    }
+
+    /**
+     * @brief Check whether a cached entry still matches its backing file
+     * @param entry Cached entry
+     * @param path Backing file path
+     * @return True if the file's existence and write time are unchanged
+     */
+    template <typename T>
+    bool IsFresh(const CachedEntry<T>& entry, const std::string& path)
+    {
+        FileTime now{};
+        bool exists = TryGetWriteTime(path, now);
+        if (exists != entry.fileExisted)
+            return false;
+        return !exists || now == entry.writeTime;
+    }
+
+    /**
+     * @brief Stamp a cached entry with its backing file's current state
+     */
+    template <typename T>
+    void Stamp(CachedEntry<T>& entry, const std::string& path)
+    {
+        entry.fileExisted = TryGetWriteTime(path, entry.writeTime);
+    }
+
+    std::string ProfilePath(const std::string& profilesDir, const std::string& profileId)
+    {
+        std::filesystem::path p(profilesDir);
+        p /= (profileId + ".json");
+        return p.string();
+    }
+
+    /**
+     * @brief GetPlayerProfile body; g_cacheMutex must be held
+     */
+    PlayerProfile GetPlayerProfileLocked(const std::string& profilesDir, const std::string& profileId)
+    {
+        const std::string path = ProfilePath(profilesDir, profileId);
+        auto it = g_playerProfiles.find(path);
+        if (it != g_playerProfiles.end() && IsFresh(it->second, path))
+        {
+            return it->second.value;
+        }
+
+        CachedEntry<PlayerProfile> entry;
+        entry.value = PlayerProfileManager::LoadProfile(profileId, profilesDir);
+        Stamp(entry, path);
+        if (entry.value.id.empty())
+        {
+            g_playerProfiles.erase(path);
+            return entry.value;
+        }
+        g_playerProfiles[path] = entry;
+        return entry.value;
+    }
+}
+
+bool GenerationCache::PrepareDirectories(const std::string& itemProfilesDir, const std::string& playerProfilesDir)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(playerProfilesDir, ec);
+    ec.clear();
+    std::filesystem::create_directories(itemProfilesDir, ec);
+    return std::filesystem::is_directory(itemProfilesDir, ec);
+}
+
+ItemProfile GenerationCache::GetItemProfile(const std::string& profilesDir, const std::string& profileId)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    const std::string path = ProfilePath(profilesDir, profileId);
+    auto it = g_itemProfiles.find(path);
+    if (it != g_itemProfiles.end() && IsFresh(it->second, path))
+    {
+        return it->second.value;
+    }
+
+    CachedEntry<ItemProfile> entry;
+    entry.value = ItemProfileManager::LoadProfile(profileId, profilesDir);
+    Stamp(entry, path);
+    if (entry.value.id.empty())
+    {
+        g_itemProfiles.erase(path);
+        return entry.value;
+    }
+    g_itemProfiles[path] = entry;
+    return entry.value;
+}
+
+PlayerProfile GenerationCache::GetPlayerProfile(const std::string& profilesDir, const std::string& profileId)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    return GetPlayerProfileLocked(profilesDir, profileId);
+}
+
+PlayerProfile GenerationCache::GetDefaultPlayerProfile(const std::string& profilesDir)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    auto defaultIt = g_defaultPlayerProfileIds.find(profilesDir);
+    if (defaultIt != g_defaultPlayerProfileIds.end())
+    {
+        PlayerProfile cached = GetPlayerProfileLocked(profilesDir, defaultIt->second);
+        if (!cached.id.empty())
+            return cached;
+    }
+
+    PlayerProfile profile = PlayerProfileManager::GetDefaultProfile(profilesDir);
+    if (!profile.id.empty())
+    {
+        g_defaultPlayerProfileIds[profilesDir] = profile.id;
+        CachedEntry<PlayerProfile> entry;
+        entry.value = profile;
+        const std::string path = ProfilePath(profilesDir, profile.id);
+        Stamp(entry, path);
+        g_playerProfiles[path] = entry;
+    }
+    return profile;
+}
+
+std::set<std::string> GenerationCache::GetKnownIds(const std::string& outputPath,
+                                                   const std::string& typeNameLower,
+                                                   size_t* outFileIdCount,
+                                                   size_t* outRegistryIdCount)
+{
+    return GetKnownIds(std::vector<std::string>{ outputPath }, typeNameLower, outFileIdCount, outRegistryIdCount);
+}
+
+std::set<std::string> GenerationCache::GetKnownIds(const std::vector<std::string>& outputPaths,
+                                                   const std::string& typeNameLower,
+                                                   size_t* outFileIdCount,
+                                                   size_t* outRegistryIdCount)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+
+    std::set<std::string> ids;
+    size_t fileIdCount = 0;
+    for (const auto& outputPath : outputPaths)
+    {
+        auto fileIt = g_fileIds.find(outputPath);
+        if (fileIt == g_fileIds.end() || !IsFresh(fileIt->second, outputPath))
+        {
+            CachedEntry<std::set<std::string>> entry;
+            entry.value = DynamicItemJsonWriter::GetExistingIds(outputPath);
+            Stamp(entry, outputPath);
+            fileIt = g_fileIds.insert_or_assign(outputPath, std::move(entry)).first;
+        }
+        fileIdCount += fileIt->second.value.size();
+        if (ids.empty())
+            ids = fileIt->second.value;
+        else
+            ids.insert(fileIt->second.value.begin(), fileIt->second.value.end());
+    }
+
+    const std::string registryPath = ItemGeneratorRegistry::GetRegistryFilePath(typeNameLower);
+    auto regIt = g_registryIds.find(typeNameLower);
+    if (regIt == g_registryIds.end() || !IsFresh(regIt->second, registryPath))
+    {
+        CachedEntry<std::set<std::string>> entry;
+        entry.value = ItemGeneratorRegistry::LoadRegistryIds(typeNameLower);
+        Stamp(entry, registryPath);
+        regIt = g_registryIds.insert_or_assign(typeNameLower, std::move(entry)).first;
+    }
+
+    if (outFileIdCount)
+        *outFileIdCount = fileIdCount;
+    if (outRegistryIdCount)
+        *outRegistryIdCount = regIt->second.value.size();
+
+    ids.insert(regIt->second.value.begin(), regIt->second.value.end());
+    return ids;
+}
+
+void GenerationCache::RecordWrittenIds(const std::string& outputPath, const std::set<std::string>& ids)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    auto it = g_fileIds.find(outputPath);
+    if (it == g_fileIds.end())
+    {
+        // Not cached yet; the next GetKnownIds will read the file
+        return;
+    }
+    it->second.value.insert(ids.begin(), ids.end());
+    Stamp(it->second, outputPath);
+}
+
+bool GenerationCache::MergeRegistryIds(const std::string& typeNameLower,
+                                       const std::set<std::string>& ids,
+                                       size_t& outBefore,
+                                       size_t& outAfter)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    const std::string registryPath = ItemGeneratorRegistry::GetRegistryFilePath(typeNameLower);
+    auto it = g_registryIds.find(typeNameLower);
+    if (it == g_registryIds.end() || !IsFresh(it->second, registryPath))
+    {
+        CachedEntry<std::set<std::string>> entry;
+        entry.value = ItemGeneratorRegistry::LoadRegistryIds(typeNameLower);
+        it = g_registryIds.insert_or_assign(typeNameLower, std::move(entry)).first;
+    }
+
+    std::set<std::string>& registry = it->second.value;
+    outBefore = registry.size();
+    registry.insert(ids.begin(), ids.end());
+    outAfter = registry.size();
+
+    bool saved = ItemGeneratorRegistry::SaveRegistryIds(typeNameLower, registry);
+    Stamp(it->second, registryPath);
+    return saved;
+}
+
+std::shared_ptr<CatalogIdIndex> GenerationCache::AcquireIdIndex(const std::string& outputPath)
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    for (auto it = g_idIndexes.begin(); it != g_idIndexes.end();)
+        it = it->second.expired() ? g_idIndexes.erase(it) : std::next(it);
+
+    std::weak_ptr<CatalogIdIndex>& slot = g_idIndexes[outputPath];
+    std::shared_ptr<CatalogIdIndex> index = slot.lock();
+    if (!index)
+    {
+        // No job is writing this catalog; what earlier jobs wrote is back in GetKnownIds
+        index = std::make_shared<CatalogIdIndex>();
+        slot = index;
+    }
+    return index;
+}
+
+void GenerationCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_itemProfiles.clear();
+    g_playerProfiles.clear();
+    g_defaultPlayerProfileIds.clear();
+    g_fileIds.clear();
+    g_registryIds.clear();
+}
@@ -0,0 +1,229 @@
+/**
+ * @file IdCollisionResolver.cpp
+ * @brief Implementation of deterministic short-ID collision resolution
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/IdCollisionResolver.h"
+#include "Parsers/BinaryCatalogReader.h"
+#include "Parsers/LazyCatalogReader.h"
+#include "Utils/JsonUtils.h"
+#include "Writers/ShardedCatalogWriter.h"
+#include <cctype>
+#include <cstdio>
+#include <iostream>
+
+namespace
+{
+    /** @brief Longest normalized name used in a derived ID (same cap as the short-ID suffix, doubled) */
+    const size_t kMaxDerivedNameLength = 60;
+
+    /** @brief Numbered candidates tried after the hashed one before giving up */
+    const int kMaxNumberedCandidates = 100;
+
+    std::string DisplayNameOf(const nlohmann::json& item)
+    {
+        auto it = item.find("displayName");
+        if (it == item.end() || !it->is_string())
+            return std::string();
+        return it->get<std::string>();
+    }
+
+    /** @brief The ASCII bytes of a normalized name, the only ones allowed in an ID */
+    std::string AsciiPart(const std::string& name)
+    {
+        std::string ascii;
+        for (char c : name)
+        {
+            if (static_cast<unsigned char>(c) < 0x80)
+                ascii += c;
+        }
+        return ascii;
+    }
+}
+
+IdCollisionResolver::IdCollisionResolver(std::set<std::string>& knownIds,
+                                         std::shared_ptr<CatalogIdIndex> sharedIndex,
+                                         const std::string& idPrefix,
+                                         std::vector<std::string> jsonCatalogs,
+                                         std::vector<std::string> binaryCatalogs)
+    : m_knownIds(knownIds)
+    , m_index(sharedIndex ? std::move(sharedIndex) : std::make_shared<CatalogIdIndex>())
+    , m_idPrefix(idPrefix)
+    , m_jsonCatalogs(std::move(jsonCatalogs))
+    , m_binaryCatalogs(std::move(binaryCatalogs))
+{
+    std::lock_guard<std::mutex> lock(m_index->mutex);
+    m_index->ids.insert(m_knownIds.begin(), m_knownIds.end());
+}
+
+IdCollisionResolver::~IdCollisionResolver() = default;
+
+std::string IdCollisionResolver::NormalizeName(const std::string& displayName)
+{
+    std::string normalized;
+    normalized.reserve(displayName.size());
+    for (char c : displayName)
+    {
+        const unsigned char byte = static_cast<unsigned char>(c);
+        if (byte >= 0x80)
+            normalized += c;
+        else if (std::isalnum(byte))
+            normalized += static_cast<char>(std::tolower(byte));
+    }
+    return normalized;
+}
+
+IdCollisionResolver::Outcome IdCollisionResolver::Resolve(nlohmann::json& item, std::string& outCollidedId)
+{
+    std::lock_guard<std::mutex> lock(m_index->mutex);
+    return ResolveLocked(item, outCollidedId);
+}
+
+IdCollisionResolver::Outcome IdCollisionResolver::ResolveLocked(nlohmann::json& item, std::string& outCollidedId)
+{
+    outCollidedId.clear();
+    auto idIt = item.find("id");
+    if (idIt == item.end() || !idIt->is_string())
+        return Outcome::Unique; // Nothing to resolve; the caller skips items without an id
+
+    const std::string shortId = idIt->get<std::string>();
+    if (m_index->ids.find(shortId) == m_index->ids.end())
+        return Outcome::Unique;
+
+    const std::string name = NormalizeName(DisplayNameOf(item));
+    outCollidedId = shortId;
+
+    // Candidates depend only on the name, so the same name always meets its earlier copy
+    std::vector<std::string> candidates{ shortId };
+    std::string fullId = shortId;
+    if (!name.empty())
+    {
+        const std::string idName = AsciiPart(name);
+        if (!idName.empty())
+        {
+            fullId = m_idPrefix + "_" + idName.substr(0, kMaxDerivedNameLength);
+            if (fullId != shortId)
+                candidates.push_back(fullId);
+        }
+
+        char hash[8];
+        std::snprintf(hash, sizeof(hash), "_%04x", static_cast<unsigned>(ShardedCatalogWriter::HashId(name) & 0xFFFF));
+        fullId += hash;
+        candidates.push_back(fullId);
+    }
+
+    for (int n = 0; n <= kMaxNumberedCandidates; ++n)
+    {
+        const std::string candidate = (n < static_cast<int>(candidates.size()))
+            ? candidates[n]
+            : fullId + "_" + std::to_string(n - static_cast<int>(candidates.size()) + 2);
+
+        if (m_index->ids.find(candidate) == m_index->ids.end())
+        {
+            *idIt = candidate;
+            return Outcome::Resolved;
+        }
+        if (!name.empty() && HolderName(candidate) == name)
+            return Outcome::DuplicateName;
+    }
+
+    std::cerr << "[IdCollisionResolver] No free ID for \"" << DisplayNameOf(item) << "\" after "
+              << kMaxNumberedCandidates << " candidates\n";
+    return Outcome::DuplicateName;
+}
+
+bool IdCollisionResolver::Record(nlohmann::json& item, Outcome resolved)
+{
+    auto idIt = item.find("id");
+    if (idIt == item.end() || !idIt->is_string())
+        return false;
+
+    std::lock_guard<std::mutex> lock(m_index->mutex);
+    if (m_index->ids.find(idIt->get_ref<const std::string&>()) != m_index->ids.end())
+    {
+        // Another job writing this catalog claimed the ID after Resolve()
+        std::string collidedId;
+        resolved = ResolveLocked(item, collidedId);
+        if (resolved == Outcome::DuplicateName)
+            return false;
+    }
+    if (resolved == Outcome::Resolved)
+        ++m_resolvedCount;
+
+    const std::string& id = idIt->get_ref<const std::string&>();
+    m_index->ids.insert(id);
+    m_index->names[id] = NormalizeName(DisplayNameOf(item));
+    m_knownIds.insert(id);
+    return true;
+}
+
+std::string IdCollisionResolver::HolderName(const std::string& id)
+{
+    auto& names = m_index->names;
+    auto it = names.find(id);
+    if (it != names.end())
+        return it->second;
+
+    LoadCatalogs();
+    it = names.find(id);
+    if (it != names.end())
+        return it->second;
+
+    // Binary records are looked up by ID through the sorted index
+    std::string name;
+    for (auto& reader : m_binaryReaders)
+    {
+        nlohmann::json stored;
+        if (reader->Find(id, stored))
+        {
+            name = NormalizeName(DisplayNameOf(stored));
+            break;
+        }
+    }
+    names[id] = name; // Unknown holders (registry-only IDs) are remembered as unnamed
+    return name;
+}
+
+void IdCollisionResolver::LoadCatalogs()
+{
+    if (!m_binaryOpened)
+    {
+        m_binaryOpened = true;
+        for (const auto& path : m_binaryCatalogs)
+        {
+            auto reader = std::make_unique<BinaryCatalogReader>();
+            if (reader->Open(path))
+                m_binaryReaders.push_back(std::move(reader));
+        }
+    }
+
+    // JSON catalogs are read once for all jobs sharing the index
+    if (m_index->catalogsLoaded)
+        return;
+    m_index->catalogsLoaded = true;
+
+    size_t loaded = 0;
+    std::string id;
+    std::string displayName;
+    for (const auto& path : m_jsonCatalogs)
+    {
+        LazyCatalogReader reader;
+        if (!reader.Open(path))
+            continue;
+        reader.ForEachItem([&](const char* text, size_t length)
+        {
+            if (JsonUtils::FindTopLevelString(text, length, "id", id) &&
+                JsonUtils::FindTopLevelString(text, length, "displayName", displayName))
+            {
+                m_index->names.emplace(id, NormalizeName(displayName));
+                ++loaded;
+            }
+            return true;
+        });
+    }
+
+    std::cout << "[IdCollisionResolver] Loaded " << loaded << " catalog display names for collision checks\n";
+}
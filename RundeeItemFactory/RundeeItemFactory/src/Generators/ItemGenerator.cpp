@@ -11,7 +11,7 @@
  * 
  * Key Features:
  * - Parallel batch processing for efficient LLM interaction
- * - Thread-safe file I/O using per-file mutexes
+ * - Group commits of each job's items through the background CatalogCommitter
  * - Quality checking and validation for generated items
  * - Registry-based duplicate ID prevention
  * - Support for all item types: Food, Drink, Material, Weapon, WeaponComponent, Ammo, Armor, Clothing
@@ -19,14 +19,26 @@
 
 #include "Generators/ItemGenerator.h"
 #include "Generators/ItemGeneratorRegistry.h"
+#include "Generators/GenerationCache.h"
+#include "Generators/RunCheckpoint.h"
+#include "Generators/BatchSizeController.h"
+#include "Generators/CatalogCommitter.h"
+#include "Generators/ItemGuardrail.h"
+#include "Generators/IdCollisionResolver.h"
+#include "Generators/QuotaScheduler.h"
 #include "Helpers/CommandLineParser.h"
 #include "Parsers/DynamicItemJsonParser.h"
 #include "Writers/DynamicItemJsonWriter.h"
+#include "Writers/BinaryCatalogWriter.h"
+#include "Writers/ShardedCatalogWriter.h"
+#include "Parsers/BinaryCatalogReader.h"
 #include "Prompts/DynamicPromptBuilder.h"
 #include "Clients/OllamaClient.h"
 #include "Data/ItemProfileManager.h"
 #include "Data/PlayerProfileManager.h"
 #include "Helpers/AppConfig.h"
+#include "Helpers/GenerationMetrics.h"
+#include "Utils/AllocationStats.h"
 #include <fstream>
 #include <map>
 #include <json.hpp>
@@ -41,11 +53,13 @@
 #include <map>
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <thread>
 #include <future>
 #include <mutex>
 #include <functional>
 #include <random>
+#include <filesystem>
 #ifdef _WIN32
 #include <direct.h>
 #include <windows.h>
@@ -58,64 +72,12 @@
  */
 namespace
 {
-    /** @brief Banned words that should not appear in generated items */
-    const std::vector<std::string> kBannedWords = { "dummy", "lorem", "ipsum", "placeholder", "test item", "badword" };
-    
-    /** @brief Directory name for ID registry files */
-    const std::string kRegistryDir = "Registry";
-    
-    /** @brief Map of file paths to their corresponding mutexes for thread-safe I/O */
-    static std::map<std::string, std::unique_ptr<std::mutex>> fileMutexes;
-    
-    /** @brief Mutex protecting the fileMutexes map itself */
-    static std::mutex fileMutexesMutex;
-    
-    /**
-     * @brief Get or create a mutex for a specific file path
-     * @param filePath The file path to get a mutex for
-     * @return Reference to the mutex for the given file path
-     * @details Thread-safe: Uses fileMutexesMutex to protect the map access
-     */
-    std::mutex& GetFileMutex(const std::string& filePath)
-    {
-        std::lock_guard<std::mutex> lock(fileMutexesMutex);
-        auto it = fileMutexes.find(filePath);
-        if (it == fileMutexes.end())
-        {
-            fileMutexes[filePath] = std::make_unique<std::mutex>();
-            return *fileMutexes[filePath];
-        }
-        return *it->second;
-    }
-
-    /**
-     * @brief Convert a string to lowercase
-     * @param s Input string
-     * @return Lowercase version of the input string
-     */
-    std::string ToLower(const std::string& s)
-    {
-        std::string out = s;
-        std::transform(out.begin(), out.end(), out.begin(), ::tolower);
-        return out;
-    }
-
     /**
-     * @brief Count occurrences of banned words in text
-     * @param text Text to search
-     * @return Number of banned word hits found
+     * @brief Largest conversation context reused for a follow-up batch
+     * @details Ollama's default num_ctx is 4096 tokens; beyond this the next answer would
+     *          push the original instructions out of the window, so a full prompt is sent instead
      */
-    int CountBanHits(const std::string& text)
-    {
-        int hits = 0;
-        std::string low = ToLower(text);
-        for (const auto& w : kBannedWords)
-        {
-            if (low.find(w) != std::string::npos)
-                ++hits;
-        }
-        return hits;
-    }
+    const size_t kMaxContinuationContextTokens = 3072;
 
     /**
      * @brief Count occurrences of each rarity value
@@ -133,18 +95,25 @@ namespace
     /**
      * @brief Print guardrail summary statistics
      * @param typeName Item type name
-     * @param warnings Number of warnings
-     * @param errors Number of errors
-     * @param banHits Number of banned word hits
+     * @param report Banned-term scan results for the run
+     * @param rejected Number of items dropped because of banned terms
      * @param rarityCounts Map of rarity counts
      * @param total Total number of items
      */
-    void PrintGuardrailSummary(const std::string& typeName, int warnings, int errors, int banHits, const std::map<std::string, int>& rarityCounts, int total)
+    void PrintGuardrailSummary(const std::string& typeName, const GuardrailReport& report, int rejected, const std::map<std::string, int>& rarityCounts, int total)
     {
+        std::ios::fmtflags savedFlags = std::cout.flags();
+        std::streamsize savedPrecision = std::cout.precision();
+        
         std::cout << "[Guardrail] Type=" << typeName
-            << " warnings=" << warnings
-            << " errors=" << errors
-            << " bannedHits=" << banHits;
+            << " scanned=" << report.itemsScanned
+            << " flagged=" << report.itemsWithHits
+            << " rejected=" << rejected
+            << " bannedHits=" << report.totalHits;
+        for (const auto& kv : report.hitsByField)
+        {
+            std::cout << " field[" << kv.first << "]=" << kv.second;
+        }
         if (total > 0)
         {
             for (const auto& kv : rarityCounts)
@@ -154,31 +123,78 @@ namespace
             }
         }
         std::cout << "\n";
+        if (!report.hitsByTerm.empty())
+        {
+            std::cout << "[Guardrail] Terms:";
+            for (const auto& kv : report.hitsByTerm)
+            {
+                std::cout << " \"" << kv.first << "\"=" << kv.second;
+            }
+            std::cout << "\n";
+        }
+        
+        std::cout.flags(savedFlags);
+        std::cout.precision(savedPrecision);
     }
-}
 
-/**
- * @brief Ensure parent directory exists for a given file path
- * @param path File path whose parent directory should be created
- * @details Creates the parent directory if it doesn't exist (cross-platform)
- */
-static void EnsureParentDir(const std::string& path)
-{
-    size_t pos = path.find_last_of("/\\");
-    if (pos != std::string::npos)
+    /**
+     * @brief Report the heap traffic of one batch since a per-thread snapshot
+     * @param modelName Model that produced the batch
+     * @param profileId Item profile of the batch
+     * @param start Snapshot taken before the response was parsed
+     */
+    void RecordBatchAllocations(const std::string& modelName, const std::string& profileId,
+                                const AllocationStats::Snapshot& start)
     {
-        std::string dir = path.substr(0, pos);
-#ifdef _WIN32
-        _mkdir(dir.c_str());
-#else
-        mkdir(dir.c_str(), 0755);
-#endif
+        if (!AllocationStats::kEnabled)
+            return; // Not counted outside the Bench build
+        const AllocationStats::Snapshot end = AllocationStats::GetThread();
+        GenerationMetrics::RecordBatchAllocations(modelName, profileId,
+            static_cast<long long>(end.allocations - start.allocations),
+            static_cast<long long>(end.allocatedBytes - start.allocatedBytes));
+    }
+    /**
+     * @brief Send items that failed validation back to the model in one compact request
+     * @param modelName Model to ask
+     * @param profile Item profile the items belong to
+     * @param invalidItems Failed objects with their errors (trimmed to @p limit)
+     * @param limit Most items sent in one request
+     * @param outItems Returned items that now pass validation
+     * @return Number of repaired items
+     */
+    int RequestRepairs(const std::string& modelName, const ItemProfile& profile,
+                       std::vector<RejectedItem>& invalidItems, int limit,
+                       std::vector<nlohmann::json>& outItems)
+    {
+        outItems.clear();
+        if (static_cast<int>(invalidItems.size()) > limit)
+            invalidItems.resize(static_cast<size_t>(limit));
+        const int sent = static_cast<int>(invalidItems.size());
+
+        const std::string prompt = DynamicPromptBuilder::BuildRepairPrompt(profile, invalidItems);
+        std::cout << "[ItemGenerator] Sending " << sent << " invalid item(s) back for repair ("
+                  << prompt.size() << " chars)\n";
+        OllamaCallStats stats;
+        const std::string response = OllamaClient::RunWithRetry(modelName, prompt, 3, 120, &stats, nullptr);
+        if (response.empty())
+        {
+            std::cerr << "[ItemGenerator] Repair request failed; dropping the invalid items\n";
+            return 0;
+        }
+
+        // The repaired objects go through the same validation as a fresh batch
+        if (!DynamicItemJsonParser::ParseItemsFromJsonText(response, profile, outItems))
+            outItems.clear();
+        if (static_cast<int>(outItems.size()) > sent)
+            outItems.resize(static_cast<size_t>(sent)); // Only the items we asked about
+        GenerationMetrics::RecordRepair(modelName, profile.id, sent, static_cast<int>(outItems.size()), stats);
+        std::cout << "[ItemGenerator] Repaired " << outItems.size() << "/" << sent << " invalid item(s)\n";
+        return static_cast<int>(outItems.size());
     }
 }
 
-int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
+std::string ItemGenerator::GetExecutableDirectory()
 {
-    // Get executable directory - this is the base for all paths
     std::string exeDir;
     
 #ifdef _WIN32
@@ -193,13 +209,49 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
             exeDir = exeDir.substr(0, lastSlash + 1);
         }
     }
-    else
+#endif
+    
+    return exeDir;
+}
+
+int ItemGenerator::GenerateWithLLM(CommandLineArgs& args, const GenerationProgressCallback& onProgress)
+{
+    // Lets the committer hold a commit back only while other jobs may still add to it
+    CatalogCommitter::ProducerScope commitProducer;
+    auto report = [&onProgress, &args](const std::string& stage, int accepted, const std::string& message)
+    {
+        if (onProgress)
+        {
+            GenerationProgress progress;
+            progress.stage = stage;
+            progress.accepted = accepted;
+            progress.requested = args.params.count;
+            progress.message = message;
+            onProgress(progress);
+        }
+    };
+    
+    // Continue an interrupted run: restores its job arguments and the items it had accepted
+    RunCheckpoint checkpoint;
+    std::vector<nlohmann::json> resumedItems;
+    if (!args.resumeRunId.empty())
     {
-        exeDir = "";
+        bool completed = false;
+        if (!checkpoint.Resume(args.resumeRunId, args, resumedItems, completed))
+        {
+            report("failed", 0, "Cannot resume run: " + args.resumeRunId);
+            return 1;
+        }
+        if (completed)
+        {
+            std::cout << "[ItemGenerator] Run " << args.resumeRunId << " already completed; nothing to do\n";
+            report("done", static_cast<int>(resumedItems.size()), "Run already completed");
+            return 0;
+        }
     }
-#else
-    exeDir = "";
-#endif
+    
+    // Get executable directory - this is the base for all paths
+    std::string exeDir = GetExecutableDirectory();
     
     // ItemProfiles directory - always use .exe directory/ItemProfiles
     std::string profilesDir = exeDir + "ItemProfiles";
@@ -210,15 +262,6 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
         profilesDir += "/";
     }
     
-    // Initialize item profile manager
-    if (!ItemProfileManager::Initialize(profilesDir))
-    {
-        std::cerr << "[ItemGenerator] Failed to initialize ItemProfileManager with directory: " << profilesDir << "\n";
-        return 1;
-    }
-    
-    std::cout << "[ItemGenerator] Using item profiles directory: " << profilesDir << "\n";
-
     // PlayerProfiles directory - always use .exe directory/PlayerProfiles
     std::string playerProfilesDir = exeDir + "PlayerProfiles";
     std::filesystem::path playerProfilesPath(playerProfilesDir);
@@ -228,17 +271,28 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
         playerProfilesDir += "/";
     }
     
+    // Profiles are cached across jobs in this process; directories stay per job
+    if (!GenerationCache::PrepareDirectories(profilesDir, playerProfilesDir))
+    {
+        std::cerr << "[ItemGenerator] Failed to initialize ItemProfileManager with directory: " << profilesDir << "\n";
+        report("failed", 0, "Failed to initialize item profiles directory");
+        return 1;
+    }
+    
+    std::cout << "[ItemGenerator] Using item profiles directory: " << profilesDir << "\n";
+    
     // Load player profile (REQUIRED)
     PlayerProfile playerProfile;
     bool playerProfileLoaded = false;
     
     if (!args.playerProfileId.empty())
     {
-        playerProfile = PlayerProfileManager::LoadProfile(args.playerProfileId, playerProfilesDir);
+        playerProfile = GenerationCache::GetPlayerProfile(playerProfilesDir, args.playerProfileId);
         if (playerProfile.id.empty())
         {
             std::cerr << "[ItemGenerator] Error: Failed to load player profile: " << args.playerProfileId << "\n";
             std::cerr << "[ItemGenerator] Player profile is required. Please create a player profile in PlayerProfiles folder.\n";
+            report("failed", 0, "Failed to load player profile: " + args.playerProfileId);
             return 1;
         }
         playerProfileLoaded = true;
@@ -246,7 +300,7 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
     else if (!playerProfilesDir.empty())
     {
         // Try to load default player profile
-        playerProfile = PlayerProfileManager::GetDefaultProfile(playerProfilesDir);
+        playerProfile = GenerationCache::GetDefaultPlayerProfile(playerProfilesDir);
         if (!playerProfile.id.empty())
         {
             playerProfileLoaded = true;
@@ -257,6 +311,7 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
     {
         std::cerr << "[ItemGenerator] Error: No player profile found. Player profile is required.\n";
         std::cerr << "[ItemGenerator] Please create a player profile in: " << playerProfilesDir << "\n";
+        report("failed", 0, "No player profile found");
         return 1;
     }
     
@@ -273,10 +328,11 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
     ItemProfile itemProfile;
     if (!args.profileId.empty())
     {
-        itemProfile = ItemProfileManager::LoadProfile(args.profileId);
+        itemProfile = GenerationCache::GetItemProfile(profilesDir, args.profileId);
         if (itemProfile.id.empty())
         {
             std::cerr << "[ItemGenerator] Failed to load item profile: " << args.profileId << "\n";
+            report("failed", 0, "Failed to load item profile: " + args.profileId);
             return 1;
         }
         std::cout << "[ItemGenerator] Loaded item profile: " << itemProfile.id << " (" << itemProfile.displayName << ")\n";
@@ -287,10 +343,11 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
         std::string defaultProfileId = "default_" + CommandLineParser::GetItemTypeName(args.itemType);
         std::transform(defaultProfileId.begin(), defaultProfileId.end(), defaultProfileId.begin(), ::tolower);
         
-        itemProfile = ItemProfileManager::LoadProfile(defaultProfileId);
+        itemProfile = GenerationCache::GetItemProfile(profilesDir, defaultProfileId);
         if (itemProfile.id.empty())
         {
             std::cerr << "[ItemGenerator] Failed to load default item profile for item type: " << defaultProfileId << "\n";
+            report("failed", 0, "Failed to load default item profile: " + defaultProfileId);
             return 1;
         }
         std::cout << "[ItemGenerator] Using default item profile: " << itemProfile.id << "\n";
@@ -299,20 +356,97 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
     // Use item profile's custom context for world context (Preset system removed)
     // World context is now managed through Item Profile's customContext field
 
-    // Get existing IDs from both JSON file and registry
-    std::set<std::string> existingIds = DynamicItemJsonWriter::GetExistingIds(args.params.outputPath);
-    std::cout << "[ItemGenerator] Found " << existingIds.size() << " existing items in " << args.params.outputPath << "\n";
-    
-    // Load IDs from registry (persistent across all generations)
+    // Get existing IDs from both JSON file and registry (persistent across all generations)
     std::string typeNameLower = itemProfile.itemTypeName;
     std::transform(typeNameLower.begin(), typeNameLower.end(), typeNameLower.begin(), ::tolower);
-    std::set<std::string> registryIds = ItemGeneratorRegistry::LoadRegistryIds(typeNameLower);
-    std::cout << "[ItemGenerator] Loaded " << registryIds.size() << " IDs from registry for type: " << typeNameLower << "\n";
-    
-    // Merge registry IDs with existing JSON IDs
-    existingIds.insert(registryIds.begin(), registryIds.end());
+    size_t fileIdCount = 0;
+    size_t registryIdCount = 0;
+    // A sharded catalog is read shard by shard; the unsharded file still counts for items written before sharding
+    const bool sharded = args.shardCount > 1;
+    std::vector<std::string> catalogPaths{ args.params.outputPath };
+    if (sharded)
+    {
+        // Fail before any LLM work if the catalog was sharded differently
+        ShardManifest manifest;
+        if (ShardedCatalogWriter::LoadManifest(args.params.outputPath, manifest) && manifest.shardCount != args.shardCount)
+        {
+            std::cerr << "[ItemGenerator] " << ShardedCatalogWriter::GetManifestPath(args.params.outputPath) << " has "
+                      << manifest.shardCount << " shards, requested " << args.shardCount << "\n";
+            report("failed", 0, "Shard count does not match the existing catalog");
+            return 1;
+        }
+        std::vector<std::string> shardPaths = ShardedCatalogWriter::GetShardPaths(args.params.outputPath, args.shardCount);
+        catalogPaths.insert(catalogPaths.end(), shardPaths.begin(), shardPaths.end());
+    }
+    std::set<std::string> existingIds = GenerationCache::GetKnownIds(
+        catalogPaths, typeNameLower, &fileIdCount, &registryIdCount);
+    std::cout << "[ItemGenerator] Found " << fileIdCount << " existing items in " << args.params.outputPath;
+    if (sharded)
+        std::cout << " (" << args.shardCount << " shards)";
+    std::cout << "\n";
+    std::cout << "[ItemGenerator] Loaded " << registryIdCount << " IDs from registry for type: " << typeNameLower << "\n";
+    const bool writeJson = args.outputFormat != OutputFormat::Binary;
+    const bool writeBinary = args.outputFormat != OutputFormat::Json;
+    const std::string binaryPath = BinaryCatalogWriter::GetBinaryPath(args.params.outputPath);
+    if (writeBinary)
+    {
+        // Only each catalog's id index is read
+        for (const auto& catalogPath : catalogPaths)
+        {
+            BinaryCatalogReader binaryCatalog;
+            if (binaryCatalog.Open(BinaryCatalogWriter::GetBinaryPath(catalogPath)))
+            {
+                for (size_t i = 0; i < binaryCatalog.GetCount(); ++i)
+                    existingIds.insert(binaryCatalog.GetId(i));
+                std::cout << "[ItemGenerator] Found " << binaryCatalog.GetCount() << " existing items in "
+                          << BinaryCatalogWriter::GetBinaryPath(catalogPath) << "\n";
+            }
+        }
+    }
     std::cout << "[ItemGenerator] Total unique IDs to avoid: " << existingIds.size() << "\n";
 
+    // Distinct items whose short IDs collide get a derived ID instead of being dropped; jobs
+    // writing the same catalog concurrently claim IDs in one shared index
+    std::vector<std::string> binaryCatalogPaths;
+    if (writeBinary)
+    {
+        for (const auto& catalogPath : catalogPaths)
+            binaryCatalogPaths.push_back(BinaryCatalogWriter::GetBinaryPath(catalogPath));
+    }
+    IdCollisionResolver idResolver(existingIds, GenerationCache::AcquireIdIndex(args.params.outputPath),
+                                   DynamicItemJsonParser::GetIdPrefix(itemProfile),
+                                   catalogPaths, binaryCatalogPaths);
+
+    // Items accepted by an interrupted run; ones already in the output file were written before it stopped
+    std::vector<nlohmann::json> newItems;
+    int alreadyWritten = 0;
+    for (auto& item : resumedItems)
+    {
+        if (!item.contains("id") || !item["id"].is_string())
+            continue;
+        std::string id = item["id"].get<std::string>();
+        if (existingIds.find(id) != existingIds.end())
+        {
+            ++alreadyWritten;
+            continue;
+        }
+        if (!idResolver.Record(item))
+            continue;
+        newItems.push_back(std::move(item));
+    }
+    resumedItems.clear();
+    const size_t resumedPending = newItems.size();
+
+    if (args.resumeRunId.empty())
+    {
+        if (!checkpoint.Begin(RunCheckpoint::NewRunId(), args))
+        {
+            std::cerr << "[ItemGenerator] Warning: Continuing without checkpoints\n";
+        }
+    }
+    report("loaded", static_cast<int>(newItems.size()) + alreadyWritten,
+           "Profiles loaded; " + std::to_string(existingIds.size()) + " known IDs; run " + checkpoint.GetRunId());
+
     // Generate timestamp
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
@@ -326,262 +460,307 @@ int ItemGenerator::GenerateWithLLM(CommandLineArgs& args)
 #endif
     std::string generationTimestamp = ss.str();
 
-    // Build prompt (world context is taken from itemProfile.customContext)
-    std::string prompt = DynamicPromptBuilder::BuildPromptFromProfile(
-        itemProfile,
-        playerProfile,
-        args.params,
-        existingIds,
-        args.modelName,
-        generationTimestamp,
-        static_cast<int>(existingIds.size()));
-
-    // Call LLM
-    std::cout << "[ItemGenerator] Calling LLM with model: " << args.modelName << "\n";
-    std::string response = OllamaClient::RunWithRetry(args.modelName, prompt);
-    if (response.empty())
-    {
-        std::cerr << "[ItemGenerator] LLM generation failed\n";
-        return 1;
-    }
-
-    // Parse response
-    std::vector<nlohmann::json> items;
-    if (!DynamicItemJsonParser::ParseItemsFromJsonText(response, itemProfile, items))
-    {
-        std::cerr << "[ItemGenerator] Failed to parse LLM response\n";
-        return 1;
-    }
-
-    std::cout << "[ItemGenerator] Parsed " << items.size() << " items from LLM response\n";
-
-    // Filter out duplicates and ensure id/displayName are present
-    std::vector<nlohmann::json> newItems;
-    for (size_t i = 0; i < items.size(); ++i)
+    // Request batches until the requested count is reached. Batch size is tuned per (model, profile)
+    // by BatchSizeController; each batch is checkpointed before the next request so an interrupted
+    // run loses at most one batch.
+    const int requestedCount = args.params.count - alreadyWritten;
+    const int maxRetries = 5; // Maximum consecutive batches without new items (duplicates, failures)
+    int round = 0;
+    int unproductiveRounds = 0;
+    ItemGuardrail guardrail(itemProfile); // Banned terms compiled once per run
+    GuardrailReport guardrailReport;
+    int guardrailRejected = 0;
+    QuotaScheduler quotas(itemProfile, requestedCount); // Target value distribution, e.g. rarity shares
+    int quotaDropped = 0;
+    for (const auto& item : newItems)
+        quotas.Record(item);
+    std::vector<int> conversation;       // Context of the last successful exchange (empty = send full prompt)
+    std::set<std::string> rejectedIds;   // Duplicate IDs from the last answer, named in the follow-up
+    
+    while (static_cast<int>(newItems.size()) < requestedCount && unproductiveRounds <= maxRetries)
     {
-        nlohmann::json item = items[i];
-        
-        // Ensure displayName is present first (needed for ID generation)
-        if (!item.contains("displayName") || item["displayName"].is_null() ||
-            (item["displayName"].is_string() && item["displayName"].get<std::string>().empty()))
+        const int needed = requestedCount - static_cast<int>(newItems.size());
+        // Over-request by the predicted loss (parse failures, validation, duplicates) so the
+        // batch usually completes the run without a top-up; any surplus is truncated below
+        const double predictedYield = BatchSizeController::PredictYield(args.modelName, itemProfile.id);
+        const int neededWithLoss = static_cast<int>(std::ceil(needed / predictedYield));
+        const int batchRequest = BatchSizeController::RecommendBatchSize(args.modelName, itemProfile.id, neededWithLoss);
+        std::cout << "[ItemGenerator] Batch " << (round + 1) << ": requesting " << batchRequest
+                  << " items (" << needed << " still needed, predicted yield "
+                  << static_cast<int>(predictedYield * 100.0 + 0.5) << "%)";
+        if (unproductiveRounds > 0)
         {
-            // Generate displayName if missing
-            item["displayName"] = itemProfile.itemTypeName + " Item " + std::to_string(i + 1);
+            std::cout << ", retry " << unproductiveRounds << "/" << maxRetries;
         }
+        std::cout << "\n";
         
-        // Ensure id is present and based on displayName
-        if (!item.contains("id") || item["id"].is_null() || 
-            (item["id"].is_string() && item["id"].get<std::string>().empty()))
+        // Later batches continue the previous exchange (server-side context) and only ask for
+        // "N more, different"; the full prompt is sent for the first batch, after a failed
+        // answer, or once the context grows close to the model's window
+        const bool continuing = !conversation.empty() && conversation.size() <= kMaxContinuationContextTokens;
+        std::string prompt;
+        if (continuing)
         {
-            // Generate id from displayName using the same logic as parser
-            std::string itemTypePrefix = itemProfile.itemTypeName;
-            std::transform(itemTypePrefix.begin(), itemTypePrefix.end(), itemTypePrefix.begin(), ::tolower);
-            itemTypePrefix.erase(std::remove_if(itemTypePrefix.begin(), itemTypePrefix.end(),
-                [](char c) { return !std::isalnum(c); }), itemTypePrefix.end());
-            
-            std::string displayName = item["displayName"].get<std::string>();
-            std::string idSuffix = DynamicItemJsonParser::GenerateShortIdFromDisplayName(displayName);
-            
-            // Limit length
-            if (idSuffix.length() > 30)
-                idSuffix = idSuffix.substr(0, 30);
-            
-            if (idSuffix.empty())
-                idSuffix = std::to_string(i + 1);
-            
-            std::ostringstream idStream;
-            idStream << itemTypePrefix << "_" << idSuffix;
-            item["id"] = idStream.str();
+            prompt = DynamicPromptBuilder::BuildContinuationPrompt(itemProfile, batchRequest, rejectedIds);
         }
-        
-        // Check for duplicates
-        if (item.contains("id") && item["id"].is_string())
+        else
         {
-            std::string id = item["id"].get<std::string>();
-            if (existingIds.find(id) == existingIds.end())
-            {
-                newItems.push_back(item);
-                existingIds.insert(id);
-            }
+            // World context is taken from itemProfile.customContext
+            FoodGenerateParams batchParams = args.params;
+            batchParams.count = batchRequest;
+            prompt = DynamicPromptBuilder::BuildPromptFromProfile(
+                itemProfile,
+                playerProfile,
+                batchParams,
+                existingIds,
+                args.modelName,
+                generationTimestamp,
+                static_cast<int>(existingIds.size()));
+            conversation.clear();
         }
-        else
+        if (quotas.HasQuotas())
         {
-            // If id is still missing after generation, skip this item
-            std::cerr << "[ItemGenerator] Warning: Item at index " << i << " has no valid id, skipping\n";
+            // Ask for the buckets that are still short so later batches rebalance the run
+            prompt += DynamicPromptBuilder::BuildQuotaDirective(quotas.PlanBatch(batchRequest));
         }
-    }
-
-    std::cout << "[ItemGenerator] " << newItems.size() << " new items (after filtering duplicates)\n";
-
-    // Limit to requested count if we got more than requested
-    if (static_cast<int>(newItems.size()) > args.params.count)
-    {
-        newItems.resize(args.params.count);
-        std::cout << "[ItemGenerator] Limited to " << args.params.count << " items (requested count)\n";
-    }
-
-    // Retry if we don't have enough items (due to duplicates)
-    int requestedCount = args.params.count;
-    int maxRetries = 5; // Maximum retry attempts
-    int retryCount = 0;
-    
-    while (static_cast<int>(newItems.size()) < requestedCount && retryCount < maxRetries)
-    {
-        int needed = requestedCount - static_cast<int>(newItems.size());
-        std::cout << "[ItemGenerator] Need " << needed << " more items. Retrying generation (attempt " << (retryCount + 1) << "/" << maxRetries << ")...\n";
+        rejectedIds.clear();
         
-        // Temporarily modify params.count for retry
-        int originalCount = args.params.count;
-        args.params.count = needed;
-        
-        // Build prompt for additional items
-        std::string retryPrompt = DynamicPromptBuilder::BuildPromptFromProfile(
-            itemProfile,
-            playerProfile,
-            args.params,
-            existingIds,
-            args.modelName,
-            generationTimestamp,
-            static_cast<int>(existingIds.size()));
-        
-        // Restore original count
-        args.params.count = originalCount;
-        
-        // Call LLM again
-        std::string retryResponse = OllamaClient::RunWithRetry(args.modelName, retryPrompt);
-        if (retryResponse.empty())
+        // Call LLM
+        std::cout << "[ItemGenerator] Calling LLM with model: " << args.modelName
+                  << (continuing ? " (continuing previous exchange)" : "") << "\n";
+        report("request", static_cast<int>(newItems.size()) + alreadyWritten, "Requesting " + std::to_string(batchRequest) + " items");
+        OllamaCallStats callStats;
+        std::string response = OllamaClient::RunWithRetry(args.modelName, prompt, 3, 120, &callStats, &conversation);
+        ++round;
+        if (response.empty())
         {
-            std::cerr << "[ItemGenerator] LLM retry generation failed\n";
+            std::cerr << "[ItemGenerator] LLM generation failed\n";
+            if (round == 1 && newItems.empty())
+            {
+                report("failed", 0, "LLM generation failed");
+                return 1;
+            }
+            if (continuing)
+            {
+                // Retry once more from a cold full prompt before giving up
+                conversation.clear();
+                ++unproductiveRounds;
+                continue;
+            }
             break;
         }
+        GenerationMetrics::RecordCall(args.modelName, itemProfile.id, callStats);
+        
+        BatchOutcome outcome;
+        outcome.requested = batchRequest;
+        outcome.stats = callStats;
         
-        // Parse retry response
-        std::vector<nlohmann::json> retryItems;
-        if (!DynamicItemJsonParser::ParseItemsFromJsonText(retryResponse, itemProfile, retryItems))
+        // Parse response (heap traffic from here to the dedup below is reported per batch)
+        const AllocationStats::Snapshot batchAllocStart = AllocationStats::GetThread();
+        std::vector<nlohmann::json> items;
+        std::vector<RejectedItem> invalidItems; // Kept for a repair request instead of being regenerated
+        if (!DynamicItemJsonParser::ParseItemsFromJsonText(response, itemProfile, items,
+                                                           args.repairLimit > 0 ? &invalidItems : nullptr) &&
+            invalidItems.empty())
         {
-            std::cerr << "[ItemGenerator] Failed to parse LLM retry response\n";
-            retryCount++;
+            std::cerr << "[ItemGenerator] Failed to parse LLM response\n";
+            RecordBatchAllocations(args.modelName, itemProfile.id, batchAllocStart);
+            conversation.clear(); // Do not build on a broken answer
+            BatchSizeController::RecordBatch(args.modelName, itemProfile.id, outcome);
+            GenerationMetrics::RecordYield(args.modelName, itemProfile.id, batchRequest, predictedYield, 0);
+            if (round == 1 && newItems.empty())
+            {
+                report("failed", 0, "Failed to parse LLM response");
+                return 1;
+            }
+            ++unproductiveRounds;
             continue;
         }
+        outcome.parsed = true;
+        outcome.parsedItems = static_cast<int>(items.size());
         
-        std::cout << "[ItemGenerator] Parsed " << retryItems.size() << " items from retry response\n";
+        std::cout << "[ItemGenerator] Parsed " << items.size() << " items from LLM response";
+        if (!invalidItems.empty())
+            std::cout << " (" << invalidItems.size() << " failed validation)";
+        std::cout << "\n";
         
-        // Filter duplicates from retry items
-        for (size_t i = 0; i < retryItems.size() && static_cast<int>(newItems.size()) < requestedCount; ++i)
+        // Filter out duplicates; the parser has already filled in id/displayName in place
+        const size_t batchStart = newItems.size();
+        auto acceptItems = [&](std::vector<nlohmann::json>& candidates)
         {
-            nlohmann::json item = retryItems[i];
-            
-            // Ensure displayName is present
-            if (!item.contains("displayName") || item["displayName"].is_null() ||
-                (item["displayName"].is_string() && item["displayName"].get<std::string>().empty()))
+            for (size_t i = 0; i < candidates.size(); ++i)
             {
-                item["displayName"] = itemProfile.itemTypeName + " Item " + std::to_string(newItems.size() + 1);
-            }
-            
-            // Ensure id is present
-            if (!item.contains("id") || item["id"].is_null() || 
-                (item["id"].is_string() && item["id"].get<std::string>().empty()))
-            {
-                std::string itemTypePrefix = itemProfile.itemTypeName;
-                std::transform(itemTypePrefix.begin(), itemTypePrefix.end(), itemTypePrefix.begin(), ::tolower);
-                itemTypePrefix.erase(std::remove_if(itemTypePrefix.begin(), itemTypePrefix.end(),
-                    [](char c) { return !std::isalnum(c); }), itemTypePrefix.end());
-                
-                std::string displayName = item["displayName"].get<std::string>();
-                std::string idSuffix = DynamicItemJsonParser::GenerateShortIdFromDisplayName(displayName);
+                nlohmann::json& item = candidates[i];
                 
-                if (idSuffix.length() > 30)
-                    idSuffix = idSuffix.substr(0, 30);
-                
-                if (idSuffix.empty())
-                    idSuffix = std::to_string(newItems.size() + 1);
+                // Screen every string field for banned terms
+                if (guardrail.ScanItem(item, guardrailReport) > 0 && guardrail.RejectsOnHit())
+                {
+                    ++outcome.rejected;
+                    ++guardrailRejected;
+                    std::cerr << "[ItemGenerator] Item at index " << i << " rejected by guardrail (banned term)\n";
+                    continue;
+                }
                 
-                std::ostringstream idStream;
-                idStream << itemTypePrefix << "_" << idSuffix;
-                item["id"] = idStream.str();
-            }
-            
-            // Check for duplicates
-            if (item.contains("id") && item["id"].is_string())
-            {
-                std::string id = item["id"].get<std::string>();
-                if (existingIds.find(id) == existingIds.end())
+                // Check for duplicates; only a repeated display name is one, a colliding short ID is re-derived
+                if (item.contains("id") && item["id"].is_string())
+                {
+                    std::string collidedId;
+                    const IdCollisionResolver::Outcome idOutcome = idResolver.Resolve(item, collidedId);
+                    if (idOutcome == IdCollisionResolver::Outcome::DuplicateName)
+                    {
+                        ++outcome.duplicates;
+                        rejectedIds.insert(collidedId);
+                    }
+                    else if (static_cast<int>(newItems.size()) < requestedCount)
+                    {
+                        std::string quotaReason;
+                        if (quotas.HasQuotas() && !quotas.TryAccept(item, quotaReason))
+                        {
+                            // Bucket already full; dropping now is cheaper than regenerating the run
+                            ++outcome.quotaDropped;
+                            ++quotaDropped;
+                            continue;
+                        }
+                        if (idOutcome == IdCollisionResolver::Outcome::Resolved)
+                        {
+                            std::cout << "[ItemGenerator] ID " << collidedId << " is taken by another item; using "
+                                      << item["id"].get_ref<const std::string&>() << "\n";
+                        }
+                        if (!idResolver.Record(item, idOutcome))
+                        {
+                            // A concurrent job writing this catalog accepted the same item first
+                            ++outcome.duplicates;
+                            quotas.Release(item);
+                            continue;
+                        }
+                        newItems.push_back(std::move(item));
+                    }
+                }
+                else
                 {
-                    newItems.push_back(item);
-                    existingIds.insert(id);
+                    // If id is still missing after generation, skip this item
+                    std::cerr << "[ItemGenerator] Warning: Item at index " << i << " has no valid id, skipping\n";
                 }
             }
+            candidates.clear();
+        };
+        acceptItems(items);
+        RecordBatchAllocations(args.modelName, itemProfile.id, batchAllocStart);
+        
+        // Items that failed validation are fixed in one short request; the repaired ones
+        // count towards this batch, so the yield estimate learns that they were kept
+        if (!invalidItems.empty() && static_cast<int>(newItems.size()) < requestedCount)
+        {
+            outcome.parsedItems += RequestRepairs(args.modelName, itemProfile, invalidItems, args.repairLimit, items);
+            acceptItems(items);
         }
         
-        std::cout << "[ItemGenerator] After retry: " << newItems.size() << " total new items\n";
+        std::cout << "[ItemGenerator] " << (newItems.size() - batchStart) << " new items (after filtering duplicates), "
+                  << newItems.size() << "/" << requestedCount << " total\n";
         
-        // Limit to requested count if we got more than requested after retry
-        if (static_cast<int>(newItems.size()) > requestedCount)
+        BatchSizeController::RecordBatch(args.modelName, itemProfile.id, outcome);
+        GenerationMetrics::RecordYield(args.modelName, itemProfile.id, batchRequest, predictedYield,
+                                       outcome.parsedItems - outcome.duplicates - outcome.rejected - outcome.quotaDropped);
+        
+        // Make the batch durable before asking for more
+        if (newItems.size() > batchStart)
         {
-            newItems.resize(requestedCount);
-            std::cout << "[ItemGenerator] Limited to " << requestedCount << " items (requested count) after retry\n";
+            checkpoint.CommitBatch(newItems, batchStart, alreadyWritten + static_cast<int>(newItems.size()));
+            unproductiveRounds = 0;
         }
-        
-        retryCount++;
+        else
+        {
+            ++unproductiveRounds;
+        }
+        report("batch", static_cast<int>(newItems.size()) + alreadyWritten, "Batch " + std::to_string(round) + " processed");
     }
     
-    // Final check: ensure we don't exceed requested count
-    if (static_cast<int>(newItems.size()) > requestedCount)
+    BatchSizeController::Save();
+    std::cout << "[ItemGenerator] " << (static_cast<int>(newItems.size()) + alreadyWritten) << "/" << args.params.count
+              << " items after " << round << " round trip(s)\n";
+    if (idResolver.GetResolvedCount() > 0)
     {
-        newItems.resize(requestedCount);
-        std::cout << "[ItemGenerator] Final limit: " << requestedCount << " items (requested count)\n";
+        std::cout << "[ItemGenerator] " << idResolver.GetResolvedCount()
+                  << " item(s) kept under a derived ID after a short-ID collision\n";
     }
     
+    std::vector<std::string> rarities;
+    for (const auto& item : newItems)
+    {
+        if (item.contains("rarity") && item["rarity"].is_string())
+            rarities.push_back(item["rarity"].get<std::string>());
+    }
+    PrintGuardrailSummary(itemProfile.itemTypeName, guardrailReport, guardrailRejected,
+                          CountRarity(rarities), static_cast<int>(newItems.size()));
+    if (quotas.HasQuotas())
+    {
+        std::cout << "[Quota] dropped=" << quotaDropped;
+        for (const auto& field : quotas.GetTargets())
+        {
+            for (const auto& target : field.second)
+            {
+                std::cout << " " << field.first << "[" << target.first << "]="
+                          << quotas.GetCounts().at(field.first).at(target.first) << "/" << target.second;
+            }
+        }
+        std::cout << "\n";
+    }
+    GenerationMetrics::RecordAcceptedItems(args.modelName, itemProfile.id, static_cast<int>(newItems.size() - resumedPending));
+    GenerationMetrics::PrintReport();
+    
     if (newItems.empty())
     {
         std::cout << "[ItemGenerator] No new items to write\n";
+        checkpoint.MarkCompleted(alreadyWritten);
+        report("done", alreadyWritten, "No new items to write");
         return 0;
     }
 
-    // Ensure output directory exists
-    EnsureParentDir(args.params.outputPath);
-
-    // Write items to file
-    if (!DynamicItemJsonWriter::WriteItemsToFile(newItems, args.params.outputPath, true))
+    // Hand the items to the committer thread; concurrent jobs that finish within the
+    // commit window share one output rewrite and one registry save
+    const int newItemCount = static_cast<int>(newItems.size());
+    CatalogCommitRequest commitRequest;
+    commitRequest.outputPath = args.params.outputPath;
+    commitRequest.writeJson = writeJson;
+    commitRequest.writeBinary = writeBinary;
+    commitRequest.shardCount = args.shardCount;
+    commitRequest.typeNameLower = typeNameLower;
+    commitRequest.items = std::move(newItems);
+    // Waiting here is the job's durability point: the checkpoint is marked completed and
+    // "done" is reported only once the items are on disk, and a failed write fails the job
+    CatalogCommitResult commit;
+    try
+    {
+        commit = CatalogCommitter::Submit(std::move(commitRequest)).get();
+    }
+    catch (const std::exception& e)
     {
-        std::cerr << "[ItemGenerator] Failed to write items to file\n";
+        commit.success = false;
+        commit.error = std::string("Commit failed: ") + e.what();
+    }
+    if (!commit.success)
+    {
+        std::cerr << "[ItemGenerator] " << commit.error << "\n";
+        report("failed", newItemCount, commit.error);
         return 1;
     }
 
-    std::cout << "[ItemGenerator] Successfully wrote " << newItems.size() << " items to " << args.params.outputPath << "\n";
+    const std::string writtenTo = sharded ? ShardedCatalogWriter::GetManifestPath(args.params.outputPath)
+                                          : (writeJson ? args.params.outputPath : binaryPath);
+    std::cout << "[ItemGenerator] Successfully wrote " << newItemCount << " items to " << writtenTo;
+    if (commit.groupedRequests > 1)
+        std::cout << " (group commit of " << commit.groupedRequests << " jobs)";
+    std::cout << "\n";
+    report("written", newItemCount, "Wrote items to " + writtenTo);
 
-    // Append new item IDs to registry (persistent storage)
-    if (!newItems.empty())
+    if (commit.registryAfter > 0)
     {
-        // Extract IDs from new items and add to registry
-        std::set<std::string> newIds;
-        for (const auto& item : newItems)
-        {
-            if (item.contains("id") && item["id"].is_string())
-            {
-                newIds.insert(item["id"].get<std::string>());
-            }
-        }
-        
-        if (!newIds.empty())
-        {
-            // Load existing registry IDs
-            std::set<std::string> registryIds = ItemGeneratorRegistry::LoadRegistryIds(typeNameLower);
-            size_t beforeCount = registryIds.size();
-            
-            // Merge new IDs
-            registryIds.insert(newIds.begin(), newIds.end());
-            
-            // Save back to registry
-            if (ItemGeneratorRegistry::SaveRegistryIds(typeNameLower, registryIds))
-            {
-                size_t afterCount = registryIds.size();
-                size_t addedCount = afterCount - beforeCount;
-                std::cout << "[ItemGenerator] Added " << addedCount << " new IDs to registry (total: " << afterCount << ")\n";
-                ItemGeneratorRegistry::LogRegistryEvent(itemProfile.itemTypeName, beforeCount, addedCount, afterCount);
-            }
-        }
+        size_t addedCount = commit.registryAfter - commit.registryBefore;
+        std::cout << "[ItemGenerator] Added " << addedCount << " new IDs to registry (total: " << commit.registryAfter << ")\n";
+        ItemGeneratorRegistry::LogRegistryEvent(itemProfile.itemTypeName, commit.registryBefore, addedCount, commit.registryAfter);
     }
 
+    checkpoint.MarkCompleted(alreadyWritten + newItemCount);
+    report("done", alreadyWritten + newItemCount, "Generation complete");
     return 0;
 }
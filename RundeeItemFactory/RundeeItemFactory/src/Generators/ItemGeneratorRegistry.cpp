@@ -7,6 +7,7 @@
  */
 
 #include "Generators/ItemGeneratorRegistry.h"
+#include "Utils/FileUtils.h"
 #include <fstream>
 #include <filesystem>
 #include <json.hpp>
@@ -43,6 +44,11 @@ namespace
 
 namespace ItemGeneratorRegistry
 {
+    std::string GetRegistryFilePath(const std::string& typeName)
+    {
+        return GetRegistryPath(typeName);
+    }
+    
     std::set<std::string> LoadRegistryIds(const std::string& typeName)
     {
         std::set<std::string> ids;
@@ -76,13 +82,12 @@ namespace ItemGeneratorRegistry
         EnsureParentDir(path);
         nlohmann::json j;
         j["ids"] = ids;
-        std::ofstream ofs(path);
-        if (!ofs.is_open())
+        // Replaced atomically and synced: a crash leaves the previous registry intact
+        if (!FileUtils::WriteFileAtomic(path, j.dump(2)))
         {
-            std::cerr << "[Registry] Failed to open registry for write: " << path << "\n";
+            std::cerr << "[Registry] Failed to write registry: " << path << "\n";
             return false;
         }
-        ofs << j.dump(2);
         return true;
     }
     
@@ -0,0 +1,74 @@
+/**
+ * @file ItemGuardrail.cpp
+ * @brief Implementation of banned-term screening
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/ItemGuardrail.h"
+#include "Helpers/AppConfig.h"
+
+ItemGuardrail::ItemGuardrail(const ItemProfile& profile)
+{
+    const GuardrailSettings& settings = AppConfig::GetGuardrailSettings();
+    std::vector<std::string> terms = settings.bannedTerms;
+    terms.insert(terms.end(), profile.bannedTerms.begin(), profile.bannedTerms.end());
+    m_matcher.Build(terms);
+    m_rejectOnHit = settings.rejectOnHit;
+}
+
+int ItemGuardrail::ScanItem(const nlohmann::json& item, GuardrailReport& report) const
+{
+    report.itemsScanned++;
+    if (m_matcher.Empty())
+        return 0;
+
+    std::map<std::string, int> fieldHits;
+    std::map<int, int> termHits;
+    ScanValue(item, std::string(), fieldHits, termHits);
+    if (fieldHits.empty())
+        return 0;
+
+    int hits = 0;
+    for (const auto& kv : fieldHits)
+    {
+        report.hitsByField[kv.first] += kv.second;
+        hits += kv.second;
+    }
+    for (const auto& kv : termHits)
+    {
+        report.hitsByTerm[m_matcher.GetTerms()[kv.first]] += kv.second;
+    }
+    report.totalHits += hits;
+    report.itemsWithHits++;
+    return hits;
+}
+
+void ItemGuardrail::ScanValue(const nlohmann::json& value, const std::string& path,
+                              std::map<std::string, int>& fieldHits, std::map<int, int>& termHits) const
+{
+    if (value.is_string())
+    {
+        m_matcher.Scan(value.get_ref<const std::string&>(), [&](int termId, size_t)
+        {
+            fieldHits[path]++;
+            termHits[termId]++;
+        });
+    }
+    else if (value.is_object())
+    {
+        for (auto it = value.begin(); it != value.end(); ++it)
+        {
+            ScanValue(it.value(), path.empty() ? it.key() : path + "." + it.key(), fieldHits, termHits);
+        }
+    }
+    else if (value.is_array())
+    {
+        const std::string elementPath = path + "[]";
+        for (const auto& element : value)
+        {
+            ScanValue(element, elementPath, fieldHits, termHits);
+        }
+    }
+}
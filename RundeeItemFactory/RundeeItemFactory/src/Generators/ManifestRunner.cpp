@@ -0,0 +1,206 @@
+/**
+ * @file ManifestRunner.cpp
+ * @brief Implementation of multi-job manifest execution
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/ManifestRunner.h"
+#include "Generators/ItemGenerator.h"
+#include "Clients/OllamaClient.h"
+#include "Helpers/GenerationMetrics.h"
+#include <json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /** @brief Jobs kept in flight when neither the manifest nor --concurrency sets it */
+    const int kDefaultConcurrency = 2;
+
+    /** @brief Upper bound on concurrent jobs (the LLM backend serializes beyond this anyway) */
+    const int kMaxConcurrency = 16;
+
+    /**
+     * @struct ManifestJob
+     * @brief One validated job and its outcome
+     */
+    struct ManifestJob
+    {
+        size_t index = 0;
+        CommandLineArgs args;
+        int exitCode = -1;
+        double seconds = 0.0;
+    };
+
+    /**
+     * @brief Load and validate a manifest file
+     * @param path Manifest path
+     * @param defaults Command line defaults
+     * @param outJobs Validated jobs in manifest order
+     * @param outConcurrency Concurrency requested by the manifest (0 if absent)
+     * @return True if the manifest and all of its jobs are valid
+     */
+    bool LoadManifest(const std::string& path, const CommandLineArgs& defaults,
+                      std::vector<ManifestJob>& outJobs, int& outConcurrency)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            std::cerr << "[Manifest] Failed to open manifest: " << path << "\n";
+            return false;
+        }
+
+        nlohmann::json manifest;
+        try
+        {
+            file >> manifest;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[Manifest] Failed to parse manifest: " << e.what() << "\n";
+            return false;
+        }
+
+        CommandLineArgs manifestDefaults = defaults;
+        nlohmann::json jobs;
+        outConcurrency = 0;
+
+        if (manifest.is_array())
+        {
+            jobs = manifest;
+        }
+        else if (manifest.is_object() && manifest.contains("jobs") && manifest["jobs"].is_array())
+        {
+            jobs = manifest["jobs"];
+            if (manifest.contains("concurrency") && manifest["concurrency"].is_number_integer())
+            {
+                outConcurrency = manifest["concurrency"].get<int>();
+            }
+            if (manifest.contains("defaults"))
+            {
+                std::string error;
+                if (!CommandLineParser::ParseJobJson(manifest["defaults"], defaults, manifestDefaults, error))
+                {
+                    std::cerr << "[Manifest] Invalid defaults: " << error << "\n";
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            std::cerr << "[Manifest] Manifest must be an array of jobs or an object with a \"jobs\" array\n";
+            return false;
+        }
+
+        bool valid = true;
+        for (size_t i = 0; i < jobs.size(); ++i)
+        {
+            ManifestJob job;
+            job.index = i;
+            std::string error;
+            if (!CommandLineParser::ParseJobJson(jobs[i], manifestDefaults, job.args, error))
+            {
+                std::cerr << "[Manifest] Job " << (i + 1) << " is invalid: " << error << "\n";
+                valid = false;
+                continue;
+            }
+            outJobs.push_back(job);
+        }
+        return valid;
+    }
+}
+
+int ManifestRunner::Run(const CommandLineArgs& defaults)
+{
+    std::vector<ManifestJob> jobs;
+    int manifestConcurrency = 0;
+    if (!LoadManifest(defaults.manifestPath, defaults, jobs, manifestConcurrency))
+    {
+        return 1;
+    }
+    if (jobs.empty())
+    {
+        std::cout << "[Manifest] No jobs in " << defaults.manifestPath << "\n";
+        return 0;
+    }
+
+    int concurrency = defaults.manifestConcurrency > 0 ? defaults.manifestConcurrency
+                    : (manifestConcurrency > 0 ? manifestConcurrency : kDefaultConcurrency);
+    concurrency = std::max(1, std::min({ concurrency, kMaxConcurrency, static_cast<int>(jobs.size()) }));
+
+    // Largest jobs first: short jobs fill the gaps at the end instead of a long one running alone
+    std::vector<ManifestJob*> schedule;
+    for (auto& job : jobs)
+    {
+        schedule.push_back(&job);
+    }
+    std::stable_sort(schedule.begin(), schedule.end(), [](const ManifestJob* a, const ManifestJob* b)
+    {
+        return a->args.params.count > b->args.params.count;
+    });
+
+    std::cout << "[Manifest] Running " << jobs.size() << " jobs from " << defaults.manifestPath
+              << " with " << concurrency << " in flight\n";
+
+    auto runStart = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextJob{ 0 };
+    auto worker = [&]()
+    {
+        for (size_t slot = nextJob++; slot < schedule.size(); slot = nextJob++)
+        {
+            ManifestJob& job = *schedule[slot];
+            std::cout << "[Manifest] Starting job " << (job.index + 1) << "/" << jobs.size()
+                      << " (profile=" << job.args.profileId << ", count=" << job.args.params.count
+                      << ", out=" << job.args.params.outputPath << ")\n";
+
+            auto jobStart = std::chrono::steady_clock::now();
+            try
+            {
+                job.exitCode = ItemGenerator::GenerateWithLLM(job.args);
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "[Manifest] Job " << (job.index + 1) << " failed with exception: " << e.what() << "\n";
+                job.exitCode = 1;
+            }
+            job.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - jobStart).count();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < concurrency; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+    for (auto& t : workers)
+    {
+        t.join();
+    }
+    OllamaClient::ReleaseConnections();
+
+    double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    int failed = 0;
+    std::cout << "[Manifest] Summary:\n";
+    for (const auto& job : jobs)
+    {
+        if (job.exitCode != 0)
+            ++failed;
+        std::cout << "[Manifest]   job " << (job.index + 1) << " profile=" << job.args.profileId
+                  << " out=" << job.args.params.outputPath
+                  << " exit=" << job.exitCode
+                  << " time=" << std::fixed << std::setprecision(1) << job.seconds << "s\n";
+    }
+    std::cout << "[Manifest] " << (jobs.size() - failed) << "/" << jobs.size() << " jobs succeeded in "
+              << std::fixed << std::setprecision(1) << totalSeconds << "s\n";
+    GenerationMetrics::PrintReport();
+
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+/**
+ * @file QuotaScheduler.cpp
+ * @brief Implementation of quota targets and batch planning
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/QuotaScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Split total into integer parts proportional to weights (largest remainder)
+     * @param weights Value -> non-negative weight
+     * @param total Count to distribute
+     * @return Value -> count, summing to total when any weight is positive
+     */
+    std::map<std::string, int> Apportion(const std::map<std::string, double>& weights, int total)
+    {
+        std::map<std::string, int> result;
+        double weightSum = 0.0;
+        for (const auto& kv : weights)
+            weightSum += kv.second;
+        if (weightSum <= 0.0 || total <= 0)
+        {
+            for (const auto& kv : weights)
+                result[kv.first] = 0;
+            return result;
+        }
+
+        std::vector<std::pair<double, std::string>> remainders;
+        int assigned = 0;
+        for (const auto& kv : weights)
+        {
+            double exact = total * kv.second / weightSum;
+            int whole = static_cast<int>(std::floor(exact));
+            result[kv.first] = whole;
+            assigned += whole;
+            remainders.emplace_back(exact - whole, kv.first);
+        }
+
+        // Highest remainder first; ties go to the larger weight so small runs favour the common values
+        std::stable_sort(remainders.begin(), remainders.end(),
+            [&weights](const std::pair<double, std::string>& a, const std::pair<double, std::string>& b)
+            {
+                if (a.first != b.first)
+                    return a.first > b.first;
+                return weights.at(a.second) > weights.at(b.second);
+            });
+        for (size_t i = 0; assigned < total && i < remainders.size(); ++i)
+        {
+            if (weights.at(remainders[i].second) <= 0.0)
+                continue;
+            ++result[remainders[i].second];
+            ++assigned;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Read an item's value for a quota field
+     * @return False if the field is missing or not a string
+     */
+    bool GetValue(const nlohmann::json& item, const std::string& field, std::string& value)
+    {
+        auto it = item.find(field);
+        if (it == item.end() || !it->is_string())
+            return false;
+        value = it->get<std::string>();
+        return true;
+    }
+}
+
+QuotaScheduler::QuotaScheduler(const ItemProfile& profile, int totalCount)
+{
+    for (const auto& quota : profile.quotas)
+    {
+        auto fieldIt = std::find_if(profile.fields.begin(), profile.fields.end(),
+            [&quota](const ProfileField& f) { return f.name == quota.first; });
+        if (fieldIt == profile.fields.end() || fieldIt->validation.allowedValues.empty())
+        {
+            std::cerr << "[QuotaScheduler] Ignoring quota for '" << quota.first
+                      << "': field has no allowedValues in profile " << profile.id << "\n";
+            continue;
+        }
+
+        // Every allowed value gets a bucket; values without a share get a zero target
+        std::map<std::string, double> weights;
+        for (const auto& value : fieldIt->validation.allowedValues)
+            weights[value] = 0.0;
+        for (const auto& share : quota.second)
+        {
+            if (weights.find(share.first) == weights.end())
+            {
+                std::cerr << "[QuotaScheduler] Ignoring quota value '" << share.first
+                          << "' for '" << quota.first << "': not an allowed value\n";
+                continue;
+            }
+            weights[share.first] = share.second;
+        }
+        if (std::any_of(weights.begin(), weights.end(),
+                [](const std::pair<const std::string, double>& w) { return !std::isfinite(w.second) || w.second < 0.0; }))
+        {
+            // Profiles loaded from disk are checked already; this guards profiles built in code
+            std::cerr << "[QuotaScheduler] Ignoring quota for '" << quota.first << "': shares must be non-negative\n";
+            continue;
+        }
+
+        std::map<std::string, int> targets = Apportion(weights, totalCount);
+        int targetSum = 0;
+        for (const auto& kv : targets)
+            targetSum += kv.second;
+        if (targetSum != totalCount)
+        {
+            std::cerr << "[QuotaScheduler] Ignoring quota for '" << quota.first
+                      << "': no allowed value has a positive share\n";
+            continue;
+        }
+
+        m_targets[quota.first] = targets;
+        for (const auto& kv : targets)
+            m_counts[quota.first][kv.first] = 0;
+    }
+}
+
+void QuotaScheduler::Record(const nlohmann::json& item)
+{
+    for (auto& field : m_counts)
+    {
+        std::string value;
+        if (GetValue(item, field.first, value))
+            ++field.second[value];
+    }
+}
+
+bool QuotaScheduler::TryAccept(const nlohmann::json& item, std::string& reason)
+{
+    // Check every field before counting anything so a rejected item leaves no trace
+    for (const auto& field : m_targets)
+    {
+        std::string value;
+        if (!GetValue(item, field.first, value))
+        {
+            reason = field.first + " missing";
+            return false;
+        }
+        auto targetIt = field.second.find(value);
+        if (targetIt == field.second.end() || m_counts[field.first][value] >= targetIt->second)
+        {
+            reason = field.first + "=" + value;
+            return false;
+        }
+    }
+
+    Record(item);
+    return true;
+}
+
+void QuotaScheduler::Release(const nlohmann::json& item)
+{
+    for (auto& field : m_counts)
+    {
+        std::string value;
+        if (!GetValue(item, field.first, value))
+            continue;
+        auto countIt = field.second.find(value);
+        if (countIt != field.second.end() && countIt->second > 0)
+            --countIt->second;
+    }
+}
+
+QuotaCounts QuotaScheduler::PlanBatch(int batchCount) const
+{
+    QuotaCounts plan;
+    for (const auto& field : m_targets)
+    {
+        const auto& counts = m_counts.at(field.first);
+        std::map<std::string, double> deficits;
+        for (const auto& target : field.second)
+        {
+            auto countIt = counts.find(target.first);
+            int have = countIt != counts.end() ? countIt->second : 0;
+            deficits[target.first] = static_cast<double>(std::max(0, target.second - have));
+        }
+
+        // Over-requests are spread in proportion to what each bucket still needs
+        plan[field.first] = Apportion(deficits, batchCount);
+    }
+    return plan;
+}
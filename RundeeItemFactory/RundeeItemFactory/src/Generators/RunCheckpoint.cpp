@@ -0,0 +1,228 @@
+/**
+ * @file RunCheckpoint.cpp
+ * @brief Implementation of batch-granular run checkpoints
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Generators/RunCheckpoint.h"
+#include "Utils/FileUtils.h"
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+
+namespace
+{
+    /** @brief Root directory for run checkpoints (next to Registry/) */
+    const std::string kCheckpointDir = "Checkpoints";
+    const std::string kManifestFile = "run.json";
+    const std::string kItemsFile = "items.jsonl";
+}
+
+std::string RunCheckpoint::NewRunId()
+{
+    auto now = std::chrono::system_clock::now();
+    std::time_t t = std::chrono::system_clock::to_time_t(now);
+    std::tm timeinfo{};
+#ifdef _WIN32
+    localtime_s(&timeinfo, &t);
+#else
+    localtime_r(&t, &timeinfo);
+#endif
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<int> dist(0, 0xFFFF);
+
+    std::ostringstream id;
+    id << std::put_time(&timeinfo, "%Y%m%d-%H%M%S") << "-"
+       << std::hex << std::setw(4) << std::setfill('0') << dist(gen);
+    return id.str();
+}
+
+bool RunCheckpoint::IsValidRunId(const std::string& runId)
+{
+    // 8 date digits, '-', 6 time digits, '-', 4 lowercase hex digits
+    if (runId.size() != 20 || runId[8] != '-' || runId[15] != '-')
+        return false;
+    for (size_t i = 0; i < runId.size(); ++i)
+    {
+        const char c = runId[i];
+        if (i == 8 || i == 15)
+            continue;
+        const bool digit = c >= '0' && c <= '9';
+        if (i < 15 ? !digit : !(digit || (c >= 'a' && c <= 'f')))
+            return false;
+    }
+    return true;
+}
+
+std::string RunCheckpoint::GetRunDirectory(const std::string& runId)
+{
+    return kCheckpointDir + "/" + runId + "/";
+}
+
+bool RunCheckpoint::Begin(const std::string& runId, const CommandLineArgs& args)
+{
+    m_runId = runId;
+    m_runDir = GetRunDirectory(runId);
+    m_job = CommandLineParser::JobToJson(args);
+    m_batches = 0;
+
+    if (!WriteManifest("running", 0))
+    {
+        std::cerr << "[Checkpoint] Failed to create run manifest in " << m_runDir << "\n";
+        return false;
+    }
+    std::cout << "[Checkpoint] Run ID: " << m_runId << " (continue with --resume " << m_runId << ")\n";
+    return true;
+}
+
+bool RunCheckpoint::Resume(const std::string& runId, CommandLineArgs& inOutArgs,
+                           std::vector<nlohmann::json>& outItems, bool& outCompleted)
+{
+    outItems.clear();
+    outCompleted = false;
+    if (!IsValidRunId(runId))
+    {
+        std::cerr << "[Checkpoint] Invalid run ID: " << runId << " (expected YYYYMMDD-HHMMSS-xxxx)\n";
+        return false;
+    }
+
+    m_runId = runId;
+    m_runDir = GetRunDirectory(runId);
+
+    std::string manifestText;
+    if (!FileUtils::ReadFile(m_runDir + kManifestFile, manifestText))
+    {
+        std::cerr << "[Checkpoint] No checkpoint found for run: " << runId << "\n";
+        return false;
+    }
+
+    nlohmann::json manifest;
+    try
+    {
+        manifest = nlohmann::json::parse(manifestText);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "[Checkpoint] Corrupt run manifest for " << runId << ": " << e.what() << "\n";
+        return false;
+    }
+
+    if (!manifest.is_object() || !manifest.contains("job"))
+    {
+        std::cerr << "[Checkpoint] Run manifest for " << runId << " has no job\n";
+        return false;
+    }
+
+    std::string error;
+    CommandLineArgs recorded;
+    if (!CommandLineParser::ParseJobJson(manifest["job"], inOutArgs, recorded, error))
+    {
+        std::cerr << "[Checkpoint] Invalid job in run manifest: " << error << "\n";
+        return false;
+    }
+    recorded.resumeRunId = runId;
+    inOutArgs = recorded;
+    m_job = manifest["job"];
+    m_batches = manifest.value("batches", 0);
+    outCompleted = manifest.value("status", std::string()) == "completed";
+
+    // Items are appended one line per item; a crash can only leave the last line torn
+    std::string itemsText;
+    if (FileUtils::ReadFile(m_runDir + kItemsFile, itemsText))
+    {
+        std::istringstream lines(itemsText);
+        std::string line;
+        size_t skipped = 0;
+        while (std::getline(lines, line))
+        {
+            if (line.find_first_not_of(" \t\r\n") == std::string::npos)
+                continue;
+            try
+            {
+                nlohmann::json item = nlohmann::json::parse(line);
+                if (item.is_object())
+                {
+                    outItems.push_back(std::move(item));
+                    continue;
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+            ++skipped;
+        }
+        if (skipped > 0)
+        {
+            std::cerr << "[Checkpoint] Skipped " << skipped << " unreadable checkpoint line(s)\n";
+        }
+        if (skipped > 0 || (!itemsText.empty() && itemsText.back() != '\n'))
+        {
+            // Drop the torn tail so the next append starts on a fresh line
+            std::string clean;
+            for (const auto& item : outItems)
+            {
+                clean += item.dump();
+                clean += '\n';
+            }
+            FileUtils::WriteFileAtomic(m_runDir + kItemsFile, clean);
+        }
+    }
+
+    std::cout << "[Checkpoint] Resuming run " << runId << ": " << outItems.size() << "/"
+              << inOutArgs.params.count << " items already accepted"
+              << (outCompleted ? " (run already completed)" : "") << "\n";
+    return true;
+}
+
+bool RunCheckpoint::CommitBatch(const std::vector<nlohmann::json>& items, size_t first, int totalAccepted)
+{
+    if (m_runId.empty())
+        return false;
+
+    if (first < items.size())
+    {
+        std::string lines;
+        for (size_t i = first; i < items.size(); ++i)
+        {
+            lines += items[i].dump();
+            lines += '\n';
+        }
+        if (!FileUtils::AppendDurable(m_runDir + kItemsFile, lines))
+        {
+            std::cerr << "[Checkpoint] Failed to checkpoint " << (items.size() - first) << " items\n";
+            return false;
+        }
+    }
+
+    ++m_batches;
+    if (!WriteManifest("running", totalAccepted))
+        return false;
+
+    std::cout << "[Checkpoint] Batch " << m_batches << " committed (" << totalAccepted << " items accepted)\n";
+    return true;
+}
+
+bool RunCheckpoint::MarkCompleted(int totalAccepted)
+{
+    if (m_runId.empty())
+        return false;
+    return WriteManifest("completed", totalAccepted);
+}
+
+bool RunCheckpoint::WriteManifest(const std::string& status, int totalAccepted)
+{
+    nlohmann::json manifest;
+    manifest["runId"] = m_runId;
+    manifest["status"] = status;
+    manifest["job"] = m_job;
+    manifest["accepted"] = totalAccepted;
+    manifest["batches"] = m_batches;
+    return FileUtils::WriteFileAtomic(m_runDir + kManifestFile, manifest.dump(2));
+}
@@ -10,6 +10,7 @@
 
 #include "Helpers/AppConfig.h"
 #include "json.hpp"
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -19,6 +20,8 @@ namespace
     using json = nlohmann::json;
 
     OllamaSettings g_settings{};
+    GuardrailSettings g_guardrail{};
+    CommitSettings g_commit{};
     bool g_loaded = false;
     std::string g_loadedPath;
 
@@ -140,6 +143,37 @@ void AppConfig::ApplyJson(const std::string& jsonText, const std::string& source
             SetIfPresent(o, "receiveTimeoutMs", g_settings.receiveTimeoutMs);
         }
 
+        if (root.contains("guardrail") && root["guardrail"].is_object())
+        {
+            const auto& g = root["guardrail"];
+            if (g.contains("bannedTerms") && g["bannedTerms"].is_array())
+            {
+                g_guardrail.bannedTerms.clear();
+                for (const auto& term : g["bannedTerms"])
+                {
+                    if (term.is_string())
+                        g_guardrail.bannedTerms.push_back(term.get<std::string>());
+                }
+            }
+            if (g.contains("rejectOnHit") && g["rejectOnHit"].is_boolean())
+            {
+                g_guardrail.rejectOnHit = g["rejectOnHit"].get<bool>();
+            }
+        }
+
+        if (root.contains("commit") && root["commit"].is_object())
+        {
+            const auto& c = root["commit"];
+            if (c.contains("intervalMs") && c["intervalMs"].is_number_integer())
+            {
+                g_commit.intervalMs = std::max(0, c["intervalMs"].get<int>());
+            }
+            if (c.contains("maxItems") && c["maxItems"].is_number_integer())
+            {
+                g_commit.maxItems = std::max(1, c["maxItems"].get<int>());
+            }
+        }
+
         std::cout << "[AppConfig] Loaded config from " << sourceLabel << "\n";
     }
     catch (const std::exception& ex)
@@ -153,3 +187,15 @@ const OllamaSettings& AppConfig::GetOllamaSettings()
     EnsureLoaded();
     return g_settings;
 }
+
+const GuardrailSettings& AppConfig::GetGuardrailSettings()
+{
+    EnsureLoaded();
+    return g_guardrail;
+}
+
+const CommitSettings& AppConfig::GetCommitSettings()
+{
+    EnsureLoaded();
+    return g_commit;
+}
@@ -9,6 +9,8 @@
 // ===============================
 
 #include "Helpers/CommandLineParser.h"
+#include "Generators/RunCheckpoint.h"
+#include "Writers/ShardedCatalogWriter.h"
 #include <iostream>
 #include <cstdlib>
 #include <sstream>
@@ -139,26 +141,17 @@ namespace CommandLineParser
             }
             else if (arg == "--out" && i + 1 < argc)
             {
-                std::string outPath = argv[++i];
-                std::string exeDir = GetExecutableDirectory();
-                
-                // Always save to .exe directory/ItemJson folder
-                // Extract filename from path (handles both absolute and relative)
-                std::filesystem::path pathObj(outPath);
-                std::string fileName = pathObj.filename().string();
-                
-                // Ensure ItemJson folder path
-                std::filesystem::path itemJsonPath(exeDir);
-                itemJsonPath /= "ItemJson";
-                itemJsonPath /= fileName;
-                
-                args.params.outputPath = itemJsonPath.string();
+                args.params.outputPath = ResolveOutputPath(argv[++i]);
             }
             else if (arg == "--report" && i + 1 < argc)
             {
                 args.reportPath = argv[++i];
                 // report mode is independent of LLM; mode value unused when reportPath is set
             }
+            else if (arg == "--validate" && i + 1 < argc)
+            {
+                args.validatePath = argv[++i];
+            }
             else if (arg == "--customPreset" && i + 1 < argc)
             {
                 args.customPresetPath = argv[++i];
@@ -179,6 +172,60 @@ namespace CommandLineParser
             {
                 args.playerProfileId = argv[++i];
             }
+            else if (arg == "--serve")
+            {
+                args.serveMode = true;
+            }
+            else if (arg == "--port" && i + 1 < argc)
+            {
+                args.servePort = std::atoi(argv[++i]);
+            }
+            else if (arg == "--resume" && i + 1 < argc)
+            {
+                args.resumeRunId = argv[++i];
+                if (!RunCheckpoint::IsValidRunId(args.resumeRunId))
+                    std::cout << "[Warning] --resume expects a run ID like 20261018-143906-3fa2; the run will not start\n";
+            }
+            else if (arg == "--manifest" && i + 1 < argc)
+            {
+                args.manifestPath = argv[++i];
+            }
+            else if (arg == "--concurrency" && i + 1 < argc)
+            {
+                args.manifestConcurrency = std::atoi(argv[++i]);
+            }
+            else if (arg == "--shards" && i + 1 < argc)
+            {
+                const int shards = std::atoi(argv[++i]);
+                if (shards >= 1 && shards <= ShardedCatalogWriter::kMaxShards)
+                    args.shardCount = shards;
+                else
+                    std::cout << "[Warning] --shards must be between 1 and " << ShardedCatalogWriter::kMaxShards << "\n";
+            }
+            else if (arg == "--repair" && i + 1 < argc)
+            {
+                const int limit = std::atoi(argv[++i]);
+                if (limit >= 0)
+                    args.repairLimit = limit;
+                else
+                    std::cout << "[Warning] --repair must be 0 or more\n";
+            }
+            else if (arg == "--bench" && i + 1 < argc)
+            {
+                args.benchSuite = argv[++i];
+            }
+            else if (arg == "--benchFile" && i + 1 < argc)
+            {
+                args.benchFile = argv[++i];
+            }
+            else if (arg == "--format" && i + 1 < argc)
+            {
+                std::string f = argv[++i];
+                if (!TryParseOutputFormat(f, args.outputFormat))
+                {
+                    std::cout << "[Warning] Unknown format: " << f << " (use 'json', 'binary' or 'both')\n";
+                }
+            }
             else
             {
                 std::cout << "[Warning] Unknown or incomplete argument: " << arg << "\n";
@@ -188,6 +235,149 @@ namespace CommandLineParser
         return args;
     }
 
+    std::string ResolveOutputPath(const std::string& outPath)
+    {
+        std::string exeDir = GetExecutableDirectory();
+        
+        // Always save to .exe directory/ItemJson folder
+        // Extract filename from path (handles both absolute and relative)
+        std::filesystem::path pathObj(outPath);
+        std::string fileName = pathObj.filename().string();
+        
+        // Ensure ItemJson folder path
+        std::filesystem::path itemJsonPath(exeDir);
+        itemJsonPath /= "ItemJson";
+        itemJsonPath /= fileName;
+        
+        return itemJsonPath.string();
+    }
+
+    bool ParseJobJson(const nlohmann::json& job, const CommandLineArgs& defaults,
+                      CommandLineArgs& outArgs, std::string& outError)
+    {
+        outArgs = defaults;
+        outError.clear();
+        
+        if (!job.is_object())
+        {
+            outError = "Job must be a JSON object";
+            return false;
+        }
+        
+        auto readString = [&job](const char* key, std::string& out) -> bool
+        {
+            if (!job.contains(key))
+                return true;
+            if (!job[key].is_string())
+                return false;
+            out = job[key].get<std::string>();
+            return true;
+        };
+        
+        if (!readString("model", outArgs.modelName) ||
+            !readString("profile", outArgs.profileId) ||
+            !readString("playerProfile", outArgs.playerProfileId) ||
+            !readString("additionalPrompt", outArgs.additionalPrompt))
+        {
+            outError = "Fields 'model', 'profile', 'playerProfile' and 'additionalPrompt' must be strings";
+            return false;
+        }
+        
+        if (job.contains("itemType"))
+        {
+            if (!job["itemType"].is_string() || !TryParseItemType(job["itemType"].get<std::string>(), outArgs.itemType))
+            {
+                outError = "Unknown itemType";
+                return false;
+            }
+        }
+        
+        if (job.contains("count"))
+        {
+            if (!job["count"].is_number_integer() || job["count"].get<int>() <= 0)
+            {
+                outError = "Field 'count' must be a positive integer";
+                return false;
+            }
+            outArgs.params.count = job["count"].get<int>();
+        }
+        
+        if (job.contains("out"))
+        {
+            if (!job["out"].is_string() || job["out"].get<std::string>().empty())
+            {
+                outError = "Field 'out' must be a non-empty string";
+                return false;
+            }
+            outArgs.params.outputPath = ResolveOutputPath(job["out"].get<std::string>());
+        }
+        
+        if (job.contains("format"))
+        {
+            if (!job["format"].is_string() || !TryParseOutputFormat(job["format"].get<std::string>(), outArgs.outputFormat))
+            {
+                outError = "Field 'format' must be 'json', 'binary' or 'both'";
+                return false;
+            }
+        }
+        
+        if (job.contains("shards"))
+        {
+            if (!job["shards"].is_number_integer() || job["shards"].get<int>() < 1 ||
+                job["shards"].get<int>() > ShardedCatalogWriter::kMaxShards)
+            {
+                outError = "Field 'shards' must be an integer between 1 and " + std::to_string(ShardedCatalogWriter::kMaxShards);
+                return false;
+            }
+            outArgs.shardCount = job["shards"].get<int>();
+        }
+        
+        if (job.contains("repair"))
+        {
+            if (!job["repair"].is_number_integer() || job["repair"].get<int>() < 0)
+            {
+                outError = "Field 'repair' must be a non-negative integer";
+                return false;
+            }
+            outArgs.repairLimit = job["repair"].get<int>();
+        }
+        
+        outArgs.serveMode = false;
+        outArgs.manifestPath.clear();
+        outArgs.resumeRunId.clear();
+        if (job.contains("resume"))
+        {
+            if (!job["resume"].is_string())
+            {
+                outError = "Field 'resume' must be a string";
+                return false;
+            }
+            outArgs.resumeRunId = job["resume"].get<std::string>();
+            if (!RunCheckpoint::IsValidRunId(outArgs.resumeRunId))
+            {
+                outError = "Field 'resume' must be a run ID like 20261018-143906-3fa2";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    nlohmann::json JobToJson(const CommandLineArgs& args)
+    {
+        nlohmann::json job;
+        job["model"] = args.modelName;
+        job["itemType"] = GetItemTypeName(args.itemType);
+        job["count"] = args.params.count;
+        job["profile"] = args.profileId;
+        job["playerProfile"] = args.playerProfileId;
+        job["out"] = args.params.outputPath;
+        job["additionalPrompt"] = args.additionalPrompt;
+        job["format"] = GetOutputFormatName(args.outputFormat);
+        job["shards"] = args.shardCount;
+        job["repair"] = args.repairLimit;
+        return job;
+    }
+
     std::string GetItemTypeName(ItemType itemType)
     {
         switch (itemType)
@@ -214,31 +404,64 @@ namespace CommandLineParser
         }
     }
 
-    ItemType ParseItemType(const std::string& typeStr)
+    bool TryParseItemType(const std::string& typeStr, ItemType& outType)
     {
         std::string lower = typeStr;
         std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
         
         if (lower == "food")
-            return ItemType::Food;
+            outType = ItemType::Food;
         else if (lower == "drink")
-            return ItemType::Drink;
+            outType = ItemType::Drink;
         else if (lower == "medicine")
-            return ItemType::Medicine;
+            outType = ItemType::Medicine;
         else if (lower == "material")
-            return ItemType::Material;
+            outType = ItemType::Material;
         else if (lower == "weapon")
-            return ItemType::Weapon;
+            outType = ItemType::Weapon;
         else if (lower == "weaponcomponent" || lower == "weapon_component")
-            return ItemType::WeaponComponent;
+            outType = ItemType::WeaponComponent;
         else if (lower == "ammo")
-            return ItemType::Ammo;
+            outType = ItemType::Ammo;
         else if (lower == "armor")
-            return ItemType::Armor;
+            outType = ItemType::Armor;
         else if (lower == "clothing")
-            return ItemType::Clothing;
+            outType = ItemType::Clothing;
         else
-            return ItemType::Food; // Default
+            return false;
+        return true;
     }
 
+    ItemType ParseItemType(const std::string& typeStr)
+    {
+        ItemType type = ItemType::Food; // Default
+        TryParseItemType(typeStr, type);
+        return type;
+    }
+
+    bool TryParseOutputFormat(const std::string& formatStr, OutputFormat& outFormat)
+    {
+        std::string f = formatStr;
+        std::transform(f.begin(), f.end(), f.begin(), ::tolower);
+        if (f == "json")
+            outFormat = OutputFormat::Json;
+        else if (f == "binary")
+            outFormat = OutputFormat::Binary;
+        else if (f == "both")
+            outFormat = OutputFormat::Both;
+        else
+            return false;
+        return true;
+    }
+
+    std::string GetOutputFormatName(OutputFormat format)
+    {
+        switch (format)
+        {
+        case OutputFormat::Binary: return "binary";
+        case OutputFormat::Both:   return "both";
+        case OutputFormat::Json:
+        default:                   return "json";
+        }
+    }
 }
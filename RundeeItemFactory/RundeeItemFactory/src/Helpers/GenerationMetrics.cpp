@@ -0,0 +1,253 @@
+/**
+ * @file GenerationMetrics.cpp
+ * @brief Implementation of generation statistics aggregation
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Helpers/GenerationMetrics.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    using MetricsKey = std::pair<std::string, std::string>; // (model, profile)
+
+    std::map<MetricsKey, GenerationMetricsTotals> g_totals;
+    std::mutex g_totalsMutex;
+
+    /**
+     * @brief Print one summary line
+     * @param label Line label (e.g., "model=llama3")
+     * @param t Totals to print
+     */
+    void PrintTotalsLine(const std::string& label, const GenerationMetricsTotals& t)
+    {
+        std::cout << "[Metrics] " << label
+            << " calls=" << t.calls
+            << " promptTok=" << t.promptTokens
+            << " genTok=" << t.generatedTokens
+            << std::fixed << std::setprecision(2)
+            << " load=" << (t.loadDurationNs / 1e9) << "s"
+            << " prefill=" << (t.promptEvalDurationNs / 1e9) << "s"
+            << " decode=" << (t.evalDurationNs / 1e9) << "s"
+            << " wall=" << t.wallSeconds << "s"
+            << " prefillTok/s=" << t.PrefillTokensPerSecond()
+            << " decodeTok/s=" << t.DecodeTokensPerSecond()
+            << " accepted=" << t.acceptedItems
+            << " genTok/item=" << t.GeneratedTokensPerAcceptedItem();
+        if (t.requestedItems > 0)
+        {
+            std::cout << std::setprecision(1)
+                << " yield=" << (t.ActualYield() * 100.0) << "%"
+                << " (predicted " << (t.PredictedYield() * 100.0) << "%, "
+                << t.usableItems << "/" << t.requestedItems << " requested)";
+        }
+        if (t.batches > 0)
+        {
+            std::cout << std::setprecision(0)
+                << " allocs/batch=" << t.AllocationsPerBatch()
+                << " (" << (t.batchAllocatedBytes / 1024.0 / t.batches) << " KB)";
+        }
+        if (t.repairCalls > 0)
+        {
+            std::cout << " repaired=" << t.repairedItems << "/" << t.repairSentItems
+                << " (" << t.repairCalls << " requests, " << t.repairPromptTokens << " promptTok)";
+        }
+        if (t.calls > t.callsWithServerStats)
+        {
+            std::cout << " (no server stats for " << (t.calls - t.callsWithServerStats) << " calls)";
+        }
+        std::cout << "\n";
+    }
+}
+
+double GenerationMetricsTotals::PrefillTokensPerSecond() const
+{
+    if (promptEvalDurationNs <= 0)
+        return 0.0;
+    return static_cast<double>(promptTokens) / (promptEvalDurationNs / 1e9);
+}
+
+double GenerationMetricsTotals::DecodeTokensPerSecond() const
+{
+    if (evalDurationNs <= 0)
+        return 0.0;
+    return static_cast<double>(generatedTokens) / (evalDurationNs / 1e9);
+}
+
+double GenerationMetricsTotals::GeneratedTokensPerAcceptedItem() const
+{
+    if (acceptedItems <= 0)
+        return 0.0;
+    return static_cast<double>(generatedTokens) / static_cast<double>(acceptedItems);
+}
+
+double GenerationMetricsTotals::ActualYield() const
+{
+    if (requestedItems <= 0)
+        return 0.0;
+    return static_cast<double>(usableItems) / static_cast<double>(requestedItems);
+}
+
+double GenerationMetricsTotals::PredictedYield() const
+{
+    if (requestedItems <= 0)
+        return 0.0;
+    return predictedUsableItems / static_cast<double>(requestedItems);
+}
+
+double GenerationMetricsTotals::AllocationsPerBatch() const
+{
+    if (batches <= 0)
+        return 0.0;
+    return static_cast<double>(batchAllocations) / static_cast<double>(batches);
+}
+
+void GenerationMetricsTotals::Add(const GenerationMetricsTotals& other)
+{
+    calls += other.calls;
+    callsWithServerStats += other.callsWithServerStats;
+    promptTokens += other.promptTokens;
+    generatedTokens += other.generatedTokens;
+    promptEvalDurationNs += other.promptEvalDurationNs;
+    evalDurationNs += other.evalDurationNs;
+    loadDurationNs += other.loadDurationNs;
+    wallSeconds += other.wallSeconds;
+    acceptedItems += other.acceptedItems;
+    requestedItems += other.requestedItems;
+    usableItems += other.usableItems;
+    predictedUsableItems += other.predictedUsableItems;
+    batches += other.batches;
+    batchAllocations += other.batchAllocations;
+    batchAllocatedBytes += other.batchAllocatedBytes;
+    repairCalls += other.repairCalls;
+    repairSentItems += other.repairSentItems;
+    repairedItems += other.repairedItems;
+    repairPromptTokens += other.repairPromptTokens;
+}
+
+void GenerationMetrics::RecordCall(const std::string& modelName,
+                                   const std::string& profileId,
+                                   const OllamaCallStats& stats)
+{
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    GenerationMetricsTotals& t = g_totals[MetricsKey(modelName, profileId)];
+    t.calls++;
+    t.wallSeconds += stats.wallSeconds;
+    if (stats.hasServerStats)
+    {
+        t.callsWithServerStats++;
+        t.promptTokens += stats.promptEvalCount;
+        t.generatedTokens += stats.evalCount;
+        t.promptEvalDurationNs += stats.promptEvalDurationNs;
+        t.evalDurationNs += stats.evalDurationNs;
+        t.loadDurationNs += stats.loadDurationNs;
+    }
+}
+
+void GenerationMetrics::RecordAcceptedItems(const std::string& modelName,
+                                            const std::string& profileId,
+                                            int count)
+{
+    if (count <= 0)
+        return;
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    g_totals[MetricsKey(modelName, profileId)].acceptedItems += count;
+}
+
+void GenerationMetrics::RecordYield(const std::string& modelName,
+                                   const std::string& profileId,
+                                   int requested,
+                                   double predictedYield,
+                                   int usable)
+{
+    if (requested <= 0)
+        return;
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    GenerationMetricsTotals& t = g_totals[MetricsKey(modelName, profileId)];
+    t.requestedItems += requested;
+    t.usableItems += std::min(usable, requested); // Models sometimes return more than asked
+    t.predictedUsableItems += requested * predictedYield;
+}
+
+void GenerationMetrics::RecordBatchAllocations(const std::string& modelName,
+                                               const std::string& profileId,
+                                               long long allocations,
+                                               long long allocatedBytes)
+{
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    GenerationMetricsTotals& t = g_totals[MetricsKey(modelName, profileId)];
+    t.batches++;
+    t.batchAllocations += allocations;
+    t.batchAllocatedBytes += allocatedBytes;
+}
+
+void GenerationMetrics::RecordRepair(const std::string& modelName,
+                                     const std::string& profileId,
+                                     int sent,
+                                     int repaired,
+                                     const OllamaCallStats& stats)
+{
+    RecordCall(modelName, profileId, stats);
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    GenerationMetricsTotals& t = g_totals[MetricsKey(modelName, profileId)];
+    t.repairCalls++;
+    t.repairSentItems += sent;
+    t.repairedItems += repaired;
+    if (stats.hasServerStats)
+        t.repairPromptTokens += stats.promptEvalCount;
+}
+
+GenerationMetricsTotals GenerationMetrics::GetTotals(const std::string& modelName,
+                                                     const std::string& profileId)
+{
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    auto it = g_totals.find(MetricsKey(modelName, profileId));
+    if (it == g_totals.end())
+        return GenerationMetricsTotals{};
+    return it->second;
+}
+
+void GenerationMetrics::PrintReport()
+{
+    std::map<std::string, GenerationMetricsTotals> byModel;
+    std::map<std::string, GenerationMetricsTotals> byProfile;
+    {
+        std::lock_guard<std::mutex> lock(g_totalsMutex);
+        for (const auto& [key, totals] : g_totals)
+        {
+            byModel[key.first].Add(totals);
+            byProfile[key.second].Add(totals);
+        }
+    }
+
+    if (byModel.empty())
+        return;
+
+    std::ios::fmtflags savedFlags = std::cout.flags();
+    std::streamsize savedPrecision = std::cout.precision();
+
+    for (const auto& [model, totals] : byModel)
+    {
+        PrintTotalsLine("model=" + model, totals);
+    }
+    for (const auto& [profile, totals] : byProfile)
+    {
+        PrintTotalsLine("profile=" + profile, totals);
+    }
+
+    std::cout.flags(savedFlags);
+    std::cout.precision(savedPrecision);
+}
+
+void GenerationMetrics::Reset()
+{
+    std::lock_guard<std::mutex> lock(g_totalsMutex);
+    g_totals.clear();
+}
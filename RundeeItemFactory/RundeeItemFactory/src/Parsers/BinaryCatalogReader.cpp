@@ -0,0 +1,141 @@
+/**
+ * @file BinaryCatalogReader.cpp
+ * @brief Implementation of the binary catalog reader
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Parsers/BinaryCatalogReader.h"
+#include "Writers/BinaryCatalogWriter.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace BinaryCatalogFormat;
+
+bool BinaryCatalogReader::Open(const std::string& path)
+{
+    Close();
+    m_file.open(path, std::ios::binary);
+    if (!m_file.is_open())
+        return false;
+
+    m_file.seekg(0, std::ios::end);
+    const std::streamoff fileSize = m_file.tellg();
+    char header[kHeaderSize];
+    char footer[kFooterSize];
+    if (fileSize < static_cast<std::streamoff>(kHeaderSize + kFooterSize) ||
+        !m_file.seekg(0).read(header, kHeaderSize) ||
+        !m_file.seekg(fileSize - static_cast<std::streamoff>(kFooterSize)).read(footer, kFooterSize) ||
+        std::memcmp(header, kHeaderMagic, 8) != 0 ||
+        std::memcmp(footer + 32, kFooterMagic, 8) != 0)
+    {
+        std::cerr << "[BinaryCatalogReader] Not a binary catalog: " << path << "\n";
+        Close();
+        return false;
+    }
+    if (GetLE<uint32_t>(header + 8) != kVersion)
+    {
+        std::cerr << "[BinaryCatalogReader] Unsupported catalog version in " << path << "\n";
+        Close();
+        return false;
+    }
+
+    const uint64_t indexOffset = GetLE<uint64_t>(footer);
+    const uint64_t poolOffset = GetLE<uint64_t>(footer + 8);
+    const uint64_t poolSize = GetLE<uint64_t>(footer + 16);
+    const uint64_t count = GetLE<uint64_t>(footer + 24);
+    const uint64_t footerOffset = static_cast<uint64_t>(fileSize) - kFooterSize;
+    // Bounded before multiplying or adding, so corrupt values cannot wrap around
+    if (indexOffset < kHeaderSize || indexOffset > footerOffset ||
+        count > (footerOffset - indexOffset) / kIndexEntrySize ||
+        indexOffset + count * kIndexEntrySize != poolOffset ||
+        poolSize != footerOffset - poolOffset)
+    {
+        std::cerr << "[BinaryCatalogReader] Corrupt index in " << path << "\n";
+        Close();
+        return false;
+    }
+
+    // Index and id pool only; records stay on disk until requested
+    std::string index(static_cast<size_t>(count * kIndexEntrySize), '\0');
+    m_idPool.assign(static_cast<size_t>(poolSize), '\0');
+    if ((count > 0 && !m_file.seekg(static_cast<std::streamoff>(indexOffset)).read(&index[0], index.size())) ||
+        (poolSize > 0 && !m_file.read(&m_idPool[0], m_idPool.size())))
+    {
+        std::cerr << "[BinaryCatalogReader] Failed to read index of " << path << "\n";
+        Close();
+        return false;
+    }
+
+    m_indexOffset = indexOffset;
+    m_entries.resize(static_cast<size_t>(count));
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+        const char* e = index.data() + i * kIndexEntrySize;
+        IndexEntry& entry = m_entries[i];
+        entry.recordOffset = GetLE<uint64_t>(e);
+        entry.idOffset = GetLE<uint64_t>(e + 8);
+        entry.idLength = GetLE<uint32_t>(e + 16);
+        entry.recordLength = GetLE<uint32_t>(e + 20);
+        if (entry.idOffset > poolSize || entry.idLength > poolSize - entry.idOffset ||
+            entry.recordOffset > indexOffset || entry.recordLength > indexOffset - entry.recordOffset)
+        {
+            std::cerr << "[BinaryCatalogReader] Corrupt index entry " << i << " in " << path << "\n";
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void BinaryCatalogReader::Close()
+{
+    if (m_file.is_open())
+        m_file.close();
+    m_file.clear();
+    m_entries.clear();
+    m_idPool.clear();
+    m_indexOffset = 0;
+}
+
+std::string BinaryCatalogReader::GetId(size_t index) const
+{
+    const IndexEntry& entry = m_entries[index];
+    return m_idPool.substr(static_cast<size_t>(entry.idOffset), entry.idLength);
+}
+
+bool BinaryCatalogReader::Find(const std::string& id, nlohmann::json& outItem)
+{
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), id,
+        [this](const IndexEntry& entry, const std::string& key)
+        {
+            return m_idPool.compare(static_cast<size_t>(entry.idOffset), entry.idLength, key) < 0;
+        });
+    if (it == m_entries.end() || m_idPool.compare(static_cast<size_t>(it->idOffset), it->idLength, id) != 0)
+        return false;
+
+    std::string record;
+    if (!ReadRecord(static_cast<size_t>(it - m_entries.begin()), record))
+        return false;
+    outItem = nlohmann::json::from_msgpack(record, true, false);
+    return !outItem.is_discarded();
+}
+
+bool BinaryCatalogReader::ReadRecord(size_t index, std::string& outRecord)
+{
+    const IndexEntry& entry = m_entries[index];
+    outRecord.resize(entry.recordLength);
+    m_file.clear();
+    return entry.recordLength == 0 ||
+        static_cast<bool>(m_file.seekg(static_cast<std::streamoff>(entry.recordOffset)).read(&outRecord[0], entry.recordLength));
+}
+
+bool BinaryCatalogReader::ReadRecordSection(std::string& outBytes)
+{
+    outBytes.resize(static_cast<size_t>(m_indexOffset - kHeaderSize));
+    m_file.clear();
+    return outBytes.empty() ||
+        static_cast<bool>(m_file.seekg(static_cast<std::streamoff>(kHeaderSize)).read(&outBytes[0], outBytes.size()));
+}
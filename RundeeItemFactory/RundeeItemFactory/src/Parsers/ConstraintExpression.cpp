@@ -0,0 +1,711 @@
+/**
+ * @file ConstraintExpression.cpp
+ * @brief Implementation of the constraint expression compiler and evaluator
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Parsers/ConstraintExpression.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+    /** @brief Most distinct fields one expression may read */
+    const size_t kMaxFields = 16;
+
+    /** @brief Deepest evaluation stack one expression may need */
+    const int kMaxStack = 32;
+
+    /** @brief Deepest nesting of parentheses, unary operators and calls the parser recurses into */
+    const int kMaxNesting = 64;
+
+    /** @brief Most numbers or strings one expression may hold (the operand is 16 bits) */
+    const size_t kMaxConstants = 65535;
+
+    /** @brief Longest field value quoted in an error message */
+    const size_t kMaxDescribedValueLength = 40;
+
+    enum class Function : uint16_t
+    {
+        Min, Max, Abs, Floor, Ceil, Round, Len
+    };
+
+    struct FunctionInfo
+    {
+        const char* name;
+        Function id;
+        int minArgs;
+        int maxArgs;
+    };
+
+    const FunctionInfo kFunctions[] = {
+        { "min", Function::Min, 1, 255 },
+        { "max", Function::Max, 1, 255 },
+        { "abs", Function::Abs, 1, 1 },
+        { "floor", Function::Floor, 1, 1 },
+        { "ceil", Function::Ceil, 1, 1 },
+        { "round", Function::Round, 1, 1 },
+        { "len", Function::Len, 1, 1 },
+    };
+
+    /**
+     * @struct Value
+     * @brief Evaluation stack entry; strings point into the item or the program
+     */
+    struct Value
+    {
+        enum class Type : uint8_t
+        {
+            Missing, Number, Bool, String, Collection
+        };
+
+        Type type = Type::Missing;
+        double number = 0.0;        ///< Number, bool (0/1) or collection size
+        const std::string* text = nullptr;
+
+        static Value Number(double n) { Value v; v.type = Type::Number; v.number = n; return v; }
+        static Value Bool(bool b) { Value v; v.type = Type::Bool; v.number = b ? 1.0 : 0.0; return v; }
+    };
+
+    Value LoadValue(const nlohmann::json& item, const std::string& name)
+    {
+        Value v;
+        auto it = item.find(name);
+        if (it == item.end())
+            return v;
+        if (it->is_number())
+            return Value::Number(it->get<double>());
+        if (it->is_boolean())
+            return Value::Bool(it->get<bool>());
+        if (it->is_string())
+        {
+            v.type = Value::Type::String;
+            v.text = &it->get_ref<const std::string&>();
+        }
+        else if (it->is_array() || it->is_object())
+        {
+            v.type = Value::Type::Collection;
+            v.number = static_cast<double>(it->size());
+        }
+        return v;
+    }
+
+    /** @brief -1/0/1 ordering of two values, or false if they cannot be ordered */
+    bool CompareValues(const Value& a, const Value& b, int& outOrder)
+    {
+        if (a.type == Value::Type::Number && b.type == Value::Type::Number)
+        {
+            outOrder = (a.number < b.number) ? -1 : (a.number > b.number ? 1 : 0);
+            return true;
+        }
+        if (a.type == Value::Type::String && b.type == Value::Type::String)
+        {
+            const int c = a.text->compare(*b.text);
+            outOrder = (c < 0) ? -1 : (c > 0 ? 1 : 0);
+            return true;
+        }
+        if (a.type == Value::Type::Bool && b.type == Value::Type::Bool)
+        {
+            outOrder = static_cast<int>(a.number) - static_cast<int>(b.number);
+            return true;
+        }
+        return false;
+    }
+}
+
+/**
+ * @class ConstraintCompiler
+ * @brief Recursive-descent parser that emits postfix bytecode
+ */
+class ConstraintCompiler
+{
+public:
+    ConstraintCompiler(ConstraintExpression& target, const std::string& text, const std::string& selfField)
+        : m_target(target)
+        , m_text(text)
+        , m_selfField(selfField)
+    {
+    }
+
+    bool Run(std::string& outError)
+    {
+        Next();
+        const Kind kind = ParseOr();
+        if (!m_failed && m_token.kind != TokenKind::End)
+            Fail("unexpected '" + m_token.text + "'");
+        if (!m_failed && kind != Kind::Boolean)
+            Fail("expression does not compare anything");
+        if (m_failed)
+        {
+            outError = m_error;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    using Op = ConstraintExpression::Op;
+
+    /** @brief Static result type of a subexpression */
+    enum class Kind
+    {
+        Boolean, Value
+    };
+
+    enum class TokenKind
+    {
+        End, Number, String, Identifier, Symbol
+    };
+
+    struct Token
+    {
+        TokenKind kind = TokenKind::End;
+        std::string text;
+        double number = 0.0;
+    };
+
+    void Fail(const std::string& message)
+    {
+        if (!m_failed)
+            m_error = message + " at position " + std::to_string(m_tokenStart + 1);
+        m_failed = true;
+        m_token.kind = TokenKind::End; // Stop consuming input
+    }
+
+    void Next()
+    {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos])))
+            ++m_pos;
+        m_tokenStart = m_pos;
+        m_token = Token();
+        if (m_pos >= m_text.size())
+            return;
+
+        const char c = m_text[m_pos];
+        if (std::isdigit(static_cast<unsigned char>(c)) || (c == '.' && m_pos + 1 < m_text.size() &&
+            std::isdigit(static_cast<unsigned char>(m_text[m_pos + 1]))))
+        {
+            char* end = nullptr;
+            m_token.number = std::strtod(m_text.c_str() + m_pos, &end);
+            const size_t length = static_cast<size_t>(end - (m_text.c_str() + m_pos));
+            m_token.kind = TokenKind::Number;
+            m_token.text = m_text.substr(m_pos, length);
+            m_pos += length;
+            return;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+        {
+            const size_t begin = m_pos;
+            while (m_pos < m_text.size() &&
+                   (std::isalnum(static_cast<unsigned char>(m_text[m_pos])) || m_text[m_pos] == '_'))
+                ++m_pos;
+            m_token.kind = TokenKind::Identifier;
+            m_token.text = m_text.substr(begin, m_pos - begin);
+            return;
+        }
+        if (c == '\'' || c == '"')
+        {
+            const size_t close = m_text.find(c, m_pos + 1);
+            if (close == std::string::npos)
+            {
+                Fail("unterminated string");
+                return;
+            }
+            m_token.kind = TokenKind::String;
+            m_token.text = m_text.substr(m_pos + 1, close - m_pos - 1);
+            m_pos = close + 1;
+            return;
+        }
+
+        static const char* const kTwoCharSymbols[] = { "==", "!=", "<=", ">=", "&&", "||" };
+        for (const char* symbol : kTwoCharSymbols)
+        {
+            if (m_text.compare(m_pos, 2, symbol) == 0)
+            {
+                m_token.kind = TokenKind::Symbol;
+                m_token.text = symbol;
+                m_pos += 2;
+                return;
+            }
+        }
+        if (std::string("+-*/%<>=!(),").find(c) != std::string::npos)
+        {
+            m_token.kind = TokenKind::Symbol;
+            m_token.text = (c == '=') ? "==" : std::string(1, c);
+            ++m_pos;
+            return;
+        }
+        m_token.text = std::string(1, c);
+        Fail("unexpected '" + m_token.text + "'");
+    }
+
+    /** @brief Consume the current token if it is the given symbol or keyword */
+    bool Accept(const char* symbol, const char* keyword = nullptr)
+    {
+        const bool isSymbol = m_token.kind == TokenKind::Symbol && m_token.text == symbol;
+        const bool isKeyword = keyword && m_token.kind == TokenKind::Identifier && m_token.text == keyword;
+        if (!isSymbol && !isKeyword)
+            return false;
+        Next();
+        return true;
+    }
+
+    void Emit(Op op, size_t operand = 0, int argCount = 0)
+    {
+        switch (op)
+        {
+            case Op::PushNumber:
+            case Op::PushString:
+            case Op::PushBool:
+            case Op::LoadField:
+                ++m_depth;
+                break;
+            case Op::Negate:
+            case Op::Not:
+                break;
+            case Op::Call:
+                m_depth -= argCount - 1;
+                break;
+            default:
+                --m_depth; // Binary operators
+                break;
+        }
+        if (m_depth > kMaxStack)
+            Fail("expression is too deeply nested");
+        m_target.m_code.push_back({ op, static_cast<uint8_t>(argCount), static_cast<uint16_t>(operand) });
+    }
+
+    Kind ParseOr()
+    {
+        Kind kind = ParseAnd();
+        while (!m_failed && Accept("||", "or"))
+        {
+            ParseAnd();
+            Emit(Op::Or);
+            kind = Kind::Boolean;
+        }
+        return kind;
+    }
+
+    Kind ParseAnd()
+    {
+        Kind kind = ParseCompare();
+        while (!m_failed && Accept("&&", "and"))
+        {
+            ParseCompare();
+            Emit(Op::And);
+            kind = Kind::Boolean;
+        }
+        return kind;
+    }
+
+    Kind ParseCompare()
+    {
+        Kind kind = ParseSum();
+        static const std::pair<const char*, Op> kComparisons[] = {
+            { "==", Op::Equal }, { "!=", Op::NotEqual }, { "<=", Op::LessEqual },
+            { ">=", Op::GreaterEqual }, { "<", Op::Less }, { ">", Op::Greater }
+        };
+        for (const auto& comparison : kComparisons)
+        {
+            if (!m_failed && Accept(comparison.first))
+            {
+                ParseSum();
+                Emit(comparison.second);
+                return Kind::Boolean;
+            }
+        }
+        return kind;
+    }
+
+    Kind ParseSum()
+    {
+        Kind kind = ParseProduct();
+        while (!m_failed)
+        {
+            Op op;
+            if (Accept("+"))
+                op = Op::Add;
+            else if (Accept("-"))
+                op = Op::Subtract;
+            else
+                break;
+            ParseProduct();
+            Emit(op);
+            kind = Kind::Value;
+        }
+        return kind;
+    }
+
+    Kind ParseProduct()
+    {
+        Kind kind = ParseUnary();
+        while (!m_failed)
+        {
+            Op op;
+            if (Accept("*"))
+                op = Op::Multiply;
+            else if (Accept("/"))
+                op = Op::Divide;
+            else if (Accept("%"))
+                op = Op::Modulo;
+            else
+                break;
+            ParseUnary();
+            Emit(op);
+            kind = Kind::Value;
+        }
+        return kind;
+    }
+
+    Kind ParseUnary()
+    {
+        // Every level of recursion passes through here, so this bounds the parser's own stack
+        if (m_nesting >= kMaxNesting)
+        {
+            Fail("expression is too deeply nested");
+            return Kind::Value;
+        }
+        ++m_nesting;
+        Kind kind;
+        if (Accept("-"))
+        {
+            ParseUnary();
+            Emit(Op::Negate);
+            kind = Kind::Value;
+        }
+        else if (Accept("!", "not"))
+        {
+            ParseUnary();
+            Emit(Op::Not);
+            kind = Kind::Boolean;
+        }
+        else
+        {
+            kind = ParsePrimary();
+        }
+        --m_nesting;
+        return kind;
+    }
+
+    /** @brief Fail once a constant pool is full, before its index would wrap the operand */
+    bool HasConstantRoom(size_t poolSize)
+    {
+        if (poolSize < kMaxConstants)
+            return true;
+        Fail("too many constants");
+        return false;
+    }
+
+    Kind ParsePrimary()
+    {
+        if (m_failed)
+            return Kind::Value;
+
+        const Token token = m_token;
+        switch (token.kind)
+        {
+            case TokenKind::Number:
+                if (!HasConstantRoom(m_target.m_numbers.size()))
+                    return Kind::Value;
+                Next();
+                Emit(Op::PushNumber, m_target.m_numbers.size());
+                m_target.m_numbers.push_back(token.number);
+                return Kind::Value;
+
+            case TokenKind::String:
+                if (!HasConstantRoom(m_target.m_strings.size()))
+                    return Kind::Value;
+                Next();
+                Emit(Op::PushString, m_target.m_strings.size());
+                m_target.m_strings.push_back(token.text);
+                return Kind::Value;
+
+            case TokenKind::Symbol:
+                if (Accept("("))
+                {
+                    const Kind kind = ParseOr();
+                    if (!m_failed && !Accept(")"))
+                        Fail("expected ')'");
+                    return kind;
+                }
+                Fail("unexpected '" + token.text + "'");
+                return Kind::Value;
+
+            case TokenKind::End:
+                Fail("unexpected end of expression");
+                return Kind::Value;
+
+            case TokenKind::Identifier:
+                break;
+        }
+
+        Next();
+        if (token.text == "true" || token.text == "false")
+        {
+            Emit(Op::PushBool, token.text == "true" ? 1 : 0);
+            return Kind::Boolean;
+        }
+        if (Accept("("))
+            return ParseCall(token.text);
+
+        const std::string& field = (token.text == "value" && !m_selfField.empty()) ? m_selfField : token.text;
+        auto& fields = m_target.m_fields;
+        size_t slot = 0;
+        while (slot < fields.size() && fields[slot] != field)
+            ++slot;
+        if (slot == fields.size())
+        {
+            if (fields.size() >= kMaxFields)
+            {
+                Fail("too many fields");
+                return Kind::Value;
+            }
+            fields.push_back(field);
+        }
+        Emit(Op::LoadField, slot);
+        return Kind::Value;
+    }
+
+    Kind ParseCall(const std::string& name)
+    {
+        const FunctionInfo* function = nullptr;
+        for (const auto& candidate : kFunctions)
+        {
+            if (name == candidate.name)
+                function = &candidate;
+        }
+        if (!function)
+        {
+            Fail("unknown function '" + name + "'");
+            return Kind::Value;
+        }
+
+        int argCount = 0;
+        if (!Accept(")"))
+        {
+            do
+            {
+                ParseOr();
+                ++argCount;
+            } while (!m_failed && Accept(","));
+            if (!m_failed && !Accept(")"))
+                Fail("expected ')' after the arguments of " + name);
+        }
+        if (!m_failed && (argCount < function->minArgs || argCount > function->maxArgs))
+            Fail(name + "() takes " + std::to_string(function->minArgs) +
+                 (function->maxArgs > function->minArgs ? " or more" : "") + " argument(s)");
+        if (!m_failed)
+            Emit(Op::Call, static_cast<size_t>(function->id), argCount);
+        return Kind::Value;
+    }
+
+    ConstraintExpression& m_target;
+    const std::string& m_text;
+    const std::string& m_selfField;
+    size_t m_pos = 0;
+    size_t m_tokenStart = 0;
+    Token m_token;
+    bool m_failed = false;
+    std::string m_error;
+    int m_depth = 0;
+    int m_nesting = 0;
+};
+
+bool ConstraintExpression::Compile(const std::string& text, const std::string& selfField, std::string* outError)
+{
+    *this = ConstraintExpression();
+    m_text = text;
+    std::string error;
+    if (!ConstraintCompiler(*this, text, selfField).Run(error))
+    {
+        m_code.clear();
+        if (outError)
+            *outError = error;
+        return false;
+    }
+    return true;
+}
+
+ConstraintExpression::Result ConstraintExpression::Evaluate(const nlohmann::json& item) const
+{
+    if (m_code.empty() || !item.is_object())
+        return Result::NotApplicable;
+
+    Value slots[kMaxFields];
+    for (size_t i = 0; i < m_fields.size(); ++i)
+        slots[i] = LoadValue(item, m_fields[i]);
+
+    Value stack[kMaxStack];
+    int top = -1;
+    for (const Instruction& instruction : m_code)
+    {
+        switch (instruction.op)
+        {
+            case Op::PushNumber:
+                stack[++top] = Value::Number(m_numbers[instruction.operand]);
+                break;
+            case Op::PushString:
+                stack[++top] = Value();
+                stack[top].type = Value::Type::String;
+                stack[top].text = &m_strings[instruction.operand];
+                break;
+            case Op::PushBool:
+                stack[++top] = Value::Bool(instruction.operand != 0);
+                break;
+            case Op::LoadField:
+                stack[++top] = slots[instruction.operand];
+                break;
+
+            case Op::Negate:
+                stack[top] = (stack[top].type == Value::Type::Number) ? Value::Number(-stack[top].number) : Value();
+                break;
+            case Op::Not:
+                stack[top] = (stack[top].type == Value::Type::Bool) ? Value::Bool(stack[top].number == 0.0) : Value();
+                break;
+
+            case Op::Add:
+            case Op::Subtract:
+            case Op::Multiply:
+            case Op::Divide:
+            case Op::Modulo:
+            {
+                const Value b = stack[top--];
+                Value& a = stack[top];
+                if (a.type != Value::Type::Number || b.type != Value::Type::Number)
+                {
+                    a = Value();
+                    break;
+                }
+                switch (instruction.op)
+                {
+                    case Op::Add:      a.number += b.number; break;
+                    case Op::Subtract: a.number -= b.number; break;
+                    case Op::Multiply: a.number *= b.number; break;
+                    case Op::Divide:
+                        a = (b.number == 0.0) ? Value() : Value::Number(a.number / b.number);
+                        break;
+                    default:
+                        a = (b.number == 0.0) ? Value() : Value::Number(std::fmod(a.number, b.number));
+                        break;
+                }
+                break;
+            }
+
+            case Op::Equal:
+            case Op::NotEqual:
+            case Op::Less:
+            case Op::LessEqual:
+            case Op::Greater:
+            case Op::GreaterEqual:
+            {
+                const Value b = stack[top--];
+                Value& a = stack[top];
+                int order = 0;
+                if (!CompareValues(a, b, order))
+                {
+                    a = Value();
+                    break;
+                }
+                bool holds = false;
+                switch (instruction.op)
+                {
+                    case Op::Equal:     holds = order == 0; break;
+                    case Op::NotEqual:  holds = order != 0; break;
+                    case Op::Less:      holds = order < 0; break;
+                    case Op::LessEqual: holds = order <= 0; break;
+                    case Op::Greater:   holds = order > 0; break;
+                    default:            holds = order >= 0; break;
+                }
+                a = Value::Bool(holds);
+                break;
+            }
+
+            case Op::And:
+            case Op::Or:
+            {
+                // Three-valued: a known false (and) or true (or) decides even if the other side is missing
+                const Value b = stack[top--];
+                Value& a = stack[top];
+                const bool decisive = (instruction.op == Op::Or);
+                const bool aKnown = a.type == Value::Type::Bool;
+                const bool bKnown = b.type == Value::Type::Bool;
+                if ((aKnown && (a.number != 0.0) == decisive) || (bKnown && (b.number != 0.0) == decisive))
+                    a = Value::Bool(decisive);
+                else if (aKnown && bKnown)
+                    a = Value::Bool(!decisive);
+                else
+                    a = Value();
+                break;
+            }
+
+            case Op::Call:
+            {
+                const int argCount = instruction.argCount;
+                Value* args = &stack[top - argCount + 1];
+                Value result;
+                const Function function = static_cast<Function>(instruction.operand);
+                if (function == Function::Len)
+                {
+                    if (args[0].type == Value::Type::String)
+                        result = Value::Number(static_cast<double>(args[0].text->size()));
+                    else if (args[0].type == Value::Type::Collection)
+                        result = Value::Number(args[0].number);
+                }
+                else
+                {
+                    bool numeric = true;
+                    for (int i = 0; i < argCount; ++i)
+                        numeric = numeric && args[i].type == Value::Type::Number;
+                    if (numeric)
+                    {
+                        double n = args[0].number;
+                        switch (function)
+                        {
+                            case Function::Min:
+                                for (int i = 1; i < argCount; ++i)
+                                    n = std::min(n, args[i].number);
+                                break;
+                            case Function::Max:
+                                for (int i = 1; i < argCount; ++i)
+                                    n = std::max(n, args[i].number);
+                                break;
+                            case Function::Abs:   n = std::fabs(n); break;
+                            case Function::Floor: n = std::floor(n); break;
+                            case Function::Ceil:  n = std::ceil(n); break;
+                            default:              n = std::round(n); break;
+                        }
+                        result = Value::Number(n);
+                    }
+                }
+                top -= argCount - 1;
+                stack[top] = result;
+                break;
+            }
+        }
+    }
+
+    if (top != 0 || stack[0].type != Value::Type::Bool)
+        return Result::NotApplicable;
+    return stack[0].number != 0.0 ? Result::Pass : Result::Fail;
+}
+
+std::string ConstraintExpression::DescribeValues(const nlohmann::json& item) const
+{
+    std::string description;
+    for (const auto& field : m_fields)
+    {
+        if (!description.empty())
+            description += ", ";
+        auto it = item.is_object() ? item.find(field) : item.end();
+        std::string value = (it == item.end()) ? std::string("missing") : it->dump();
+        if (value.size() > kMaxDescribedValueLength)
+            value = value.substr(0, kMaxDescribedValueLength) + "...";
+        description += field + "=" + value;
+    }
+    return description;
+}
@@ -7,24 +7,79 @@
  */
 
 #include "Parsers/DynamicItemJsonParser.h"
+#include "Parsers/IdShortener.h"
+#include "Parsers/ProfileConstraints.h"
 #include "Utils/StringUtils.h"
+#include "Utils/JsonRepair.h"
 #include "Utils/JsonUtils.h"
+#include "Utils/BatchArena.h"
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <cctype>
-#include <map>
 #include <vector>
 
 using nlohmann::json;
 
+namespace
+{
+    /**
+     * @brief Copy an arena-backed value into a heap json that outlives the batch
+     * @param value Parsed value (lives in the current BatchArena)
+     * @return Equivalent nlohmann::json
+     */
+    json ToHeapJson(const ArenaJson& value)
+    {
+        switch (value.type())
+        {
+        case ArenaJson::value_t::object:
+        {
+            json out = json::object();
+            for (auto it = value.begin(); it != value.end(); ++it)
+            {
+                out.emplace(std::string(it.key().data(), it.key().size()), ToHeapJson(it.value()));
+            }
+            return out;
+        }
+        case ArenaJson::value_t::array:
+        {
+            json out = json::array();
+            out.get_ref<json::array_t&>().reserve(value.size());
+            for (const auto& element : value)
+            {
+                out.push_back(ToHeapJson(element));
+            }
+            return out;
+        }
+        case ArenaJson::value_t::string:
+        {
+            const ArenaString& str = value.get_ref<const ArenaString&>();
+            return json(std::string(str.data(), str.size()));
+        }
+        case ArenaJson::value_t::boolean:
+            return json(value.get<bool>());
+        case ArenaJson::value_t::number_integer:
+            return json(value.get<std::int64_t>());
+        case ArenaJson::value_t::number_unsigned:
+            return json(value.get<std::uint64_t>());
+        case ArenaJson::value_t::number_float:
+            return json(value.get<double>());
+        default:
+            return json();
+        }
+    }
+}
+
 bool DynamicItemJsonParser::ParseItemsFromJsonText(
     const std::string& jsonText,
     const ItemProfile& profile,
-    std::vector<nlohmann::json>& outItems)
+    std::vector<nlohmann::json>& outItems,
+    std::vector<RejectedItem>* outRejected)
 {
     outItems.clear();
+    if (outRejected)
+        outRejected->clear();
     
     // Check for empty input
     if (jsonText.empty() || jsonText.find_first_not_of(" \t\r\n") == std::string::npos)
@@ -33,8 +88,11 @@ bool DynamicItemJsonParser::ParseItemsFromJsonText(
         return false;
     }
     
-    // Clean LLM response string
-    std::string cleaned = StringUtils::CleanJsonArrayText(jsonText);
+    // Repair the LLM response in one pass (prose, commas, unclosed brackets)
+    JsonRepair::RepairReport repair;
+    std::string cleaned = JsonRepair::RepairJsonText(jsonText, &repair);
+    if (repair.Changed())
+        std::cout << "[DynamicItemJsonParser] Repaired response: " << repair.Summary() << "\n";
     
     if (cleaned.empty() || cleaned.find_first_not_of(" \t\r\n") == std::string::npos)
     {
@@ -42,12 +100,16 @@ bool DynamicItemJsonParser::ParseItemsFromJsonText(
         return false;
     }
     
-    json root;
+    // The DOM and the lexer's token buffer live in a per-batch arena that is
+    // freed in one go; declared before root so root is destroyed first
+    BatchArena arena;
+    BatchArena::Scope arenaScope(arena);
+    ArenaJson root;
     try
     {
-        root = json::parse(cleaned);
+        root = ArenaJson::parse(cleaned);
     }
-    catch (const json::parse_error& e)
+    catch (const ArenaJson::parse_error& e)
     {
         std::cerr << "[DynamicItemJsonParser] JSON parse error (position " << e.byte << "): "
             << e.what() << "\n";
@@ -72,35 +134,47 @@ bool DynamicItemJsonParser::ParseItemsFromJsonText(
     }
     
     // Parse each item
+    const std::shared_ptr<const IdShortener> shortener = IdShortener::ForProfile(profile);
+    const std::shared_ptr<const ProfileConstraints> constraints = ProfileConstraints::ForProfile(profile);
+    outItems.reserve(root.size());
     for (size_t i = 0; i < root.size(); ++i)
     {
-        const json& jItem = root[i];
+        const ArenaJson& jItem = root[i];
         if (!jItem.is_object())
         {
             std::cerr << "[DynamicItemJsonParser] Element " << i << " is not an object.\n";
             continue;
         }
         
-        // Apply defaults from profile
-        json item = jItem;
+        // Items outlive the batch, so this is the one copy out of the arena
+        json item = ToHeapJson(jItem);
         ApplyDefaults(item, profile);
         
         // Ensure id and displayName are always present (generate if missing)
-        EnsureIdAndDisplayName(item, profile, i);
+        EnsureIdAndDisplayName(item, profile, *shortener, i);
         
         // Validate item
         std::vector<std::string> errors;
-        if (!ValidateItem(item, profile, errors))
+        std::vector<std::string> invalidFields;
+        if (!ValidateItem(item, profile, errors, &invalidFields, constraints.get()))
         {
             std::cerr << "[DynamicItemJsonParser] Item at index " << i << " validation failed:\n";
             for (const auto& error : errors)
             {
                 std::cerr << "  - " << error << "\n";
             }
+            if (outRejected)
+            {
+                RejectedItem rejected;
+                rejected.item = std::move(item);
+                rejected.errors = std::move(errors);
+                rejected.invalidFields = std::move(invalidFields);
+                outRejected->push_back(std::move(rejected));
+            }
             continue;
         }
         
-        outItems.push_back(item);
+        outItems.push_back(std::move(item));
     }
     
     std::cout << "[DynamicItemJsonParser] Parsed " << outItems.size()
@@ -112,9 +186,13 @@ bool DynamicItemJsonParser::ParseItemsFromJsonText(
 bool DynamicItemJsonParser::ValidateItem(
     const nlohmann::json& item,
     const ItemProfile& profile,
-    std::vector<std::string>& errors)
+    std::vector<std::string>& errors,
+    std::vector<std::string>* outInvalidFields,
+    const ProfileConstraints* constraints)
 {
     errors.clear();
+    if (outInvalidFields)
+        outInvalidFields->clear();
     
     if (!item.is_object())
     {
@@ -125,25 +203,37 @@ bool DynamicItemJsonParser::ValidateItem(
     // Check required fields
     for (const auto& field : profile.fields)
     {
+        const size_t errorCount = errors.size();
         if (field.validation.isRequired)
         {
             if (!item.contains(field.name) || item[field.name].is_null())
             {
                 errors.push_back("Required field '" + field.name + "' is missing");
-                continue;
             }
         }
         
         // Validate field value if present
-        if (item.contains(field.name))
+        if (errors.size() == errorCount && item.contains(field.name))
         {
             if (!ValidateFieldValue(item[field.name], field, errors))
             {
                 // Error messages are added in ValidateFieldValue
             }
         }
+        
+        if (outInvalidFields && errors.size() > errorCount)
+            outInvalidFields->push_back(field.name);
     }
     
+    // Relationship and custom constraints; fields that are missing or mistyped are skipped
+    std::shared_ptr<const ProfileConstraints> cached;
+    if (!constraints)
+    {
+        cached = ProfileConstraints::ForProfile(profile);
+        constraints = cached.get();
+    }
+    constraints->Check(item, errors, outInvalidFields);
+    
     // Check for unknown fields (optional - can be disabled if desired)
     // for (const auto& [key, value] : item.items())
     // {
@@ -328,18 +418,14 @@ std::string DynamicItemJsonParser::CleanJsonText(const std::string& jsonText)
 void DynamicItemJsonParser::EnsureIdAndDisplayName(
     nlohmann::json& item,
     const ItemProfile& profile,
+    const IdShortener& shortener,
     size_t index)
 {
-    // Generate item type prefix (lowercase, no spaces)
-    std::string itemTypePrefix = profile.itemTypeName;
-    std::transform(itemTypePrefix.begin(), itemTypePrefix.end(), itemTypePrefix.begin(), ::tolower);
-    // Remove spaces and special characters
-    itemTypePrefix.erase(std::remove_if(itemTypePrefix.begin(), itemTypePrefix.end(),
-        [](char c) { return !std::isalnum(c); }), itemTypePrefix.end());
+    const std::string itemTypePrefix = GetIdPrefix(profile);
     
     // Ensure displayName field exists first (needed for ID generation)
     if (!item.contains("displayName") || item["displayName"].is_null() ||
-        (item["displayName"].is_string() && item["displayName"].get<std::string>().empty()))
+        (item["displayName"].is_string() && item["displayName"].get_ref<const std::string&>().empty()))
     {
         // Try to generate from other fields that might contain a name
         std::string displayName;
@@ -350,7 +436,7 @@ void DynamicItemJsonParser::EnsureIdAndDisplayName(
         {
             if (item.contains(nameField) && item[nameField].is_string())
             {
-                displayName = item[nameField].get<std::string>();
+                displayName = item[nameField].get_ref<const std::string&>();
                 break;
             }
         }
@@ -361,17 +447,17 @@ void DynamicItemJsonParser::EnsureIdAndDisplayName(
             displayName = profile.itemTypeName + " Item " + std::to_string(index + 1);
         }
         
-        item["displayName"] = displayName;
+        item["displayName"] = std::move(displayName);
     }
     
     // ALWAYS generate ID from displayName (ignore LLM-generated ID to ensure consistency)
     if (item.contains("displayName") && item["displayName"].is_string())
     {
-        std::string displayName = item["displayName"].get<std::string>();
+        const std::string& displayName = item["displayName"].get_ref<const std::string&>();
         if (!displayName.empty())
         {
             // Generate ID from displayName - extract key identifiers only
-            std::string idSuffix = GenerateShortIdFromDisplayName(displayName);
+            std::string idSuffix = shortener.Shorten(displayName);
             
             // Limit length to avoid too long IDs (max 30 chars for suffix)
             if (idSuffix.length() > 30)
@@ -393,7 +479,7 @@ void DynamicItemJsonParser::EnsureIdAndDisplayName(
     
     // Fallback: if displayName is not available, generate from index
     if (!item.contains("id") || item["id"].is_null() || 
-        (item["id"].is_string() && item["id"].get<std::string>().empty()))
+        (item["id"].is_string() && item["id"].get_ref<const std::string&>().empty()))
     {
         std::ostringstream idStream;
         idStream << itemTypePrefix << "_" << std::setfill('0') << std::setw(3) << (index + 1);
@@ -401,93 +487,22 @@ void DynamicItemJsonParser::EnsureIdAndDisplayName(
     }
 }
 
+std::string DynamicItemJsonParser::GetIdPrefix(const ItemProfile& profile)
+{
+    // Lowercase, no spaces or special characters
+    std::string itemTypePrefix = profile.itemTypeName;
+    std::transform(itemTypePrefix.begin(), itemTypePrefix.end(), itemTypePrefix.begin(), ::tolower);
+    itemTypePrefix.erase(std::remove_if(itemTypePrefix.begin(), itemTypePrefix.end(),
+        [](char c) { return !std::isalnum(c); }), itemTypePrefix.end());
+    return itemTypePrefix;
+}
+
 std::string DynamicItemJsonParser::GenerateShortIdFromDisplayName(const std::string& displayName)
 {
-    // Common words to remove (generic descriptors)
-    std::vector<std::string> commonWords = {
-        "enhanced", "advanced", "professional", "premium", "standard", "basic",
-        "deluxe", "ultimate", "superior", "elite", "master", "expert",
-        "semiautomatic", "automatic", "semi-auto", "full-auto",
-        "assault", "rifle", "pistol", "carbine", "shotgun", "sniper",
-        "model", "mk", "mark", "version", "ver", "v", "edition", "ed",
-        "lever-action", "bolt-action", "pump-action", "action"
-    };
-    
-    // Manufacturer abbreviations
-    std::map<std::string, std::string> manufacturerAbbrevs = {
-        {"heckler", "hk"}, {"koch", ""}, {"&", ""}, {"and", ""},
-        {"colt", "colt"}, {"sig", "sig"}, {"sauer", ""},
-        {"winchester", "win"}, {"remington", "rem"},
-        {"fn", "fn"}, {"herstal", ""},
-        {"glock", "glock"}, {"beretta", "ber"}, {"smith", "sw"}, {"wesson", ""}
-    };
-    
-    std::string result = displayName;
-    
-    // Convert to lowercase
-    std::transform(result.begin(), result.end(), result.begin(), ::tolower);
-    
-    // Remove common words
-    for (const auto& word : commonWords)
-    {
-        size_t pos = 0;
-        while ((pos = result.find(word, pos)) != std::string::npos)
-        {
-            // Check if it's a whole word (surrounded by non-alphanumeric or at boundaries)
-            bool isWholeWord = true;
-            if (pos > 0 && std::isalnum(result[pos - 1]))
-                isWholeWord = false;
-            if (pos + word.length() < result.length() && std::isalnum(result[pos + word.length()]))
-                isWholeWord = false;
-            
-            if (isWholeWord)
-            {
-                result.erase(pos, word.length());
-                // Remove following space/hyphen if exists
-                if (pos < result.length() && (result[pos] == ' ' || result[pos] == '-'))
-                    result.erase(pos, 1);
-            }
-            else
-            {
-                pos += word.length();
-            }
-        }
-    }
-    
-    // Apply manufacturer abbreviations
-    for (const auto& [full, abbrev] : manufacturerAbbrevs)
-    {
-        size_t pos = 0;
-        while ((pos = result.find(full, pos)) != std::string::npos)
-        {
-            bool isWholeWord = true;
-            if (pos > 0 && std::isalnum(result[pos - 1]))
-                isWholeWord = false;
-            if (pos + full.length() < result.length() && std::isalnum(result[pos + full.length()]))
-                isWholeWord = false;
-            
-            if (isWholeWord)
-            {
-                result.erase(pos, full.length());
-                if (!abbrev.empty())
-                {
-                    result.insert(pos, abbrev);
-                    pos += abbrev.length();
-                }
-                // Remove following space/hyphen if exists
-                if (pos < result.length() && (result[pos] == ' ' || result[pos] == '-'))
-                    result.erase(pos, 1);
-            }
-            else
-            {
-                pos += full.length();
-            }
-        }
-    }
-    
-    // Remove all spaces, hyphens, and special characters, keep only alphanumeric
-    result.erase(std::remove_if(result.begin(), result.end(),
-        [](char c) { return !std::isalnum(c); }), result.end());
-    
-    return result;
+    return IdShortener::Default().Shorten(displayName);
+}
+
+std::string DynamicItemJsonParser::GenerateShortIdFromDisplayName(const std::string& displayName, const ItemProfile& profile)
+{
+    return IdShortener::ForProfile(profile)->Shorten(displayName);
 }
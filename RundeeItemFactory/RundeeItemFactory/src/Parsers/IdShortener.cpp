@@ -0,0 +1,229 @@
+/**
+ * @file IdShortener.cpp
+ * @brief Implementation of the compiled ID shortening rules
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Parsers/IdShortener.h"
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    // ASCII only, like the "C" locale the old implementation ran in
+    inline bool IsAlnum(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+    }
+
+    inline char ToLower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    /** @brief Separators that a removed or abbreviated word takes with it */
+    inline bool IsSwallowedSeparator(char c)
+    {
+        return c == ' ' || c == '-';
+    }
+
+    const std::shared_ptr<const IdShortener>& BuiltIn()
+    {
+        static const std::shared_ptr<const IdShortener> shortener =
+            std::make_shared<IdShortener>(IdShortener::GetDefaultRules());
+        return shortener;
+    }
+
+    bool SameRules(const IdShorteningRules& a, const IdShorteningRules& b)
+    {
+        return a.isSet == b.isSet && a.removeWords == b.removeWords && a.abbreviations == b.abbreviations;
+    }
+}
+
+IdShortener::IdShortener(const IdShorteningRules& rules)
+{
+    for (const auto& word : rules.removeWords)
+        AddRule(word, std::string());
+    for (const auto& abbreviation : rules.abbreviations)
+        AddRule(abbreviation.first, abbreviation.second);
+}
+
+void IdShortener::AddRule(const std::string& pattern, const std::string& replacement)
+{
+    Rule rule;
+    rule.pattern.reserve(pattern.size());
+    for (char c : pattern)
+        rule.pattern += ToLower(c);
+    for (char c : replacement)
+    {
+        if (IsAlnum(c))
+            rule.replacement += ToLower(c);
+    }
+
+    size_t first = 0;
+    while (first < rule.pattern.size() && !IsAlnum(rule.pattern[first]))
+        ++first;
+    if (first == rule.pattern.size())
+    {
+        // Trim surrounding spaces; "&" and " & " are the same rule
+        const size_t begin = rule.pattern.find_first_not_of(' ');
+        if (begin == std::string::npos)
+            return;
+        rule.pattern = rule.pattern.substr(begin, rule.pattern.find_last_not_of(' ') - begin + 1);
+        m_symbolRules.push_back(static_cast<int>(m_rules.size()));
+        m_rules.push_back(std::move(rule));
+        return;
+    }
+
+    // Every word of a whole-word match is a whole word of the name, so the first one is the key
+    size_t end = first;
+    while (end < rule.pattern.size() && IsAlnum(rule.pattern[end]))
+        ++end;
+    m_byFirstToken[rule.pattern.substr(first, end - first)].push_back(static_cast<int>(m_rules.size()));
+    m_rules.push_back(std::move(rule));
+}
+
+void IdShortener::QueueRules(const std::string& text, int after, std::vector<int>& queued) const
+{
+    std::string key;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        if (!IsAlnum(text[i]))
+        {
+            ++i;
+            continue;
+        }
+        const size_t begin = i;
+        while (i < text.size() && IsAlnum(text[i]))
+            ++i;
+        key.assign(text, begin, i - begin);
+        auto it = m_byFirstToken.find(key);
+        if (it == m_byFirstToken.end())
+            continue;
+        for (int index : it->second)
+        {
+            if (index <= after)
+                continue;
+            auto pos = std::lower_bound(queued.begin(), queued.end(), index);
+            if (pos == queued.end() || *pos != index)
+                queued.insert(pos, index);
+        }
+    }
+}
+
+bool IdShortener::Apply(const Rule& rule, std::string& text)
+{
+    const std::string& full = rule.pattern;
+    bool changed = false;
+    size_t pos = 0;
+    while ((pos = text.find(full, pos)) != std::string::npos)
+    {
+        bool isWholeWord = true;
+        if (pos > 0 && IsAlnum(text[pos - 1]))
+            isWholeWord = false;
+        if (pos + full.length() < text.length() && IsAlnum(text[pos + full.length()]))
+            isWholeWord = false;
+
+        if (isWholeWord)
+        {
+            text.erase(pos, full.length());
+            if (!rule.replacement.empty())
+            {
+                text.insert(pos, rule.replacement);
+                pos += rule.replacement.length();
+            }
+            // Remove following space/hyphen if exists
+            if (pos < text.length() && IsSwallowedSeparator(text[pos]))
+                text.erase(pos, 1);
+            changed = true;
+        }
+        else
+        {
+            pos += full.length();
+        }
+    }
+    return changed;
+}
+
+std::string IdShortener::Shorten(const std::string& displayName) const
+{
+    std::string text;
+    text.reserve(displayName.size());
+    for (char c : displayName)
+        text += ToLower(c);
+
+    // Only rules keyed by a word of the name can match; removals never create words
+    std::vector<int> queued(m_symbolRules);
+    queued.reserve(m_symbolRules.size() + 8);
+    QueueRules(text, -1, queued);
+
+    for (size_t next = 0; next < queued.size(); ++next)
+    {
+        const int index = queued[next];
+        const Rule& rule = m_rules[index];
+        if (Apply(rule, text) && !rule.replacement.empty())
+        {
+            // The abbreviation glued onto the next word, which later rules may now match
+            QueueRules(text, index, queued);
+        }
+    }
+
+    text.erase(std::remove_if(text.begin(), text.end(), [](char c) { return !IsAlnum(c); }), text.end());
+    return text;
+}
+
+const IdShorteningRules& IdShortener::GetDefaultRules()
+{
+    static const IdShorteningRules rules = []()
+    {
+        IdShorteningRules r;
+        // Generic descriptors
+        r.removeWords = {
+            "enhanced", "advanced", "professional", "premium", "standard", "basic",
+            "deluxe", "ultimate", "superior", "elite", "master", "expert",
+            "semiautomatic", "automatic", "semi-auto", "full-auto",
+            "assault", "rifle", "pistol", "carbine", "shotgun", "sniper",
+            "model", "mk", "mark", "version", "ver", "v", "edition", "ed",
+            "lever-action", "bolt-action", "pump-action", "action"
+        };
+        // Manufacturers
+        r.abbreviations = {
+            {"heckler", "hk"}, {"koch", ""}, {"&", ""}, {"and", ""},
+            {"colt", "colt"}, {"sig", "sig"}, {"sauer", ""},
+            {"winchester", "win"}, {"remington", "rem"},
+            {"fn", "fn"}, {"herstal", ""},
+            {"glock", "glock"}, {"beretta", "ber"}, {"smith", "sw"}, {"wesson", ""}
+        };
+        return r;
+    }();
+    return rules;
+}
+
+const IdShortener& IdShortener::Default()
+{
+    return *BuiltIn();
+}
+
+std::shared_ptr<const IdShortener> IdShortener::ForProfile(const ItemProfile& profile)
+{
+    if (!profile.idShortening.isSet)
+        return BuiltIn();
+
+    static std::mutex cacheMutex;
+    static std::map<std::string, std::pair<IdShorteningRules, std::shared_ptr<const IdShortener>>> cache;
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(profile.id);
+    if (it == cache.end() || !SameRules(it->second.first, profile.idShortening))
+    {
+        // Profiles edited while the server runs are recompiled on next use
+        auto compiled = std::make_shared<IdShortener>(profile.idShortening);
+        it = cache.insert_or_assign(profile.id, std::make_pair(profile.idShortening, compiled)).first;
+    }
+    return it->second.second;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file LazyCatalogReader.cpp
+ * @brief Implementation of the memory-mapped JSON catalog reader
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Parsers/LazyCatalogReader.h"
+#include "Utils/JsonUtils.h"
+
+namespace
+{
+    /** @brief Scanned bytes kept resident before they are released during a streaming pass */
+    const size_t kReleaseWindow = 64 * 1024 * 1024;
+}
+
+bool LazyCatalogReader::Open(const std::string& path)
+{
+    Close();
+    if (!m_file.Open(path))
+        return false;
+
+    const char* data = m_file.Data();
+    const size_t size = m_file.Size();
+    size_t pos = 0;
+    while (pos < size && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\r' || data[pos] == '\t'))
+        ++pos;
+    if (pos >= size || data[pos] != '[')
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void LazyCatalogReader::Close()
+{
+    m_file.Close();
+    m_spans.clear();
+    m_spans.shrink_to_fit();
+    m_indexed = false;
+}
+
+bool LazyCatalogReader::ForEachItem(const std::function<bool(const char*, size_t)>& onItem)
+{
+    if (!m_file.IsOpen())
+        return false;
+
+    const char* data = m_file.Data();
+    size_t released = 0;
+    m_file.AdviseSequential();
+    const bool ok = JsonUtils::ScanTopLevelArray(data, m_file.Size(), [&](size_t begin, size_t end)
+    {
+        if (begin - released >= kReleaseWindow)
+        {
+            m_file.Release(released, begin - released);
+            released = begin;
+        }
+        return onItem(data + begin, end - begin);
+    });
+    m_file.Release(released, m_file.Size() - released);
+    return ok;
+}
+
+bool LazyCatalogReader::ForEachId(const std::function<void(const std::string&)>& onId)
+{
+    std::string id;
+    return ForEachItem([&](const char* text, size_t length)
+    {
+        if (JsonUtils::FindTopLevelString(text, length, "id", id))
+            onId(id);
+        return true;
+    });
+}
+
+void LazyCatalogReader::EnsureIndex()
+{
+    if (!m_indexed && m_file.IsOpen())
+    {
+        JsonUtils::SplitTopLevelArray(m_file.Data(), m_file.Size(), m_spans);
+        m_indexed = true;
+    }
+}
+
+size_t LazyCatalogReader::GetCount()
+{
+    EnsureIndex();
+    return m_spans.size();
+}
+
+std::pair<const char*, size_t> LazyCatalogReader::GetRaw(size_t index)
+{
+    EnsureIndex();
+    const auto& span = m_spans[index];
+    return { m_file.Data() + span.first, span.second - span.first };
+}
+
+bool LazyCatalogReader::GetItem(size_t index, nlohmann::json& outItem)
+{
+    auto raw = GetRaw(index);
+    outItem = nlohmann::json::parse(raw.first, raw.first + raw.second, nullptr, false);
+    return !outItem.is_discarded();
+}
+
+void LazyCatalogReader::Release(size_t first, size_t last)
+{
+    EnsureIndex();
+    if (first >= last || last > m_spans.size())
+        return;
+    const size_t begin = m_spans[first].first;
+    m_file.Release(begin, m_spans[last - 1].second - begin);
+}
@@ -0,0 +1,317 @@
+/**
+ * @file NdjsonEnvelopeDecoder.cpp
+ * @brief Implementation of the NDJSON envelope decoder
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Parsers/NdjsonEnvelopeDecoder.h"
+#include "Utils/JsonStringCodec.h"
+
+namespace
+{
+    const uint32_t kReplacementChar = 0xFFFD;
+
+    inline bool IsJsonWhitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    inline bool IsHighSurrogate(uint32_t value) { return value >= 0xD800 && value <= 0xDBFF; }
+    inline bool IsLowSurrogate(uint32_t value) { return value >= 0xDC00 && value <= 0xDFFF; }
+}
+
+NdjsonEnvelopeDecoder::NdjsonEnvelopeDecoder(const std::string& fieldName)
+    : m_fieldName(fieldName)
+{
+}
+
+void NdjsonEnvelopeDecoder::Reserve(size_t bodyBytes)
+{
+    m_text.reserve(bodyBytes);
+}
+
+void NdjsonEnvelopeDecoder::Feed(const char* data, size_t size)
+{
+    m_bytesFed += size;
+    size_t i = 0;
+    if (m_mode == Mode::Detect)
+    {
+        while (i < size && IsJsonWhitespace(data[i]))
+            ++i;
+        if (i == size)
+            return;
+        m_mode = (data[i] == '{') ? Mode::Envelope : Mode::Passthrough;
+    }
+
+    if (m_mode == Mode::Passthrough)
+    {
+        m_text.append(data + i, size - i);
+        return;
+    }
+    FeedEnvelope(data + i, size - i);
+}
+
+void NdjsonEnvelopeDecoder::FeedEnvelope(const char* data, size_t size)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        switch (m_state)
+        {
+        case State::Structure:
+            i += ConsumeStructure(data + i, size - i);
+            break;
+        case State::KeyString:
+            i += ConsumeSkippedString(data + i, size - i, true);
+            break;
+        case State::OtherString:
+            i += ConsumeSkippedString(data + i, size - i, false);
+            break;
+        case State::TargetString:
+            i += ConsumeTargetString(data + i, size - i);
+            break;
+        }
+    }
+}
+
+size_t NdjsonEnvelopeDecoder::ConsumeStructure(const char* data, size_t size)
+{
+    // The envelope outside strings is a few dozen bytes per line (plus the
+    // final context array), so it is walked byte by byte
+    for (size_t i = 0; i < size; ++i)
+    {
+        const char c = data[i];
+        if (c == '\n')
+        {
+            EndLine();
+            continue;
+        }
+        m_lineEnvelope.push_back(c);
+
+        switch (c)
+        {
+        case '"':
+            if (m_depth == 1 && m_expectKey)
+            {
+                m_key.clear();
+                m_expectKey = false;
+                m_state = State::KeyString;
+            }
+            else if (m_depth == 1 && m_valueIsTarget)
+            {
+                m_valueIsTarget = false;
+                m_state = State::TargetString;
+            }
+            else
+            {
+                m_state = State::OtherString;
+            }
+            return i + 1;
+        case '{':
+        case '[':
+            ++m_depth;
+            m_expectKey = (c == '{' && m_depth == 1);
+            m_valueIsTarget = false;
+            break;
+        case '}':
+        case ']':
+            if (m_depth > 0)
+                --m_depth;
+            break;
+        case ':':
+            m_valueIsTarget = (m_depth == 1 && m_key == m_fieldName);
+            break;
+        case ',':
+            m_expectKey = (m_depth == 1);
+            m_valueIsTarget = false;
+            break;
+        default:
+            if (!IsJsonWhitespace(c))
+                m_valueIsTarget = false; // Non-string value (null, number, ...)
+            break;
+        }
+    }
+    return size;
+}
+
+size_t NdjsonEnvelopeDecoder::ConsumeSkippedString(const char* data, size_t size, bool isKey)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        if (m_skipEscaped)
+        {
+            m_skipEscaped = false;
+            m_lineEnvelope.push_back(data[i]);
+            if (isKey)
+                m_key.push_back(data[i]);
+            ++i;
+            continue;
+        }
+
+        const size_t run = JsonStringCodec::FindQuoteOrBackslash(data + i, size - i);
+        m_lineEnvelope.append(data + i, run);
+        if (isKey)
+            m_key.append(data + i, run);
+        i += run;
+        if (i == size)
+            break;
+
+        m_lineEnvelope.push_back(data[i]);
+        if (data[i] == '"')
+        {
+            m_state = State::Structure;
+            return i + 1;
+        }
+        m_skipEscaped = true; // Backslash: the next byte cannot end the string
+        if (isKey)
+            m_key.push_back('\\');
+        ++i;
+    }
+    return size;
+}
+
+size_t NdjsonEnvelopeDecoder::ConsumeTargetString(const char* data, size_t size)
+{
+    size_t i = 0;
+    while (i < size)
+    {
+        if (!m_escape.empty())
+        {
+            // Inside an escape that may have started in the previous chunk
+            while (i < size && !m_escape.empty())
+                ConsumeEscapeByte(data[i++]);
+            continue;
+        }
+
+        const size_t run = JsonStringCodec::FindQuoteOrBackslash(data + i, size - i);
+        if (run > 0)
+        {
+            FlushPendingHighSurrogate();
+            m_text.append(data + i, run);
+            i += run;
+        }
+        if (i == size)
+            break;
+
+        if (data[i] == '"')
+        {
+            FlushPendingHighSurrogate();
+            m_lineEnvelope.push_back('"');
+            m_state = State::Structure;
+            return i + 1;
+        }
+        m_escape.push_back('\\');
+        ++i;
+    }
+    return size;
+}
+
+void NdjsonEnvelopeDecoder::ConsumeEscapeByte(char c)
+{
+    if (m_escape.size() == 1)
+    {
+        char decoded = 0;
+        switch (c)
+        {
+        case '"': decoded = '"'; break;
+        case '\\': decoded = '\\'; break;
+        case '/': decoded = '/'; break;
+        case 'b': decoded = '\b'; break;
+        case 'f': decoded = '\f'; break;
+        case 'n': decoded = '\n'; break;
+        case 'r': decoded = '\r'; break;
+        case 't': decoded = '\t'; break;
+        case 'u':
+            m_escape.push_back(c);
+            return;
+        default:
+            // Not a JSON escape: keep it verbatim rather than lose text
+            FlushPendingHighSurrogate();
+            ++m_invalidEscapes;
+            m_text.push_back('\\');
+            m_text.push_back(c);
+            m_escape.clear();
+            return;
+        }
+        FlushPendingHighSurrogate();
+        m_text.push_back(decoded);
+        m_escape.clear();
+        return;
+    }
+
+    // \uXXXX: collect four hex digits
+    m_escape.push_back(c);
+    if (m_escape.size() < 6)
+        return;
+
+    uint32_t value = 0;
+    if (!JsonStringCodec::ParseHex4(m_escape.data() + 2, value))
+    {
+        FlushPendingHighSurrogate();
+        ++m_invalidEscapes;
+        m_text += m_escape;
+        m_escape.clear();
+        return;
+    }
+    m_escape.clear();
+
+    if (IsHighSurrogate(value))
+    {
+        FlushPendingHighSurrogate(); // Two highs in a row: the first is lone
+        m_pendingHigh = value;
+    }
+    else if (IsLowSurrogate(value))
+    {
+        if (m_pendingHigh != 0)
+        {
+            JsonStringCodec::AppendUtf8(m_text, 0x10000 + ((m_pendingHigh - 0xD800) << 10) + (value - 0xDC00));
+            m_pendingHigh = 0;
+        }
+        else
+        {
+            ++m_invalidEscapes;
+            JsonStringCodec::AppendUtf8(m_text, kReplacementChar);
+        }
+    }
+    else
+    {
+        FlushPendingHighSurrogate();
+        JsonStringCodec::AppendUtf8(m_text, value);
+    }
+}
+
+void NdjsonEnvelopeDecoder::FlushPendingHighSurrogate()
+{
+    if (m_pendingHigh == 0)
+        return;
+    ++m_invalidEscapes;
+    JsonStringCodec::AppendUtf8(m_text, kReplacementChar);
+    m_pendingHigh = 0;
+}
+
+void NdjsonEnvelopeDecoder::EndLine()
+{
+    // Strings never contain raw newlines in valid JSON, so a newline always ends the line
+    if (m_lineEnvelope.find_first_not_of(" \t\r") != std::string::npos)
+        m_lastEnvelope.swap(m_lineEnvelope);
+    m_lineEnvelope.clear();
+    m_depth = 0;
+    m_expectKey = false;
+    m_valueIsTarget = false;
+}
+
+void NdjsonEnvelopeDecoder::Finish()
+{
+    if (m_mode != Mode::Envelope)
+        return;
+    if (!m_escape.empty())
+    {
+        ++m_invalidEscapes; // Body ended inside an escape
+        m_escape.clear();
+    }
+    FlushPendingHighSurrogate();
+    EndLine();
+}
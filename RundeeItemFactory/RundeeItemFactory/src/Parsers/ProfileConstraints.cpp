@@ -0,0 +1,135 @@
+/**
+ * @file ProfileConstraints.cpp
+ * @brief Implementation of per-profile constraint compilation and checking
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Parsers/ProfileConstraints.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    bool IsComparisonOperator(const std::string& op)
+    {
+        return op == ">=" || op == "<=" || op == ">" || op == "<" || op == "==" || op == "!=" || op == "=";
+    }
+
+    /** @brief True for a bare field name or number, which needs no parentheses as an operand */
+    bool IsSimpleOperand(const std::string& text)
+    {
+        return !text.empty() && std::all_of(text.begin(), text.end(), [](char c)
+        {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+        });
+    }
+
+    /** @brief Every constraint source of a profile, to notice edits of a cached profile */
+    std::string ConstraintSignature(const ItemProfile& profile)
+    {
+        std::string signature;
+        for (const auto& field : profile.fields)
+        {
+            for (const auto& constraint : field.validation.relationshipConstraints)
+                signature += field.name + '\x1f' + constraint.operator_ + '\x1f' + constraint.targetField + '\x1f' +
+                    constraint.description + '\x1e';
+            if (!field.validation.customConstraint.empty())
+                signature += field.name + '\x1f' + field.validation.customConstraint + '\x1e';
+        }
+        return signature;
+    }
+}
+
+ProfileConstraints::ProfileConstraints(const ItemProfile& profile)
+{
+    for (const auto& field : profile.fields)
+    {
+        for (const auto& relationship : field.validation.relationshipConstraints)
+        {
+            const std::string& target = relationship.targetField;
+            if (!IsComparisonOperator(relationship.operator_) || target.empty())
+            {
+                std::cerr << "[ProfileConstraints] Skipping relationship constraint of '" << field.name
+                          << "' in profile " << profile.id << ": unsupported operator '" << relationship.operator_
+                          << "' or empty target\n";
+                continue;
+            }
+
+            Constraint constraint;
+            constraint.fieldName = field.name;
+            constraint.description = relationship.description;
+            const std::string text = field.name + " " + relationship.operator_ + " " +
+                (IsSimpleOperand(target) ? target : "(" + target + ")");
+            std::string error;
+            if (!constraint.expression.Compile(text, field.name, &error))
+            {
+                std::cerr << "[ProfileConstraints] Skipping relationship constraint \"" << text << "\" in profile "
+                          << profile.id << ": " << error << "\n";
+                continue;
+            }
+            m_constraints.push_back(std::move(constraint));
+        }
+
+        const std::string& custom = field.validation.customConstraint;
+        if (!custom.empty())
+        {
+            Constraint constraint;
+            constraint.fieldName = field.name;
+            std::string error;
+            if (!constraint.expression.Compile(custom, field.name, &error))
+            {
+                std::cout << "[ProfileConstraints] Custom constraint of '" << field.name << "' in profile "
+                          << profile.id << " is not an expression (" << error << "); it stays prompt guidance only\n";
+                continue;
+            }
+            m_constraints.push_back(std::move(constraint));
+        }
+    }
+}
+
+int ProfileConstraints::Check(const nlohmann::json& item,
+                              std::vector<std::string>& errors,
+                              std::vector<std::string>* outInvalidFields) const
+{
+    int violations = 0;
+    for (const auto& constraint : m_constraints)
+    {
+        if (constraint.expression.Evaluate(item) != ConstraintExpression::Result::Fail)
+            continue;
+
+        ++violations;
+        std::string message = "Field '" + constraint.fieldName + "' must satisfy " +
+            constraint.expression.GetText() + " (" + constraint.expression.DescribeValues(item) + ")";
+        if (!constraint.description.empty())
+            message += ": " + constraint.description;
+        errors.push_back(std::move(message));
+
+        if (outInvalidFields &&
+            std::find(outInvalidFields->begin(), outInvalidFields->end(), constraint.fieldName) == outInvalidFields->end())
+            outInvalidFields->push_back(constraint.fieldName);
+    }
+    return violations;
+}
+
+std::shared_ptr<const ProfileConstraints> ProfileConstraints::ForProfile(const ItemProfile& profile)
+{
+    static std::mutex cacheMutex;
+    static std::map<std::string, std::pair<std::string, std::shared_ptr<const ProfileConstraints>>> cache;
+
+    const std::string signature = ConstraintSignature(profile);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(profile.id);
+    if (it == cache.end() || it->second.first != signature)
+    {
+        // Profiles edited while the server runs are recompiled on next use
+        auto compiled = std::make_shared<ProfileConstraints>(profile);
+        it = cache.insert_or_assign(profile.id, std::make_pair(signature, compiled)).first;
+    }
+    return it->second.second;
+}
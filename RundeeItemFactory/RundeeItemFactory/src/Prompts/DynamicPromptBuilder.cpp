@@ -355,3 +355,141 @@ std::string DynamicPromptBuilder::BuildPromptFromProfile(
     
     return prompt.str();
 }
+
+std::string DynamicPromptBuilder::BuildContinuationPrompt(
+    const ItemProfile& profile,
+    int count,
+    const std::set<std::string>& rejectedIds)
+{
+    std::ostringstream prompt;
+    prompt << "Generate " << count << " more " << profile.itemTypeName
+           << " items, different from every item above, following the same rules.\n";
+    
+    if (!rejectedIds.empty())
+    {
+        prompt << "These IDs already exist and were rejected; do not reuse them or their stems: ";
+        int idCount = 0;
+        for (const auto& id : rejectedIds)
+        {
+            if (idCount > 0) prompt << ", ";
+            prompt << id;
+            idCount++;
+            if (idCount >= 20) // Limit to first 20
+            {
+                if (rejectedIds.size() > 20)
+                    prompt << " ... (and " << (rejectedIds.size() - 20) << " more)";
+                break;
+            }
+        }
+        prompt << "\n";
+    }
+    
+    prompt << "Return only a JSON array of " << count << " items in the same format.\n";
+    return prompt.str();
+}
+
+std::string DynamicPromptBuilder::BuildQuotaDirective(
+    const std::map<std::string, std::map<std::string, int>>& plan)
+{
+    std::ostringstream prompt;
+    for (const auto& field : plan)
+    {
+        std::ostringstream buckets;
+        int bucketCount = 0;
+        for (const auto& value : field.second)
+        {
+            if (value.second <= 0)
+                continue;
+            if (bucketCount > 0) buckets << ", ";
+            buckets << value.second << " with " << field.first << " \"" << value.first << "\"";
+            bucketCount++;
+        }
+        if (bucketCount == 0)
+            continue;
+        prompt << "DISTRIBUTION REQUIREMENT for \"" << field.first << "\": produce exactly " << buckets.str()
+               << ". Do not use any other " << field.first << " value in this batch.\n";
+    }
+    return prompt.str();
+}
+
+std::string DynamicPromptBuilder::BuildRepairPrompt(
+    const ItemProfile& profile,
+    const std::vector<RejectedItem>& rejected)
+{
+    std::ostringstream prompt;
+    prompt << "These " << rejected.size() << " " << profile.itemTypeName
+           << " items failed validation. Fix only the listed problems and keep every other field,"
+           << " including 'id' and 'displayName', unchanged.\n\n";
+    
+    // Rules of the fields that failed, each listed once
+    std::set<std::string> fieldNames;
+    for (const auto& entry : rejected)
+        fieldNames.insert(entry.invalidFields.begin(), entry.invalidFields.end());
+    
+    prompt << "Field rules:\n";
+    for (const auto& field : profile.fields)
+    {
+        if (fieldNames.find(field.name) == fieldNames.end())
+            continue;
+        
+        prompt << "- " << field.name << ": ";
+        switch (field.type)
+        {
+            case ProfileFieldType::String:  prompt << "string"; break;
+            case ProfileFieldType::Integer: prompt << "integer"; break;
+            case ProfileFieldType::Float:   prompt << "float"; break;
+            case ProfileFieldType::Boolean: prompt << "boolean"; break;
+            case ProfileFieldType::Array:   prompt << "array"; break;
+            case ProfileFieldType::Object:  prompt << "object"; break;
+        }
+        if (field.validation.isRequired)
+            prompt << ", required";
+        if (field.type == ProfileFieldType::Integer || field.type == ProfileFieldType::Float)
+        {
+            if (field.validation.minValue != 0.0)
+                prompt << ", min " << field.validation.minValue;
+            if (field.validation.maxValue != 0.0)
+                prompt << ", max " << field.validation.maxValue;
+        }
+        else if (field.type == ProfileFieldType::String || field.type == ProfileFieldType::Array)
+        {
+            const char* unit = (field.type == ProfileFieldType::String) ? " characters" : " elements";
+            if (field.validation.minLength > 0)
+                prompt << ", at least " << field.validation.minLength << unit;
+            if (field.validation.maxLength > 0)
+                prompt << ", at most " << field.validation.maxLength << unit;
+        }
+        if (!field.validation.allowedValues.empty())
+        {
+            prompt << ", one of: ";
+            for (size_t i = 0; i < field.validation.allowedValues.size(); ++i)
+            {
+                if (i > 0) prompt << ", ";
+                prompt << field.validation.allowedValues[i];
+            }
+        }
+        for (const auto& constraint : field.validation.relationshipConstraints)
+            prompt << ", " << field.name << " " << constraint.operator_ << " " << constraint.targetField;
+        if (!field.validation.customConstraint.empty())
+            prompt << ", " << field.validation.customConstraint;
+        if (!field.description.empty())
+            prompt << " - " << field.description;
+        prompt << "\n";
+    }
+    
+    prompt << "\nItems:\n";
+    for (size_t i = 0; i < rejected.size(); ++i)
+    {
+        prompt << (i + 1) << ". " << rejected[i].item.dump() << "\n";
+        prompt << "   Problems: ";
+        for (size_t e = 0; e < rejected[i].errors.size(); ++e)
+        {
+            if (e > 0) prompt << "; ";
+            prompt << rejected[i].errors[e];
+        }
+        prompt << "\n";
+    }
+    
+    prompt << "\nReturn only a JSON array of the " << rejected.size() << " corrected items, in the same order.\n";
+    return prompt.str();
+}
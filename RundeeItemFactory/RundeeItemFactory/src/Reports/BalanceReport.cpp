@@ -0,0 +1,704 @@
+/**
+ * @file BalanceReport.cpp
+ * @brief Implementation of catalog balance analytics
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Reports/BalanceReport.h"
+#include "Reports/CatalogSlices.h"
+#include "Generators/GenerationCache.h"
+#include "Utils/FileUtils.h"
+#include <json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    /** @brief Number of equal-width histogram bins per numeric field */
+    const int kHistogramBins = 10;
+
+    /**
+     * @enum FieldKind
+     * @brief How a field's values are summarized
+     */
+    enum class FieldKind
+    {
+        Numeric,   ///< Integer/Float: value statistics
+        Enum,      ///< String with allowedValues: value distribution
+        Text,      ///< Free string: length statistics
+        Boolean,   ///< true/false distribution
+        Array,     ///< Element count statistics
+        Object     ///< Presence only
+    };
+
+    /**
+     * @struct FieldSpec
+     * @brief What to check for one profile field
+     */
+    struct FieldSpec
+    {
+        std::string name;
+        FieldKind kind = FieldKind::Object;
+        bool hasRange = false;
+        double minValue = 0.0;
+        double maxValue = 0.0;
+        std::set<std::string> allowedValues;
+        std::string settingsName;   ///< PlayerSettings field bounding this one (empty = none)
+        int settingsMax = 0;
+    };
+
+    /**
+     * @struct FieldAccumulator
+     * @brief Per-thread running totals for one field
+     */
+    struct FieldAccumulator
+    {
+        int present = 0;
+        int missing = 0;
+        int wrongType = 0;
+        int outOfRange = 0;       ///< Outside the profile's min/max or not an allowed value
+        int aboveSettings = 0;    ///< Above the matching PlayerSettings maximum
+        std::vector<double> values;
+        std::map<std::string, int> valueCounts;
+        std::vector<std::string> sampleIds;
+
+        void AddSample(const std::string& id)
+        {
+            if (sampleIds.size() < CatalogSlices::kMaxSampleIds && !id.empty())
+                sampleIds.push_back(id);
+        }
+
+        void Merge(FieldAccumulator& other)
+        {
+            present += other.present;
+            missing += other.missing;
+            wrongType += other.wrongType;
+            outOfRange += other.outOfRange;
+            aboveSettings += other.aboveSettings;
+            values.insert(values.end(), other.values.begin(), other.values.end());
+            for (const auto& kv : other.valueCounts)
+                valueCounts[kv.first] += kv.second;
+            for (const auto& id : other.sampleIds)
+                AddSample(id);
+        }
+    };
+
+    /**
+     * @brief Find the PlayerSettings maximum a field is balanced against (by name)
+     * @param fieldName Profile field name (e.g., "hungerRestore", "weight")
+     * @param settings Player settings
+     * @param outName Receives the settings field name
+     * @return Maximum value, or 0 if no setting applies
+     */
+    int MatchPlayerSetting(const std::string& fieldName, const PlayerSettings& settings, std::string& outName)
+    {
+        std::string lower = fieldName;
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+        const std::pair<const char*, std::pair<const char*, int>> mapping[] = {
+            { "hunger",  { "maxHunger",  settings.maxHunger } },
+            { "thirst",  { "maxThirst",  settings.maxThirst } },
+            { "health",  { "maxHealth",  settings.maxHealth } },
+            { "stamina", { "maxStamina", settings.maxStamina } },
+            { "energy",  { "maxEnergy",  settings.maxEnergy } },
+            { "weight",  { "maxWeight",  settings.maxWeight } },
+        };
+        for (const auto& entry : mapping)
+        {
+            if (lower.find(entry.first) != std::string::npos)
+            {
+                outName = entry.second.first;
+                return entry.second.second;
+            }
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Build field specs from the item and player profiles
+     */
+    std::vector<FieldSpec> BuildSpecs(const ItemProfile& profile, const PlayerSettings& settings)
+    {
+        std::vector<FieldSpec> specs;
+        for (const auto& field : profile.fields)
+        {
+            FieldSpec spec;
+            spec.name = field.name;
+            switch (field.type)
+            {
+            case ProfileFieldType::Integer:
+            case ProfileFieldType::Float:
+                spec.kind = FieldKind::Numeric;
+                break;
+            case ProfileFieldType::String:
+                spec.kind = field.validation.allowedValues.empty() ? FieldKind::Text : FieldKind::Enum;
+                break;
+            case ProfileFieldType::Boolean:
+                spec.kind = FieldKind::Boolean;
+                break;
+            case ProfileFieldType::Array:
+                spec.kind = FieldKind::Array;
+                break;
+            default:
+                spec.kind = FieldKind::Object;
+                break;
+            }
+            spec.hasRange = field.validation.maxValue > field.validation.minValue;
+            spec.minValue = field.validation.minValue;
+            spec.maxValue = field.validation.maxValue;
+            spec.allowedValues.insert(field.validation.allowedValues.begin(), field.validation.allowedValues.end());
+            if (spec.kind == FieldKind::Numeric)
+                spec.settingsMax = MatchPlayerSetting(field.name, settings, spec.settingsName);
+            specs.push_back(spec);
+        }
+        return specs;
+    }
+
+    /**
+     * @struct FieldEvent
+     * @brief One top-level value of the item being read
+     */
+    struct FieldEvent
+    {
+        enum class Type { Number, String, Boolean, Array, Object };
+
+        size_t field = 0;
+        Type type = Type::Number;
+        double number = 0.0;      ///< Number value, or element count for arrays
+        std::string text;
+        bool flag = false;
+    };
+
+    /**
+     * @class ItemStatsSax
+     * @brief SAX consumer accumulating field statistics without building a DOM
+     *
+     * Fed one catalog element at a time. Top-level values of the item are
+     * buffered and only applied when the item's closing brace is reached, so a
+     * malformed item leaves no partial counts (and the id is known even when
+     * it follows the flagged field).
+     */
+    class ItemStatsSax
+    {
+    public:
+        using number_integer_t = nlohmann::json::number_integer_t;
+        using number_unsigned_t = nlohmann::json::number_unsigned_t;
+        using number_float_t = nlohmann::json::number_float_t;
+        using string_t = nlohmann::json::string_t;
+        using binary_t = nlohmann::json::binary_t;
+
+        ItemStatsSax(const std::vector<FieldSpec>& specs,
+                     const std::map<std::string, size_t>& fieldIndex,
+                     std::vector<FieldAccumulator>& acc)
+            : m_specs(specs), m_fieldIndex(fieldIndex), m_acc(acc)
+        {
+        }
+
+        /** @brief Reset before parsing the next catalog element */
+        void BeginElement()
+        {
+            m_depth = 0;
+            m_current = kNone;
+            m_container = kNone;
+            m_events.clear();
+            m_id.clear();
+        }
+
+        bool null() { return Scalar(nullptr); }
+        bool boolean(bool v)
+        {
+            FieldEvent e;
+            e.type = FieldEvent::Type::Boolean;
+            e.flag = v;
+            return Scalar(&e);
+        }
+        bool number_integer(number_integer_t v) { return Number(static_cast<double>(v)); }
+        bool number_unsigned(number_unsigned_t v) { return Number(static_cast<double>(v)); }
+        bool number_float(number_float_t v, const string_t&) { return Number(v); }
+        bool string(string_t& v)
+        {
+            if (m_depth == 1 && m_current == kIdOnly)
+            {
+                m_id = v;
+                m_current = kNone;
+                return true;
+            }
+            if (m_depth == 1 && m_current < m_specs.size() && m_specs[m_current].name == "id")
+                m_id = v;
+            FieldEvent e;
+            e.type = FieldEvent::Type::String;
+            if (m_depth == 1 && m_current != kNone)
+                e.text = std::move(v);
+            return Scalar(&e);
+        }
+        bool binary(binary_t&) { return Scalar(nullptr); }
+
+        bool start_object(std::size_t) { return StartContainer(false); }
+        bool start_array(std::size_t) { return StartContainer(true); }
+        bool end_array() { return EndContainer(); }
+        bool end_object()
+        {
+            if (m_depth == 1)
+            {
+                --m_depth;
+                Commit();
+                return true;
+            }
+            return EndContainer();
+        }
+
+        bool key(string_t& k)
+        {
+            if (m_depth != 1)
+                return true;
+            auto it = m_fieldIndex.find(k);
+            m_current = it != m_fieldIndex.end() ? it->second : (k == "id" ? kIdOnly : kNone);
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&)
+        {
+            return false;
+        }
+
+        /** @brief Items committed so far */
+        int GetItemCount() const { return m_items; }
+
+    private:
+        static const size_t kNone = static_cast<size_t>(-1);
+        static const size_t kIdOnly = static_cast<size_t>(-2); ///< "id" when the profile has no id field
+
+        bool Number(double v)
+        {
+            FieldEvent e;
+            e.type = FieldEvent::Type::Number;
+            e.number = v;
+            return Scalar(&e);
+        }
+
+        /**
+         * @brief Handle a scalar (event == nullptr for null/binary)
+         * @return False if the element is not an object
+         */
+        bool Scalar(FieldEvent* event)
+        {
+            if (m_depth == 0)
+                return false; // Catalog element is not an item object
+            if (m_depth == 1)
+            {
+                if (m_current < kIdOnly && event)
+                {
+                    event->field = m_current;
+                    m_events.push_back(std::move(*event));
+                }
+                m_current = kNone;
+            }
+            else if (m_depth == 2 && m_container != kNone && m_containerIsArray)
+            {
+                ++m_elements;
+            }
+            return true;
+        }
+
+        bool StartContainer(bool isArray)
+        {
+            if (m_depth == 0 && isArray)
+                return false;
+            if (m_depth == 1)
+            {
+                m_container = m_current < kIdOnly ? m_current : kNone;
+                m_containerIsArray = isArray;
+                m_elements = 0;
+                m_current = kNone;
+            }
+            else if (m_depth == 2 && m_container != kNone && m_containerIsArray)
+            {
+                ++m_elements;
+            }
+            ++m_depth;
+            return true;
+        }
+
+        bool EndContainer()
+        {
+            --m_depth;
+            if (m_depth == 1 && m_container != kNone)
+            {
+                FieldEvent e;
+                e.field = m_container;
+                e.type = m_containerIsArray ? FieldEvent::Type::Array : FieldEvent::Type::Object;
+                e.number = static_cast<double>(m_elements);
+                m_events.push_back(std::move(e));
+                m_container = kNone;
+            }
+            return true;
+        }
+
+        /** @brief Apply the buffered values of a complete item */
+        void Commit()
+        {
+            ++m_items;
+            m_seen.assign(m_specs.size(), false);
+            for (FieldEvent& e : m_events)
+            {
+                if (m_seen[e.field])
+                    continue; // Duplicate key: first value wins
+                m_seen[e.field] = true;
+                Apply(e);
+            }
+            for (size_t f = 0; f < m_specs.size(); ++f)
+            {
+                if (!m_seen[f])
+                    ++m_acc[f].missing;
+            }
+        }
+
+        void Apply(FieldEvent& e)
+        {
+            const FieldSpec& spec = m_specs[e.field];
+            FieldAccumulator& a = m_acc[e.field];
+            switch (spec.kind)
+            {
+            case FieldKind::Numeric:
+            {
+                if (e.type != FieldEvent::Type::Number)
+                {
+                    ++a.wrongType;
+                    return;
+                }
+                a.values.push_back(e.number);
+                bool flagged = false;
+                if (spec.hasRange && (e.number < spec.minValue || e.number > spec.maxValue))
+                {
+                    ++a.outOfRange;
+                    flagged = true;
+                }
+                if (spec.settingsMax > 0 && e.number > spec.settingsMax)
+                {
+                    ++a.aboveSettings;
+                    flagged = true;
+                }
+                if (flagged)
+                    a.AddSample(m_id);
+                break;
+            }
+            case FieldKind::Enum:
+            case FieldKind::Text:
+                if (e.type != FieldEvent::Type::String)
+                {
+                    ++a.wrongType;
+                    return;
+                }
+                if (spec.kind == FieldKind::Text)
+                {
+                    a.values.push_back(static_cast<double>(e.text.size()));
+                    break;
+                }
+                if (spec.allowedValues.find(e.text) == spec.allowedValues.end())
+                {
+                    ++a.outOfRange;
+                    a.AddSample(m_id);
+                }
+                ++a.valueCounts[std::move(e.text)];
+                break;
+            case FieldKind::Boolean:
+                if (e.type != FieldEvent::Type::Boolean)
+                {
+                    ++a.wrongType;
+                    return;
+                }
+                ++a.valueCounts[e.flag ? "true" : "false"];
+                break;
+            case FieldKind::Array:
+                if (e.type != FieldEvent::Type::Array)
+                {
+                    ++a.wrongType;
+                    return;
+                }
+                a.values.push_back(e.number);
+                break;
+            case FieldKind::Object:
+                if (e.type != FieldEvent::Type::Object)
+                {
+                    ++a.wrongType;
+                    return;
+                }
+                break;
+            }
+            ++a.present;
+        }
+
+        const std::vector<FieldSpec>& m_specs;
+        const std::map<std::string, size_t>& m_fieldIndex;
+        std::vector<FieldAccumulator>& m_acc;
+        int m_depth = 0;
+        size_t m_current = kNone;        ///< Field of the value that follows the current key
+        size_t m_container = kNone;      ///< Field whose array/object value is being read
+        bool m_containerIsArray = false;
+        int m_elements = 0;
+        std::string m_id;
+        std::vector<FieldEvent> m_events;
+        std::vector<bool> m_seen;
+        int m_items = 0;
+    };
+
+    /**
+     * @brief Nearest-rank percentile of sorted values
+     */
+    double Percentile(const std::vector<double>& sorted, double p)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sorted.size()));
+        return sorted[rank == 0 ? 0 : rank - 1];
+    }
+
+    /**
+     * @brief Summarize merged values (min/max/mean/percentiles/histogram/IQR outliers)
+     */
+    nlohmann::json SummarizeValues(std::vector<double>& values)
+    {
+        nlohmann::json j = nlohmann::json::object();
+        if (values.empty())
+            return j;
+
+        std::sort(values.begin(), values.end());
+        double sum = 0.0;
+        for (double v : values)
+            sum += v;
+        const double mean = sum / values.size();
+        double variance = 0.0;
+        for (double v : values)
+            variance += (v - mean) * (v - mean);
+
+        j["min"] = values.front();
+        j["max"] = values.back();
+        j["mean"] = mean;
+        j["stddev"] = std::sqrt(variance / values.size());
+        j["percentiles"] = {
+            { "p5", Percentile(values, 5) }, { "p25", Percentile(values, 25) },
+            { "p50", Percentile(values, 50) }, { "p75", Percentile(values, 75) },
+            { "p95", Percentile(values, 95) }, { "p99", Percentile(values, 99) }
+        };
+
+        const double lo = values.front();
+        const double hi = values.back();
+        const double width = (hi - lo) / kHistogramBins;
+        std::vector<int> bins(kHistogramBins, 0);
+        for (double v : values)
+        {
+            int b = width > 0.0 ? static_cast<int>((v - lo) / width) : 0;
+            ++bins[std::min(b, kHistogramBins - 1)];
+        }
+        j["histogram"] = nlohmann::json::array();
+        for (int b = 0; b < kHistogramBins; ++b)
+        {
+            j["histogram"].push_back({ { "from", lo + width * b }, { "to", lo + width * (b + 1) }, { "count", bins[b] } });
+            if (width <= 0.0)
+                break; // All values equal: one bin
+        }
+
+        // Tukey fences
+        const double q1 = Percentile(values, 25);
+        const double q3 = Percentile(values, 75);
+        const double iqr = q3 - q1;
+        auto low = std::lower_bound(values.begin(), values.end(), q1 - 1.5 * iqr);
+        auto high = std::upper_bound(values.begin(), values.end(), q3 + 1.5 * iqr);
+        j["iqrOutliers"] = static_cast<int>((low - values.begin()) + (values.end() - high));
+        return j;
+    }
+
+    const char* KindName(FieldKind kind)
+    {
+        switch (kind)
+        {
+        case FieldKind::Numeric: return "numeric";
+        case FieldKind::Enum:    return "enum";
+        case FieldKind::Text:    return "text";
+        case FieldKind::Boolean: return "boolean";
+        case FieldKind::Array:   return "array";
+        default:                 return "object";
+        }
+    }
+
+    /**
+     * @brief Print one field of the report in human-readable form
+     */
+    void PrintField(const std::string& name, const nlohmann::json& f)
+    {
+        std::cout << "[Report] " << name << " (" << f["kind"].get<std::string>() << "): present="
+                  << f["present"].get<int>() << " missing=" << f["missing"].get<int>()
+                  << " wrongType=" << f["wrongType"].get<int>() << "\n";
+
+        if (f.contains("stats") && !f["stats"].empty())
+        {
+            const auto& s = f["stats"];
+            const auto& p = s["percentiles"];
+            std::cout << "    " << (f["kind"] == "numeric" ? "value" : "length")
+                      << " min=" << s["min"].get<double>() << " max=" << s["max"].get<double>()
+                      << " mean=" << s["mean"].get<double>() << " stddev=" << s["stddev"].get<double>()
+                      << " p5=" << p["p5"].get<double>() << " p50=" << p["p50"].get<double>()
+                      << " p95=" << p["p95"].get<double>() << " p99=" << p["p99"].get<double>() << "\n";
+            std::cout << "    histogram:";
+            for (const auto& bin : s["histogram"])
+                std::cout << " [" << bin["from"].get<double>() << ".." << bin["to"].get<double>() << "]=" << bin["count"].get<int>();
+            std::cout << "\n    outliers: iqr=" << s["iqrOutliers"].get<int>();
+        }
+        else if (f.contains("distribution"))
+        {
+            std::cout << "    distribution:";
+            const int present = std::max(1, f["present"].get<int>());
+            for (auto it = f["distribution"].begin(); it != f["distribution"].end(); ++it)
+            {
+                std::ostringstream pct;
+                pct << std::fixed << std::setprecision(1) << (it.value().get<int>() * 100.0 / present);
+                std::cout << " " << it.key() << "=" << it.value().get<int>() << " (" << pct.str() << "%)";
+            }
+            std::cout << "\n    outliers:";
+        }
+        else
+        {
+            return;
+        }
+
+        std::cout << " outOfRange=" << f["outOfRange"].get<int>();
+        if (f.contains("settingsField"))
+        {
+            std::cout << " above " << f["settingsField"].get<std::string>() << "(" << f["settingsMax"].get<int>()
+                      << ")=" << f["aboveSettings"].get<int>();
+        }
+        if (!f["sampleIds"].empty())
+        {
+            std::cout << " e.g.";
+            for (const auto& id : f["sampleIds"])
+                std::cout << " " << id.get<std::string>();
+        }
+        std::cout << "\n";
+    }
+}
+
+int BalanceReport::Run(const CommandLineArgs& args)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    ItemProfile itemProfile;
+    std::string playerProfilesDir;
+    if (!CatalogSlices::LoadItemProfile(args, "[BalanceReport]", itemProfile, playerProfilesDir))
+        return 1;
+
+    // Player profile is optional here; without one the PlayerSettings defaults apply
+    PlayerProfile playerProfile = args.playerProfileId.empty()
+        ? GenerationCache::GetDefaultPlayerProfile(playerProfilesDir)
+        : GenerationCache::GetPlayerProfile(playerProfilesDir, args.playerProfileId);
+    if (playerProfile.id.empty() && !args.playerProfileId.empty())
+    {
+        std::cerr << "[BalanceReport] Failed to load player profile: " << args.playerProfileId << "\n";
+        return 1;
+    }
+
+    const std::string catalogPath = CatalogSlices::ResolveCatalogPath(args.reportPath);
+    CatalogSlices catalog;
+    if (!catalog.Open(catalogPath, "[BalanceReport]"))
+        return 1;
+
+    const std::vector<FieldSpec> specs = BuildSpecs(itemProfile, playerProfile.playerSettings);
+
+    // Parse and accumulate contiguous slices of items on each thread
+    const size_t threadCount = catalog.GetSliceCount();
+    std::vector<std::vector<FieldAccumulator>> partials(threadCount, std::vector<FieldAccumulator>(specs.size()));
+    std::vector<int> parseErrors(threadCount, 0);
+    std::map<std::string, size_t> fieldIndex;
+    for (size_t f = 0; f < specs.size(); ++f)
+        fieldIndex.emplace(specs[f].name, f);
+    std::vector<ItemStatsSax> saxes;
+    saxes.reserve(threadCount);
+    for (size_t t = 0; t < threadCount; ++t)
+        saxes.emplace_back(specs, fieldIndex, partials[t]);
+    catalog.ForEachItem([&](size_t s, size_t, const char* text, size_t length)
+    {
+        ItemStatsSax& sax = saxes[s];
+        sax.BeginElement();
+        if (!nlohmann::json::sax_parse(text, text + length, &sax))
+            ++parseErrors[s];
+    });
+
+    int totalParseErrors = 0;
+    for (size_t t = 0; t < threadCount; ++t)
+    {
+        totalParseErrors += parseErrors[t];
+        if (t == 0)
+            continue;
+        for (size_t f = 0; f < specs.size(); ++f)
+            partials[0][f].Merge(partials[t][f]);
+    }
+
+    // Build the report
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    nlohmann::json report;
+    report["catalog"] = catalogPath;
+    report["profile"] = itemProfile.id;
+    report["playerProfile"] = playerProfile.id;
+    report["items"] = static_cast<int>(catalog.GetItemCount()) - totalParseErrors;
+    report["parseErrors"] = totalParseErrors;
+    report["threads"] = static_cast<int>(threadCount);
+    report["elapsedMs"] = elapsedMs;
+    report["fields"] = nlohmann::json::object();
+
+    std::cout << "[Report] Catalog " << catalogPath << ": " << report["items"].get<int>() << " items, "
+              << totalParseErrors << " unparsable, profile " << itemProfile.id
+              << ", player profile " << (playerProfile.id.empty() ? "(defaults)" : playerProfile.id)
+              << ", " << threadCount << " thread(s), " << static_cast<int>(elapsedMs) << " ms\n";
+
+    for (size_t f = 0; f < specs.size(); ++f)
+    {
+        const FieldSpec& spec = specs[f];
+        FieldAccumulator& a = partials[0][f];
+        nlohmann::json field;
+        field["kind"] = KindName(spec.kind);
+        field["present"] = a.present;
+        field["missing"] = a.missing;
+        field["wrongType"] = a.wrongType;
+        field["outOfRange"] = a.outOfRange;
+        field["sampleIds"] = a.sampleIds;
+        if (spec.kind == FieldKind::Numeric || spec.kind == FieldKind::Text || spec.kind == FieldKind::Array)
+        {
+            field["stats"] = SummarizeValues(a.values);
+        }
+        if (spec.kind == FieldKind::Enum || spec.kind == FieldKind::Boolean)
+        {
+            // Allowed values that never occur are listed with 0 so gaps are visible
+            nlohmann::json distribution = nlohmann::json::object();
+            for (const auto& value : spec.allowedValues)
+                distribution[value] = 0;
+            for (const auto& kv : a.valueCounts)
+                distribution[kv.first] = kv.second;
+            field["distribution"] = distribution;
+        }
+        if (!spec.settingsName.empty())
+        {
+            field["settingsField"] = spec.settingsName;
+            field["settingsMax"] = spec.settingsMax;
+            field["aboveSettings"] = a.aboveSettings;
+        }
+        PrintField(spec.name, field);
+        report["fields"][spec.name] = std::move(field);
+    }
+
+    std::filesystem::path reportPath(catalogPath);
+    reportPath.replace_extension(".report.json");
+    if (!FileUtils::WriteFileAtomic(reportPath.string(), report.dump(2)))
+    {
+        std::cerr << "[BalanceReport] Failed to write " << reportPath.string() << "\n";
+        return 1;
+    }
+    std::cout << "[Report] Wrote " << reportPath.string() << "\n";
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file CatalogSlices.cpp
+ * @brief Implementation of the shared catalog pass of the offline reports
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Reports/CatalogSlices.h"
+#include "Generators/GenerationCache.h"
+#include "Generators/ItemGenerator.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /** @brief Items handled per thread before another thread is worth starting */
+    const size_t kMinItemsPerThread = 2048;
+
+    /** @brief Items a thread reads before it releases their pages */
+    const size_t kReleaseEveryItems = 4096;
+}
+
+std::string CatalogSlices::ResolveCatalogPath(const std::string& path)
+{
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec))
+        return path;
+    return CommandLineParser::ResolveOutputPath(path);
+}
+
+bool CatalogSlices::LoadItemProfile(const CommandLineArgs& args, const std::string& logTag,
+                                    ItemProfile& outProfile, std::string& outPlayerProfilesDir)
+{
+    // Same directories as generation
+    const std::string exeDir = ItemGenerator::GetExecutableDirectory();
+    const std::string profilesDir = exeDir + "ItemProfiles/";
+    outPlayerProfilesDir = exeDir + "PlayerProfiles/";
+    if (!GenerationCache::PrepareDirectories(profilesDir, outPlayerProfilesDir))
+    {
+        std::cerr << logTag << " Failed to initialize item profiles directory\n";
+        return false;
+    }
+
+    std::string profileId = args.profileId;
+    if (profileId.empty())
+    {
+        profileId = "default_" + CommandLineParser::GetItemTypeName(args.itemType);
+        std::transform(profileId.begin(), profileId.end(), profileId.begin(), ::tolower);
+    }
+    outProfile = GenerationCache::GetItemProfile(profilesDir, profileId);
+    if (outProfile.id.empty())
+    {
+        std::cerr << logTag << " Failed to load item profile: " << profileId << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool CatalogSlices::Open(const std::string& catalogPath, const std::string& logTag)
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(catalogPath, ec))
+    {
+        std::cerr << logTag << " Cannot read catalog: " << catalogPath << "\n";
+        return false;
+    }
+    if (!m_reader.Open(catalogPath))
+    {
+        std::cerr << logTag << " Catalog is not a JSON array: " << catalogPath << "\n";
+        return false;
+    }
+
+    const size_t items = m_reader.GetCount();
+    m_sliceCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    m_sliceCount = std::min(m_sliceCount, items / kMinItemsPerThread + 1);
+    return true;
+}
+
+void CatalogSlices::ForEachItem(const std::function<void(size_t, size_t, const char*, size_t)>& onItem)
+{
+    const size_t items = m_reader.GetCount(); // Index is built before any thread reads it
+    std::vector<std::thread> workers;
+    for (size_t s = 0; s < m_sliceCount; ++s)
+    {
+        workers.emplace_back([&, s]()
+        {
+            const size_t begin = items * s / m_sliceCount;
+            const size_t end = items * (s + 1) / m_sliceCount;
+            size_t released = begin;
+            for (size_t i = begin; i < end; ++i)
+            {
+                const auto raw = m_reader.GetRaw(i);
+                onItem(s, i, raw.first, raw.second);
+                if (i + 1 - released >= kReleaseEveryItems)
+                {
+                    m_reader.Release(released, i + 1);
+                    released = i + 1;
+                }
+            }
+            m_reader.Release(released, end);
+        });
+    }
+    for (auto& worker : workers)
+        worker.join();
+}
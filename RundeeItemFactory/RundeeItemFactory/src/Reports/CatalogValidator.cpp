@@ -0,0 +1,184 @@
+/**
+ * @file CatalogValidator.cpp
+ * @brief Implementation of bulk catalog re-validation
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Reports/CatalogValidator.h"
+#include "Reports/CatalogSlices.h"
+#include "Parsers/DynamicItemJsonParser.h"
+#include "Parsers/ProfileConstraints.h"
+#include "Utils/FileUtils.h"
+#include <json.hpp>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace
+{
+    /** @brief Invalid items printed with their errors */
+    const size_t kMaxListedItems = 20;
+
+    /**
+     * @struct FieldFailures
+     * @brief Invalid items attributed to one field
+     */
+    struct FieldFailures
+    {
+        int items = 0;
+        std::vector<std::string> sampleIds;
+    };
+
+    /**
+     * @struct InvalidItem
+     * @brief An invalid item kept for the listing
+     */
+    struct InvalidItem
+    {
+        std::string id;
+        std::vector<std::string> errors;
+    };
+
+    /**
+     * @struct SliceResult
+     * @brief Tallies of one thread's contiguous slice of items
+     */
+    struct SliceResult
+    {
+        int valid = 0;
+        int invalid = 0;
+        int parseErrors = 0;
+        std::map<std::string, FieldFailures> byField;
+        std::vector<InvalidItem> listed;
+        std::vector<std::string> errors;         ///< Scratch for the item being checked
+        std::vector<std::string> invalidFields;  ///< Scratch for the item being checked
+    };
+
+    std::string ItemIdOf(const nlohmann::json& item, size_t index)
+    {
+        auto it = item.find("id");
+        if (it != item.end() && it->is_string())
+            return it->get<std::string>();
+        return "#" + std::to_string(index);
+    }
+}
+
+int CatalogValidator::Run(const CommandLineArgs& args)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    ItemProfile itemProfile;
+    std::string playerProfilesDir;
+    if (!CatalogSlices::LoadItemProfile(args, "[CatalogValidator]", itemProfile, playerProfilesDir))
+        return 1;
+    const std::shared_ptr<const ProfileConstraints> constraints = ProfileConstraints::ForProfile(itemProfile);
+
+    const std::string catalogPath = CatalogSlices::ResolveCatalogPath(args.validatePath);
+    CatalogSlices catalog;
+    if (!catalog.Open(catalogPath, "[CatalogValidator]"))
+        return 1;
+
+    // Validate contiguous slices of items on each thread
+    const size_t threadCount = catalog.GetSliceCount();
+    std::vector<SliceResult> slices(threadCount);
+    catalog.ForEachItem([&](size_t s, size_t i, const char* text, size_t length)
+    {
+        SliceResult& slice = slices[s];
+        const nlohmann::json item = nlohmann::json::parse(text, text + length, nullptr, false);
+        if (item.is_discarded() || !item.is_object())
+        {
+            ++slice.parseErrors;
+            return;
+        }
+
+        if (DynamicItemJsonParser::ValidateItem(item, itemProfile, slice.errors, &slice.invalidFields, constraints.get()))
+        {
+            ++slice.valid;
+            return;
+        }
+
+        ++slice.invalid;
+        const std::string id = ItemIdOf(item, i);
+        for (const auto& field : slice.invalidFields)
+        {
+            FieldFailures& failures = slice.byField[field];
+            ++failures.items;
+            if (failures.sampleIds.size() < CatalogSlices::kMaxSampleIds)
+                failures.sampleIds.push_back(id);
+        }
+        if (slice.listed.size() < kMaxListedItems)
+            slice.listed.push_back({ id, slice.errors });
+    });
+
+    // Merge in slice order, so examples come in catalog order
+    SliceResult total;
+    for (auto& slice : slices)
+    {
+        total.valid += slice.valid;
+        total.invalid += slice.invalid;
+        total.parseErrors += slice.parseErrors;
+        for (auto& entry : slice.byField)
+        {
+            FieldFailures& failures = total.byField[entry.first];
+            failures.items += entry.second.items;
+            for (auto& id : entry.second.sampleIds)
+            {
+                if (failures.sampleIds.size() < CatalogSlices::kMaxSampleIds)
+                    failures.sampleIds.push_back(std::move(id));
+            }
+        }
+        for (auto& listed : slice.listed)
+        {
+            if (total.listed.size() < kMaxListedItems)
+                total.listed.push_back(std::move(listed));
+        }
+    }
+
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "[Validate] Catalog " << catalogPath << ": " << (total.valid + total.invalid) << " items, "
+              << total.valid << " valid, " << total.invalid << " invalid, " << total.parseErrors
+              << " unparsable, profile " << itemProfile.id << " (" << constraints->GetCount()
+              << " compiled constraints), " << threadCount << " thread(s), " << static_cast<int>(elapsedMs) << " ms\n";
+
+    nlohmann::json report;
+    report["catalog"] = catalogPath;
+    report["profile"] = itemProfile.id;
+    report["items"] = total.valid + total.invalid;
+    report["valid"] = total.valid;
+    report["invalid"] = total.invalid;
+    report["parseErrors"] = total.parseErrors;
+    report["constraints"] = static_cast<int>(constraints->GetCount());
+    report["threads"] = static_cast<int>(threadCount);
+    report["elapsedMs"] = elapsedMs;
+    report["fields"] = nlohmann::json::object();
+    for (const auto& entry : total.byField)
+    {
+        std::cout << "[Validate]   " << entry.first << ": " << entry.second.items << " invalid item(s), e.g.";
+        for (const auto& id : entry.second.sampleIds)
+            std::cout << " " << id;
+        std::cout << "\n";
+        report["fields"][entry.first] = { { "invalidItems", entry.second.items }, { "sampleIds", entry.second.sampleIds } };
+    }
+    report["examples"] = nlohmann::json::array();
+    for (const auto& listed : total.listed)
+    {
+        std::cout << "[Validate] " << listed.id << ":\n";
+        for (const auto& error : listed.errors)
+            std::cout << "  - " << error << "\n";
+        report["examples"].push_back({ { "id", listed.id }, { "errors", listed.errors } });
+    }
+
+    std::filesystem::path reportPath(catalogPath);
+    reportPath.replace_extension(".validation.json");
+    if (!FileUtils::WriteFileAtomic(reportPath.string(), report.dump(2)))
+    {
+        std::cerr << "[CatalogValidator] Failed to write " << reportPath.string() << "\n";
+        return 1;
+    }
+    std::cout << "[Validate] Wrote " << reportPath.string() << "\n";
+    return (total.invalid == 0 && total.parseErrors == 0) ? 0 : 1;
+}
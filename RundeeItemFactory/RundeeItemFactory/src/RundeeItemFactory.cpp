@@ -9,9 +9,14 @@
 // ===============================
 
 #include <iostream>
+#include "Bench/BenchRunner.h"
 #include "Helpers/AppConfig.h"
 #include "Helpers/CommandLineParser.h"
 #include "Generators/ItemGenerator.h"
+#include "Generators/ManifestRunner.h"
+#include "Reports/BalanceReport.h"
+#include "Reports/CatalogValidator.h"
+#include "Server/JobServer.h"
 
 int main(int argc, char** argv)
 {
@@ -21,6 +26,36 @@ int main(int argc, char** argv)
     // Parse command line arguments
     CommandLineArgs args = CommandLineParser::ParseArguments(argc, argv);
 
+    // Serve mode: keep config/profiles/IDs warm and accept jobs over a local API
+    if (args.serveMode)
+    {
+        return JobServer::Run(args);
+    }
+
+    // Manifest mode: run many jobs in this process with shared caches and connections
+    if (!args.manifestPath.empty())
+    {
+        return ManifestRunner::Run(args);
+    }
+
+    // Report mode: balance analytics over an existing catalog (no LLM)
+    if (!args.reportPath.empty())
+    {
+        return BalanceReport::Run(args);
+    }
+
+    // Validate mode: re-check an existing catalog against its profile (no LLM)
+    if (!args.validatePath.empty())
+    {
+        return CatalogValidator::Run(args);
+    }
+
+    // Bench mode: measure catalog code paths on an existing file (no LLM)
+    if (!args.benchSuite.empty())
+    {
+        return BenchRunner::Run(args);
+    }
+
     // Print configuration
     std::cout << "[Main] Mode = " << CommandLineParser::GetRunModeName(args.mode)
         << ", itemType = " << CommandLineParser::GetItemTypeName(args.itemType)
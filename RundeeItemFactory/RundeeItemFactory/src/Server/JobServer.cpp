@@ -0,0 +1,519 @@
+/**
+ * @file JobServer.cpp
+ * @brief Implementation of the local job server
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "Server/JobServer.h"
+#include "Generators/ItemGenerator.h"
+#include "Clients/OllamaClient.h"
+#include <json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+#ifdef _WIN32
+    using SocketHandle = SOCKET;
+    const SocketHandle kInvalidSocket = INVALID_SOCKET;
+
+    void CloseSocket(SocketHandle s)
+    {
+        closesocket(s);
+    }
+#else
+    using SocketHandle = int;
+    const SocketHandle kInvalidSocket = -1;
+
+    void CloseSocket(SocketHandle s)
+    {
+        close(s);
+    }
+#endif
+
+#ifdef MSG_NOSIGNAL
+    const int kSendFlags = MSG_NOSIGNAL; // Report disconnects as errors instead of SIGPIPE
+#else
+    const int kSendFlags = 0;
+#endif
+
+    /** @brief Largest request body accepted (job descriptions are small) */
+    const size_t kMaxRequestBytes = 1024 * 1024;
+
+    /** @brief Connections served at once; each holds a thread (a job's for its whole run) */
+    const int kMaxConnections = 64;
+
+    /** @brief Pause after a failed accept() before trying again */
+    const auto kAcceptRetryDelay = std::chrono::milliseconds(100);
+
+    std::atomic<bool> g_stopRequested{ false };
+    std::atomic<int> g_activeConnections{ 0 };
+    std::atomic<int> g_runningJobs{ 0 };
+    std::mutex g_jobsMutex;
+    std::condition_variable g_jobsDone;
+    SocketHandle g_listenSocket = kInvalidSocket;
+
+    /** @brief Per-run secret every request must echo in the X-Rundee-Token header */
+    std::string g_authToken;
+
+    /**
+     * @struct HttpRequest
+     * @brief Minimal parsed HTTP request
+     */
+    struct HttpRequest
+    {
+        std::string method;
+        std::string path;
+        std::string token;
+        std::string contentType;
+        std::string body;
+        bool hasOrigin = false;
+    };
+
+    /**
+     * @brief Generate the per-run API token (128 random bits as hex)
+     */
+    std::string GenerateAuthToken()
+    {
+        std::random_device device;
+        std::ostringstream token;
+        token << std::hex << std::setfill('0');
+        for (int i = 0; i < 4; ++i)
+            token << std::setw(8) << static_cast<uint32_t>(device());
+        return token.str();
+    }
+
+    /**
+     * @brief Trim surrounding whitespace (and the trailing CR) from a header value
+     */
+    std::string TrimHeaderValue(const std::string& value)
+    {
+        size_t begin = value.find_first_not_of(" \t");
+        if (begin == std::string::npos)
+            return std::string();
+        size_t end = value.find_last_not_of(" \t\r");
+        return value.substr(begin, end - begin + 1);
+    }
+
+    /**
+     * @brief Compare two strings without exiting early on the first mismatch
+     */
+    bool ConstantTimeEquals(const std::string& a, const std::string& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        unsigned char diff = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+            diff |= static_cast<unsigned char>(a[i] ^ b[i]);
+        return diff == 0;
+    }
+
+    /**
+     * @brief Reject requests a browser page could have sent
+     *
+     * Any page can send a "simple" cross-origin POST to 127.0.0.1, so every
+     * request must carry the per-run token, must not carry an Origin header,
+     * and POST /jobs must declare a JSON body (which a page cannot do without
+     * a CORS preflight this server never answers).
+     * @return Empty string if allowed, otherwise the rejection reason
+     */
+    std::string CheckRequestAllowed(const HttpRequest& request)
+    {
+        if (request.hasOrigin)
+            return "Cross-origin requests are not allowed";
+        if (!ConstantTimeEquals(request.token, g_authToken))
+            return "Missing or invalid X-Rundee-Token header";
+        if (request.method == "POST" && request.path == "/jobs")
+        {
+            std::string mediaType = request.contentType.substr(0, request.contentType.find(';'));
+            mediaType = TrimHeaderValue(mediaType);
+            for (char& c : mediaType)
+                c = static_cast<char>(::tolower(static_cast<unsigned char>(c)));
+            if (mediaType != "application/json")
+                return "Content-Type must be application/json";
+        }
+        return std::string();
+    }
+
+    /**
+     * @brief Send a whole buffer, retrying partial sends
+     * @return False if the peer went away
+     */
+    bool SendAll(SocketHandle s, const std::string& data)
+    {
+        size_t sent = 0;
+        while (sent < data.size())
+        {
+            int n = send(s, data.data() + sent, static_cast<int>(data.size() - sent), kSendFlags);
+            if (n <= 0)
+                return false;
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Read one HTTP request (headers + Content-Length body)
+     * @return False on malformed or oversized requests
+     */
+    bool ReadRequest(SocketHandle s, HttpRequest& out)
+    {
+        std::string buffer;
+        char chunk[4096];
+        size_t headerEnd = std::string::npos;
+
+        while ((headerEnd = buffer.find("\r\n\r\n")) == std::string::npos)
+        {
+            int n = recv(s, chunk, sizeof(chunk), 0);
+            if (n <= 0 || buffer.size() > kMaxRequestBytes)
+                return false;
+            buffer.append(chunk, static_cast<size_t>(n));
+        }
+
+        std::istringstream headerStream(buffer.substr(0, headerEnd));
+        std::string requestLine;
+        std::getline(headerStream, requestLine);
+        std::istringstream requestLineStream(requestLine);
+        requestLineStream >> out.method >> out.path;
+        if (out.method.empty() || out.path.empty())
+            return false;
+
+        size_t contentLength = 0;
+        std::string headerLine;
+        while (std::getline(headerStream, headerLine))
+        {
+            size_t colon = headerLine.find(':');
+            if (colon == std::string::npos)
+                continue;
+            std::string name = headerLine.substr(0, colon);
+            for (char& c : name)
+                c = static_cast<char>(::tolower(static_cast<unsigned char>(c)));
+            if (name == "content-length")
+            {
+                contentLength = static_cast<size_t>(std::strtoull(headerLine.c_str() + colon + 1, nullptr, 10));
+            }
+            else if (name == "content-type")
+            {
+                out.contentType = TrimHeaderValue(headerLine.substr(colon + 1));
+            }
+            else if (name == "x-rundee-token")
+            {
+                out.token = TrimHeaderValue(headerLine.substr(colon + 1));
+            }
+            else if (name == "origin")
+            {
+                out.hasOrigin = true;
+            }
+        }
+        if (contentLength > kMaxRequestBytes)
+            return false;
+
+        out.body = buffer.substr(headerEnd + 4);
+        while (out.body.size() < contentLength)
+        {
+            int n = recv(s, chunk, sizeof(chunk), 0);
+            if (n <= 0)
+                return false;
+            out.body.append(chunk, static_cast<size_t>(n));
+        }
+        out.body.resize(contentLength);
+        return true;
+    }
+
+    /**
+     * @brief Serialize a response object; invalid UTF-8 (e.g. echoed from a bad body) becomes U+FFFD
+     */
+    std::string DumpJson(const nlohmann::json& body)
+    {
+        return body.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    }
+
+    /**
+     * @brief Send a complete JSON response and close semantics (Connection: close)
+     */
+    void SendJsonResponse(SocketHandle s, int status, const std::string& statusText, const nlohmann::json& body)
+    {
+        std::string payload = DumpJson(body) + "\n";
+        std::ostringstream response;
+        response << "HTTP/1.1 " << status << " " << statusText << "\r\n"
+                 << "Content-Type: application/json\r\n"
+                 << "Content-Length: " << payload.size() << "\r\n"
+                 << "Connection: close\r\n\r\n"
+                 << payload;
+        SendAll(s, response.str());
+    }
+
+    /**
+     * @brief Run one job and stream its progress as NDJSON
+     *
+     * The body is delimited by closing the connection, so no chunked
+     * encoding is needed; every progress event is flushed as its own line.
+     */
+    void HandleJob(SocketHandle s, const HttpRequest& request, const CommandLineArgs& defaults)
+    {
+        nlohmann::json jobJson;
+        try
+        {
+            jobJson = nlohmann::json::parse(request.body);
+        }
+        catch (const std::exception& e)
+        {
+            SendJsonResponse(s, 400, "Bad Request", { {"error", std::string("Invalid JSON: ") + e.what()} });
+            return;
+        }
+
+        CommandLineArgs jobArgs;
+        std::string error;
+        if (!CommandLineParser::ParseJobJson(jobJson, defaults, jobArgs, error))
+        {
+            SendJsonResponse(s, 400, "Bad Request", { {"error", error} });
+            return;
+        }
+
+        std::string header =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Type: application/x-ndjson\r\n"
+            "Cache-Control: no-cache\r\n"
+            "Connection: close\r\n\r\n";
+        bool clientConnected = SendAll(s, header);
+
+        GenerationProgressCallback onProgress = [&](const GenerationProgress& progress)
+        {
+            if (!clientConnected)
+                return;
+            nlohmann::json line = {
+                {"event", "progress"},
+                {"stage", progress.stage},
+                {"accepted", progress.accepted},
+                {"requested", progress.requested},
+                {"message", progress.message}
+            };
+            clientConnected = SendAll(s, DumpJson(line) + "\n");
+        };
+
+        std::cout << "[JobServer] Job started: profile=" << jobArgs.profileId
+                  << ", count=" << jobArgs.params.count
+                  << ", out=" << jobArgs.params.outputPath << "\n";
+
+        int exitCode = 1;
+        g_runningJobs++;
+        try
+        {
+            exitCode = ItemGenerator::GenerateWithLLM(jobArgs, onProgress);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[JobServer] Job failed with exception: " << e.what() << "\n";
+        }
+        g_runningJobs--;
+
+        std::cout << "[JobServer] Job finished with exit code " << exitCode << "\n";
+        if (clientConnected)
+        {
+            nlohmann::json result = { {"event", "result"}, {"exitCode", exitCode} };
+            SendAll(s, DumpJson(result) + "\n");
+        }
+    }
+
+    /**
+     * @brief Route one connection's request to its endpoint
+     */
+    void ServeRequest(SocketHandle s, const CommandLineArgs& defaults)
+    {
+        HttpRequest request;
+        std::string rejection;
+        if (!ReadRequest(s, request))
+        {
+            SendJsonResponse(s, 400, "Bad Request", { {"error", "Malformed request"} });
+        }
+        else if (!(rejection = CheckRequestAllowed(request)).empty())
+        {
+            SendJsonResponse(s, 403, "Forbidden", { {"error", rejection} });
+        }
+        else if (request.method == "GET" && request.path == "/health")
+        {
+            SendJsonResponse(s, 200, "OK", { {"status", "ok"}, {"activeJobs", g_runningJobs.load()} });
+        }
+        else if (request.method == "POST" && request.path == "/jobs")
+        {
+            if (g_stopRequested.load())
+            {
+                SendJsonResponse(s, 503, "Service Unavailable", { {"error", "Server is shutting down"} });
+            }
+            else
+            {
+                HandleJob(s, request, defaults);
+            }
+        }
+        else if (request.method == "POST" && request.path == "/shutdown")
+        {
+            SendJsonResponse(s, 200, "OK", { {"status", "stopping"} });
+            g_stopRequested.store(true);
+            // Unblock accept() in the main loop
+#ifndef _WIN32
+            shutdown(g_listenSocket, SHUT_RDWR);
+#endif
+            CloseSocket(g_listenSocket);
+        }
+        else
+        {
+            SendJsonResponse(s, 404, "Not Found", { {"error", "Unknown endpoint"} });
+        }
+    }
+
+    /**
+     * @brief Whether accept() failed because the listening socket is unusable
+     */
+    bool IsFatalAcceptError()
+    {
+#ifdef _WIN32
+        const int error = WSAGetLastError();
+        return error == WSAENOTSOCK || error == WSAEINVAL || error == WSANOTINITIALISED;
+#else
+        return errno == EBADF || errno == EINVAL || errno == ENOTSOCK;
+#endif
+    }
+
+    /**
+     * @brief Serve a single connection (runs on its own thread)
+     *
+     * Nothing may escape the thread: an uncaught exception would terminate
+     * the server and every job running in it.
+     */
+    void HandleConnection(SocketHandle s, CommandLineArgs defaults)
+    {
+        try
+        {
+            ServeRequest(s, defaults);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "[JobServer] Request failed with exception: " << e.what() << "\n";
+            try
+            {
+                SendJsonResponse(s, 500, "Internal Server Error", { {"error", "Internal server error"} });
+            }
+            catch (...)
+            {
+            }
+        }
+        catch (...)
+        {
+            std::cerr << "[JobServer] Request failed with an unknown exception\n";
+        }
+
+        CloseSocket(s);
+        {
+            std::lock_guard<std::mutex> lock(g_jobsMutex);
+            g_activeConnections--;
+        }
+        g_jobsDone.notify_all();
+    }
+}
+
+int JobServer::Run(const CommandLineArgs& defaults)
+{
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+    {
+        std::cerr << "[JobServer] WSAStartup failed\n";
+        return 1;
+    }
+#endif
+
+    g_listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (g_listenSocket == kInvalidSocket)
+    {
+        std::cerr << "[JobServer] Failed to create listening socket\n";
+        return 1;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK); // Local tooling only
+    address.sin_port = htons(static_cast<unsigned short>(defaults.servePort));
+
+    if (bind(g_listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(g_listenSocket, SOMAXCONN) != 0)
+    {
+        std::cerr << "[JobServer] Failed to listen on 127.0.0.1:" << defaults.servePort << "\n";
+        CloseSocket(g_listenSocket);
+        return 1;
+    }
+
+    g_authToken = GenerateAuthToken();
+    std::cout << "[JobServer] Listening on http://127.0.0.1:" << defaults.servePort
+              << " (POST /jobs, GET /health, POST /shutdown)\n";
+    std::cout << "[JobServer] API token: " << g_authToken
+              << " (send as X-Rundee-Token on every request)\n";
+
+    int exitCode = 0;
+    while (!g_stopRequested.load())
+    {
+        SocketHandle client = accept(g_listenSocket, nullptr, nullptr);
+        if (client == kInvalidSocket)
+        {
+            if (g_stopRequested.load())
+                break;
+            if (IsFatalAcceptError())
+            {
+                std::cerr << "[JobServer] Listening socket failed; stopping\n";
+                exitCode = 1;
+                break;
+            }
+            // Transient (out of descriptors, aborted handshake): back off instead of spinning
+            std::this_thread::sleep_for(kAcceptRetryDelay);
+            continue;
+        }
+
+        if (g_activeConnections.load() >= kMaxConnections)
+        {
+            SendJsonResponse(client, 503, "Service Unavailable", { {"error", "Too many connections"} });
+            CloseSocket(client);
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(g_jobsMutex);
+            g_activeConnections++;
+        }
+        std::thread(HandleConnection, client, defaults).detach();
+    }
+
+    std::cout << "[JobServer] Shutting down; waiting for running jobs...\n";
+    {
+        std::unique_lock<std::mutex> lock(g_jobsMutex);
+        g_jobsDone.wait(lock, [] { return g_activeConnections.load() == 0; });
+    }
+    OllamaClient::ReleaseConnections();
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    std::cout << "[JobServer] Stopped\n";
+    return exitCode;
+}
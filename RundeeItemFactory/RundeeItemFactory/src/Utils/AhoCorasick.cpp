@@ -0,0 +1,152 @@
+/**
+ * @file AhoCorasick.cpp
+ * @brief Implementation of the Aho-Corasick matcher
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/AhoCorasick.h"
+#include <algorithm>
+#include <cctype>
+#include <queue>
+#include <set>
+
+namespace
+{
+    inline unsigned char FoldCase(unsigned char c)
+    {
+        return static_cast<unsigned char>(std::tolower(c));
+    }
+}
+
+void AhoCorasickMatcher::Build(const std::vector<std::string>& terms)
+{
+    // Normalize (lowercase), drop empties and duplicates
+    std::set<std::string> unique;
+    for (const auto& term : terms)
+    {
+        if (term.empty())
+            continue;
+        std::string lowered = term;
+        std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+            [](char c) { return static_cast<char>(FoldCase(static_cast<unsigned char>(c))); });
+        unique.insert(lowered);
+    }
+    m_terms.assign(unique.begin(), unique.end());
+
+    // Byte classes: one per distinct byte used by the terms (both cases map to the same class)
+    std::fill(std::begin(m_byteClass), std::end(m_byteClass), static_cast<uint8_t>(0));
+    m_classCount = 1;
+    for (const auto& term : m_terms)
+    {
+        for (unsigned char c : term)
+        {
+            if (m_byteClass[c] == 0)
+            {
+                m_byteClass[c] = static_cast<uint8_t>(m_classCount++);
+            }
+        }
+    }
+    for (int c = 0; c < 256; ++c)
+    {
+        unsigned char folded = FoldCase(static_cast<unsigned char>(c));
+        if (m_byteClass[c] == 0 && m_byteClass[folded] != 0)
+        {
+            m_byteClass[c] = m_byteClass[folded];
+        }
+    }
+
+    // Trie (0 = root); -1 marks a missing edge until the failure pass fills it in
+    m_next.assign(static_cast<size_t>(m_classCount), -1);
+    m_termAt.assign(1, -1);
+    for (size_t id = 0; id < m_terms.size(); ++id)
+    {
+        int state = 0;
+        for (unsigned char c : m_terms[id])
+        {
+            int cls = m_byteClass[c];
+            int& edge = m_next[static_cast<size_t>(state) * m_classCount + cls];
+            if (edge < 0)
+            {
+                edge = static_cast<int>(m_termAt.size());
+                m_termAt.push_back(-1);
+                m_next.resize(m_next.size() + static_cast<size_t>(m_classCount), -1);
+            }
+            state = m_next[static_cast<size_t>(state) * m_classCount + cls];
+        }
+        m_termAt[state] = static_cast<int32_t>(id);
+    }
+
+    // Breadth-first failure links, folded into the transition table (full DFA)
+    const size_t stateCount = m_termAt.size();
+    std::vector<int32_t> fail(stateCount, 0);
+    m_outputLink.assign(stateCount, -1);
+    std::queue<int> pending;
+    for (int cls = 0; cls < m_classCount; ++cls)
+    {
+        int32_t& edge = m_next[static_cast<size_t>(cls)];
+        if (edge < 0)
+        {
+            edge = 0;
+        }
+        else
+        {
+            fail[edge] = 0;
+            pending.push(edge);
+        }
+    }
+    while (!pending.empty())
+    {
+        int state = pending.front();
+        pending.pop();
+        int f = fail[state];
+        m_outputLink[state] = m_termAt[f] >= 0 ? f : m_outputLink[f];
+
+        for (int cls = 0; cls < m_classCount; ++cls)
+        {
+            int32_t& edge = m_next[static_cast<size_t>(state) * m_classCount + cls];
+            int32_t fallback = m_next[static_cast<size_t>(f) * m_classCount + cls];
+            if (edge < 0)
+            {
+                edge = fallback;
+            }
+            else
+            {
+                fail[edge] = fallback;
+                pending.push(edge);
+            }
+        }
+    }
+}
+
+void AhoCorasickMatcher::Scan(const std::string& text, const std::function<void(int, size_t)>& onMatch) const
+{
+    if (m_terms.empty())
+        return;
+
+    int state = 0;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        state = m_next[static_cast<size_t>(state) * m_classCount + m_byteClass[static_cast<unsigned char>(text[i])]];
+        for (int s = m_termAt[state] >= 0 ? state : m_outputLink[state]; s >= 0; s = m_outputLink[s])
+        {
+            onMatch(m_termAt[s], i + 1);
+        }
+    }
+}
+
+bool AhoCorasickMatcher::ContainsAny(const std::string& text) const
+{
+    if (m_terms.empty())
+        return false;
+
+    int state = 0;
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        state = m_next[static_cast<size_t>(state) * m_classCount + m_byteClass[static_cast<unsigned char>(text[i])]];
+        if (m_termAt[state] >= 0 || m_outputLink[state] >= 0)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file AllocationStats.cpp
+ * @brief Counting replacements of the global operator new/delete (RUNDEE_ALLOC_STATS builds only)
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/AllocationStats.h"
+
+#ifdef RUNDEE_ALLOC_STATS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+namespace
+{
+    std::atomic<uint64_t> s_allocations{ 0 };
+    std::atomic<uint64_t> s_allocatedBytes{ 0 };
+    std::atomic<uint64_t> s_liveBytes{ 0 };
+    std::atomic<uint64_t> s_peakLiveBytes{ 0 };
+
+    // Plain thread_local counters: constant-initialized, so safe inside operator new
+    thread_local uint64_t t_allocations = 0;
+    thread_local uint64_t t_allocatedBytes = 0;
+
+    /** @brief Usable size of a malloc block (what free() will release) */
+    size_t BlockSize(void* ptr)
+    {
+#ifdef _WIN32
+        return _msize(ptr);
+#else
+        return malloc_usable_size(ptr);
+#endif
+    }
+
+    void* CountedAlloc(size_t size) noexcept
+    {
+        void* ptr = std::malloc(size == 0 ? 1 : size);
+        if (!ptr)
+            return nullptr;
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+        s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        ++t_allocations;
+        t_allocatedBytes += size;
+        const size_t blockSize = BlockSize(ptr);
+        const uint64_t live = s_liveBytes.fetch_add(blockSize, std::memory_order_relaxed) + blockSize;
+        uint64_t peak = s_peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !s_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+        return ptr;
+    }
+
+    void CountedFree(void* ptr) noexcept
+    {
+        if (!ptr)
+            return;
+        s_liveBytes.fetch_sub(BlockSize(ptr), std::memory_order_relaxed);
+        std::free(ptr);
+    }
+
+    void* CountedAllocOrThrow(size_t size)
+    {
+        for (;;)
+        {
+            if (void* ptr = CountedAlloc(size))
+                return ptr;
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+                throw std::bad_alloc();
+            handler();
+        }
+    }
+}
+
+namespace AllocationStats
+{
+    Snapshot Get()
+    {
+        Snapshot snapshot;
+        snapshot.allocations = s_allocations.load(std::memory_order_relaxed);
+        snapshot.allocatedBytes = s_allocatedBytes.load(std::memory_order_relaxed);
+        snapshot.liveBytes = s_liveBytes.load(std::memory_order_relaxed);
+        snapshot.peakLiveBytes = s_peakLiveBytes.load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    Snapshot GetThread()
+    {
+        Snapshot snapshot;
+        snapshot.allocations = t_allocations;
+        snapshot.allocatedBytes = t_allocatedBytes;
+        return snapshot;
+    }
+
+    void ResetPeak()
+    {
+        s_peakLiveBytes.store(s_liveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+// Replaceable global allocation functions (aligned forms keep the library defaults)
+void* operator new(size_t size) { return CountedAllocOrThrow(size); }
+void* operator new[](size_t size) { return CountedAllocOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void operator delete(void* ptr) noexcept { CountedFree(ptr); }
+void operator delete[](void* ptr) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { CountedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { CountedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { CountedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { CountedFree(ptr); }
+
+#else
+
+namespace AllocationStats
+{
+    Snapshot Get() { return Snapshot(); }
+    Snapshot GetThread() { return Snapshot(); }
+    void ResetPeak() {}
+}
+
+#endif
@@ -0,0 +1,84 @@
+/**
+ * @file BatchArena.cpp
+ * @brief Implementation of the per-batch bump allocator
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/BatchArena.h"
+#include <algorithm>
+
+namespace
+{
+    const size_t kMaxBlockSize = 1024 * 1024;
+
+    thread_local BatchArena* t_currentArena = nullptr;
+}
+
+size_t BatchArena::AlignedOffset(const Block& block, size_t offset, size_t alignment)
+{
+    const uintptr_t address = reinterpret_cast<uintptr_t>(block.data) + offset;
+    return offset + ((alignment - (address & (alignment - 1))) & (alignment - 1));
+}
+
+BatchArena::Scope::Scope(BatchArena& arena)
+    : m_previous(t_currentArena)
+{
+    t_currentArena = &arena;
+}
+
+BatchArena::Scope::~Scope()
+{
+    t_currentArena = m_previous;
+}
+
+BatchArena::BatchArena(size_t firstBlockSize)
+    : m_nextBlockSize(std::max<size_t>(firstBlockSize, 256))
+{
+}
+
+BatchArena::~BatchArena()
+{
+    for (const Block& block : m_blocks)
+        ::operator delete(block.data);
+}
+
+void* BatchArena::Allocate(size_t size, size_t alignment)
+{
+    if (size == 0)
+        size = 1;
+
+    if (m_blocks.empty() || AlignedOffset(m_blocks.back(), m_offset, alignment) + size > m_blocks.back().size)
+    {
+        // New block: at least the doubled size, large enough for oversized requests
+        Block block;
+        block.size = std::max(m_nextBlockSize, size + alignment);
+        block.data = static_cast<char*>(::operator new(block.size));
+        m_blocks.push_back(block);
+        m_offset = 0;
+        m_nextBlockSize = std::min(m_nextBlockSize * 2, kMaxBlockSize);
+    }
+
+    const Block& block = m_blocks.back();
+    const size_t aligned = AlignedOffset(block, m_offset, alignment);
+    m_offset = aligned + size;
+    m_usedBytes += size;
+    return block.data + aligned;
+}
+
+bool BatchArena::Owns(const void* ptr) const
+{
+    const char* p = static_cast<const char*>(ptr);
+    for (auto it = m_blocks.rbegin(); it != m_blocks.rend(); ++it)
+    {
+        if (p >= it->data && p < it->data + it->size)
+            return true;
+    }
+    return false;
+}
+
+BatchArena* BatchArena::Current()
+{
+    return t_currentArena;
+}
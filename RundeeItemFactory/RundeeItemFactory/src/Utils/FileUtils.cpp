@@ -0,0 +1,214 @@
+/**
+ * @file FileUtils.cpp
+ * @brief Implementation of durable file write helpers
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/FileUtils.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /**
+     * @brief Write a buffer to an open file, flush it and sync it to disk
+     * @param file Open file
+     * @param text Data to write
+     * @return True on success
+     */
+    bool WriteAndSync(FILE* file, const std::string& text)
+    {
+        if (!text.empty() && std::fwrite(text.data(), 1, text.size(), file) != text.size())
+            return false;
+        if (std::fflush(file) != 0)
+            return false;
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    FILE* OpenFile(const std::string& filePath, const char* mode)
+    {
+#ifdef _WIN32
+        FILE* file = nullptr;
+        if (fopen_s(&file, filePath.c_str(), mode) != 0)
+            return nullptr;
+        return file;
+#else
+        return std::fopen(filePath.c_str(), mode);
+#endif
+    }
+}
+
+namespace FileUtils
+{
+    bool EnsureParentDirectories(const std::string& filePath)
+    {
+        std::filesystem::path parent = std::filesystem::path(filePath).parent_path();
+        if (parent.empty())
+            return true;
+        std::error_code ec;
+        std::filesystem::create_directories(parent, ec);
+        return std::filesystem::is_directory(parent, ec);
+    }
+
+    bool AppendDurable(const std::string& filePath, const std::string& text)
+    {
+        EnsureParentDirectories(filePath);
+        FILE* file = OpenFile(filePath, "ab");
+        if (!file)
+        {
+            std::cerr << "[FileUtils] Failed to open for append: " << filePath << "\n";
+            return false;
+        }
+        bool ok = WriteAndSync(file, text);
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok)
+        {
+            std::cerr << "[FileUtils] Failed to append durably: " << filePath << "\n";
+        }
+        return ok;
+    }
+
+    bool WriteFileAtomic(const std::string& filePath, const std::string& text)
+    {
+        EnsureParentDirectories(filePath);
+        const std::string tempPath = filePath + ".tmp";
+        FILE* file = OpenFile(tempPath, "wb");
+        if (!file)
+        {
+            std::cerr << "[FileUtils] Failed to open for writing: " << tempPath << "\n";
+            return false;
+        }
+        bool ok = WriteAndSync(file, text);
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok)
+        {
+            std::cerr << "[FileUtils] Failed to write: " << tempPath << "\n";
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, filePath, ec);
+        if (ec)
+        {
+            std::cerr << "[FileUtils] Failed to replace " << filePath << ": " << ec.message() << "\n";
+            return false;
+        }
+        return true;
+    }
+
+    AtomicFileWriter::~AtomicFileWriter()
+    {
+        Abort();
+    }
+
+    bool AtomicFileWriter::Open(const std::string& filePath)
+    {
+        Abort();
+        EnsureParentDirectories(filePath);
+        m_filePath = filePath;
+        m_tempPath = filePath + ".tmp";
+        m_file = OpenFile(m_tempPath, "wb");
+        if (!m_file)
+        {
+            std::cerr << "[FileUtils] Failed to open for writing: " << m_tempPath << "\n";
+            return false;
+        }
+        std::setvbuf(m_file, nullptr, _IOFBF, 1 << 20);
+        m_ok = true;
+        return true;
+    }
+
+    bool AtomicFileWriter::Write(const char* data, size_t size)
+    {
+        if (!m_file || !m_ok)
+            return false;
+        if (size > 0 && std::fwrite(data, 1, size, m_file) != size)
+            m_ok = false;
+        return m_ok;
+    }
+
+    bool AtomicFileWriter::Prepare()
+    {
+        if (m_prepared)
+            return true;
+        if (!m_file)
+            return false;
+        bool ok = m_ok && WriteAndSync(m_file, std::string());
+        ok = (std::fclose(m_file) == 0) && ok;
+        m_file = nullptr;
+        if (!ok)
+        {
+            std::cerr << "[FileUtils] Failed to write: " << m_tempPath << "\n";
+            Abort();
+            return false;
+        }
+        m_prepared = true;
+        return true;
+    }
+
+    bool AtomicFileWriter::Commit()
+    {
+        if (!Prepare())
+            return false;
+
+        std::error_code ec;
+        std::filesystem::rename(m_tempPath, m_filePath, ec);
+        if (ec)
+        {
+            std::cerr << "[FileUtils] Failed to replace " << m_filePath << ": " << ec.message() << "\n";
+            Abort();
+            return false;
+        }
+        m_tempPath.clear();
+        m_prepared = false;
+        return true;
+    }
+
+    void AtomicFileWriter::Abort()
+    {
+        if (m_file)
+        {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        if (!m_tempPath.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_tempPath, ec);
+            m_tempPath.clear();
+        }
+        m_ok = false;
+        m_prepared = false;
+    }
+
+    bool ReadFile(const std::string& filePath, std::string& outText)
+    {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        // Size first so large catalogs are read with one allocation and one read
+        file.seekg(0, std::ios::end);
+        const std::streamoff size = file.tellg();
+        if (size < 0)
+            return false;
+        file.seekg(0, std::ios::beg);
+        outText.resize(static_cast<size_t>(size));
+        if (size > 0 && !file.read(&outText[0], size))
+            return false;
+        return true;
+    }
+}
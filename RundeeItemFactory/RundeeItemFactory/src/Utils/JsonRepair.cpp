@@ -0,0 +1,559 @@
+/**
+ * @file JsonRepair.cpp
+ * @brief Implementation of the single-pass LLM JSON repair
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/JsonRepair.h"
+#include "Utils/JsonStringCodec.h"
+#include <sstream>
+
+namespace
+{
+    const size_t kNpos = std::string::npos;
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool IsLineSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    bool IsIdentStart(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    bool IsIdentChar(char c)
+    {
+        return IsIdentStart(c) || (c >= '0' && c <= '9');
+    }
+
+    /** @brief Bytes that end a bare scalar token (number or literal) */
+    bool IsDelimiter(char c)
+    {
+        return IsSpace(c) || c == ',' || c == ':' || c == '"' ||
+               c == '[' || c == ']' || c == '{' || c == '}';
+    }
+
+    /**
+     * @class Repairer
+     * @brief Lexer state for one RepairJsonText() call
+     */
+    class Repairer
+    {
+    public:
+        Repairer(const std::string& input, size_t begin, size_t end, JsonRepair::RepairReport& report)
+            : m_in(input), m_pos(begin), m_end(end), m_report(report)
+        {
+            m_out.reserve(end - begin + 16);
+        }
+
+        std::string Run();
+
+    private:
+        /** @brief What the lexer accepts next */
+        enum class Expect
+        {
+            Value,       ///< Value, or the closer of an array
+            Key,         ///< Object key, or '}'
+            Colon,       ///< ':' after a key
+            CommaOrEnd   ///< ',' or the closer of the current container
+        };
+
+        char Top() const { return m_stack[m_depth - 1]; }
+
+        void Emit(char c)
+        {
+            m_out += c;
+            m_afterComma = false;
+        }
+
+        void EmitComma()
+        {
+            m_commaPos = m_out.size();
+            m_out += ',';
+            m_afterComma = true;
+            m_expect = (Top() == '{') ? Expect::Key : Expect::Value;
+        }
+
+        /** @brief Drop the comma emitted last; only whitespace follows it */
+        void EraseTrailingComma()
+        {
+            if (!m_afterComma)
+                return;
+            m_out.erase(m_commaPos, 1);
+            m_afterComma = false;
+            m_report.removedCommas++;
+        }
+
+        /** @brief A value just ended at the current depth */
+        void ValueDone()
+        {
+            m_expect = Expect::CommaOrEnd;
+            if (m_depth == 1)
+                m_lastElementEnd = m_out.size();
+        }
+
+        bool Open(char c);
+        void Close(char closer);
+        bool AtEllipsisLine() const;
+        bool TryRequoteKey();
+        bool LexString(bool isKey);
+        void LexScalar();
+        void Finish();
+
+        const std::string& m_in;
+        size_t m_pos;
+        size_t m_end;
+        JsonRepair::RepairReport& m_report;
+        std::string m_out;
+
+        char m_stack[JsonRepair::kMaxDepth] = {};
+        int m_depth = 0;
+        Expect m_expect = Expect::Value;
+
+        bool m_afterComma = false;         ///< Only whitespace has been emitted since the last comma
+        size_t m_commaPos = 0;             ///< Output offset of that comma
+        bool m_keyIsId = false;            ///< The pending value belongs to an "id" key
+        bool m_inString = false;           ///< Input ended inside a string
+        bool m_stringIsKey = false;
+        size_t m_lastElementEnd = kNpos;   ///< Output offset after the last complete root-array element
+    };
+
+    bool Repairer::Open(char c)
+    {
+        if (m_depth == JsonRepair::kMaxDepth)
+            return false;
+        m_stack[m_depth++] = c;
+        Emit(c);
+        m_expect = (c == '{') ? Expect::Key : Expect::Value;
+        return true;
+    }
+
+    void Repairer::Close(char closer)
+    {
+        const char opener = (closer == ']') ? '[' : '{';
+
+        // A closer that matches nothing open is stray
+        int match = m_depth - 1;
+        while (match >= 0 && m_stack[match] != opener)
+            --match;
+        if (match < 0)
+            return;
+
+        if (m_expect == Expect::Colon)
+        {
+            m_out += ":null";
+            m_report.insertedColons++;
+        }
+        else if (m_expect == Expect::Value && Top() == '{')
+        {
+            m_out += "null";
+        }
+        EraseTrailingComma();
+
+        while (m_depth - 1 > match)
+        {
+            Emit(Top() == '{' ? '}' : ']');
+            --m_depth;
+            m_report.closedContainers++;
+        }
+        Emit(closer);
+        --m_depth;
+        ValueDone();
+    }
+
+    bool Repairer::AtEllipsisLine() const
+    {
+        if (m_end - m_pos < 3 || m_in.compare(m_pos, 3, "...") != 0)
+            return false;
+
+        size_t back = m_pos;
+        while (back > 0 && IsLineSpace(m_in[back - 1]))
+            --back;
+        if (back > 0 && m_in[back - 1] != '\n')
+            return false;
+
+        size_t ahead = m_pos + 3;
+        while (ahead < m_end && IsLineSpace(m_in[ahead]))
+            ++ahead;
+        return ahead == m_end || m_in[ahead] == '\n';
+    }
+
+    bool Repairer::TryRequoteKey()
+    {
+        // )rarity": -> "rarity":
+        size_t p = m_pos + 1;
+        if (p >= m_end || !IsIdentStart(m_in[p]))
+            return false;
+        while (p < m_end && IsIdentChar(m_in[p]))
+            ++p;
+        const size_t keyEnd = p;
+        while (p < m_end && (m_in[p] == ' ' || m_in[p] == '\t'))
+            ++p;
+        if (p >= m_end || m_in[p] != '"')
+            return false;
+
+        Emit('"');
+        m_out.append(m_in, m_pos + 1, keyEnd - m_pos - 1);
+        m_out += '"';
+        m_keyIsId = (keyEnd - m_pos - 1 == 2 && m_in.compare(m_pos + 1, 2, "id") == 0);
+        m_report.requotedKeys++;
+        m_pos = p + 1;
+        m_expect = Expect::Colon;
+        return true;
+    }
+
+    bool Repairer::LexString(bool isKey)
+    {
+        const bool fixId = !isKey && m_keyIsId;
+        bool idChanged = false;
+        const size_t contentStart = m_out.size() + 1;
+        Emit('"');
+        ++m_pos;
+
+        while (m_pos < m_end)
+        {
+            const size_t run = JsonStringCodec::FindEscapeNeeded(m_in.data() + m_pos, m_end - m_pos);
+            if (fixId)
+            {
+                for (size_t k = 0; k < run; ++k)
+                {
+                    char c = m_in[m_pos + k];
+                    if (c == ' ')
+                    {
+                        c = '_';
+                        idChanged = true;
+                    }
+                    m_out += c;
+                }
+            }
+            else
+            {
+                m_out.append(m_in, m_pos, run);
+            }
+            m_pos += run;
+            if (m_pos == m_end)
+                break;
+
+            const char c = m_in[m_pos];
+            if (c == '"')
+            {
+                m_out += '"';
+                ++m_pos;
+                if (isKey)
+                    m_keyIsId = (m_out.size() - contentStart == 3 && m_out.compare(contentStart, 2, "id") == 0);
+                if (idChanged)
+                    m_report.fixedIds++;
+                return true;
+            }
+            if (c == '\\')
+            {
+                if (m_pos + 1 == m_end)
+                {
+                    ++m_pos;
+                    break;
+                }
+                m_out.append(m_in, m_pos, 2);
+                m_pos += 2;
+                continue;
+            }
+
+            char escaped[JsonStringCodec::kMaxEscapeLength];
+            m_out.append(escaped, JsonStringCodec::EscapeChar(static_cast<unsigned char>(c), escaped));
+            m_report.escapedControlChars++;
+            ++m_pos;
+        }
+
+        m_inString = true;
+        m_stringIsKey = isKey;
+        if (idChanged)
+            m_report.fixedIds++;
+        return false;
+    }
+
+    void Repairer::LexScalar()
+    {
+        const size_t start = m_pos;
+        while (m_pos < m_end && !IsDelimiter(m_in[m_pos]))
+            ++m_pos;
+        m_out.append(m_in, start, m_pos - start);
+        m_afterComma = false;
+        ValueDone();
+    }
+
+    std::string Repairer::Run()
+    {
+        Open(m_in[m_pos++]);
+
+        while (m_pos < m_end)
+        {
+            const char c = m_in[m_pos];
+            if (IsSpace(c))
+            {
+                m_out += c;
+                ++m_pos;
+                continue;
+            }
+            if (c == '.' && AtEllipsisLine())
+            {
+                m_report.truncatedAtEllipsis = true;
+                break;
+            }
+
+            switch (m_expect)
+            {
+            case Expect::CommaOrEnd:
+                if (c == ',')
+                {
+                    EmitComma();
+                    ++m_pos;
+                }
+                else if (c == ']' || c == '}')
+                {
+                    Close(c);
+                    ++m_pos;
+                }
+                else if (c == '"' || c == '{' || c == '[' || (c == ')' && Top() == '{') ||
+                         c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n')
+                {
+                    // Two values with nothing between them: the model dropped a comma
+                    EmitComma();
+                    m_report.insertedCommas++;
+                }
+                else
+                {
+                    ++m_pos;
+                }
+                break;
+
+            case Expect::Key:
+                if (c == '"')
+                {
+                    if (!LexString(true))
+                        break;
+                    m_expect = Expect::Colon;
+                }
+                else if (c == '}' || c == ']')
+                {
+                    Close(c);
+                    ++m_pos;
+                }
+                else if (c == ',')
+                {
+                    m_report.removedCommas++;
+                    ++m_pos;
+                }
+                else if (!(c == ')' && TryRequoteKey()))
+                {
+                    ++m_pos;
+                }
+                break;
+
+            case Expect::Colon:
+                if (c == ':')
+                {
+                    Emit(':');
+                    ++m_pos;
+                    m_expect = Expect::Value;
+                }
+                else if (c == ',' || c == '}' || c == ']')
+                {
+                    // Key without a value
+                    m_out += ":null";
+                    m_report.insertedColons++;
+                    ValueDone();
+                }
+                else
+                {
+                    m_out += ':';
+                    m_report.insertedColons++;
+                    m_expect = Expect::Value;
+                }
+                break;
+
+            case Expect::Value:
+                if (c == '"')
+                {
+                    if (LexString(false))
+                        ValueDone();
+                }
+                else if (c == '{' || c == '[')
+                {
+                    if (!Open(c))
+                        m_pos = m_end; // Too deep to track: treat as truncated here
+                    else
+                        ++m_pos;
+                }
+                else if (c == ']' || c == '}')
+                {
+                    Close(c);
+                    ++m_pos;
+                }
+                else if (c == ',')
+                {
+                    if (Top() == '{')
+                    {
+                        // "key": , -> "key": null,
+                        m_out += "null";
+                        ValueDone();
+                    }
+                    else
+                    {
+                        m_report.removedCommas++;
+                        ++m_pos;
+                    }
+                }
+                else if (c == ':')
+                {
+                    ++m_pos;
+                }
+                else
+                {
+                    LexScalar();
+                }
+                break;
+            }
+
+            if (m_depth == 0)
+            {
+                // Root closed: the rest is prose
+                size_t tail = m_end;
+                while (tail > m_pos && IsSpace(m_in[tail - 1]))
+                    --tail;
+                m_report.skippedTrailingBytes = tail - m_pos;
+                return std::move(m_out);
+            }
+        }
+
+        Finish();
+        return std::move(m_out);
+    }
+
+    void Repairer::Finish()
+    {
+        bool objectOpen = false;
+        for (int d = 1; d < m_depth; ++d)
+            objectOpen = objectOpen || m_stack[d] == '{';
+
+        if (m_stack[0] == '[' && (m_inString || objectOpen))
+        {
+            // Cut the root array back to its last complete element
+            m_out.resize(m_lastElementEnd != kNpos ? m_lastElementEnd : 1);
+            m_report.droppedPartialElements++;
+            m_out += "\n]";
+            m_report.closedContainers++;
+            return;
+        }
+
+        if (m_inString)
+        {
+            m_out += '"';
+            m_expect = m_stringIsKey ? Expect::Colon : Expect::CommaOrEnd;
+        }
+        if (m_expect == Expect::Colon)
+        {
+            m_out += ":null";
+            m_report.insertedColons++;
+        }
+        else if (m_expect == Expect::Value && Top() == '{')
+        {
+            m_out += "null";
+        }
+        EraseTrailingComma();
+
+        while (m_depth > 0)
+        {
+            m_out += (Top() == '{') ? "\n}" : "\n]";
+            --m_depth;
+            m_report.closedContainers++;
+        }
+    }
+}
+
+namespace JsonRepair
+{
+    bool RepairReport::Changed() const
+    {
+        return skippedLeadingBytes > 0 || skippedTrailingBytes > 0 || removedCommas > 0 ||
+               insertedCommas > 0 || insertedColons > 0 || requotedKeys > 0 || fixedIds > 0 ||
+               escapedControlChars > 0 || closedContainers > 0 || droppedPartialElements > 0 ||
+               truncatedAtEllipsis;
+    }
+
+    std::string RepairReport::Summary() const
+    {
+        std::ostringstream ss;
+        const char* sep = "";
+        auto add = [&](size_t count, const char* what)
+        {
+            if (count == 0)
+                return;
+            ss << sep << what << "=" << count;
+            sep = " ";
+        };
+        add(skippedLeadingBytes, "leadingBytes");
+        add(skippedTrailingBytes, "trailingBytes");
+        add(removedCommas, "removedCommas");
+        add(insertedCommas, "insertedCommas");
+        add(insertedColons, "insertedColons");
+        add(requotedKeys, "requotedKeys");
+        add(fixedIds, "fixedIds");
+        add(escapedControlChars, "escapedControlChars");
+        add(closedContainers, "closedContainers");
+        add(droppedPartialElements, "droppedElements");
+        if (truncatedAtEllipsis)
+            ss << sep << "truncatedAtEllipsis";
+        return ss.str();
+    }
+
+    std::string RepairJsonText(const std::string& input, RepairReport* outReport)
+    {
+        RepairReport report;
+
+        size_t begin = 0;
+        size_t end = input.size();
+        while (begin < end && IsSpace(input[begin]))
+            ++begin;
+        while (end > begin && IsSpace(input[end - 1]))
+            --end;
+
+        // The item array is the root: the first '[' that opens an object or closes at once,
+        // so "[2]" in the prose before it is skipped. Otherwise the first '[', and a lone
+        // object is accepted when there is no array
+        size_t root = kNpos;
+        for (size_t p = input.find('[', begin); p != kNpos && p < end; p = input.find('[', p + 1))
+        {
+            size_t next = p + 1;
+            while (next < end && IsSpace(input[next]))
+                ++next;
+            if (next < end && (input[next] == '{' || input[next] == ']'))
+            {
+                root = p;
+                break;
+            }
+        }
+        if (root == kNpos)
+            root = input.find('[', begin);
+        if (root == kNpos || root >= end)
+            root = input.find('{', begin);
+        if (root == kNpos || root >= end)
+        {
+            if (outReport)
+                *outReport = report;
+            return input.substr(begin, end - begin);
+        }
+
+        report.skippedLeadingBytes = root - begin;
+        std::string out = Repairer(input, root, end, report).Run();
+        if (outReport)
+            *outReport = report;
+        return out;
+    }
+}
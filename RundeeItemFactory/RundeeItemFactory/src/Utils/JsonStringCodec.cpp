@@ -0,0 +1,186 @@
+/**
+ * @file JsonStringCodec.cpp
+ * @brief Implementation of the JSON string scanning helpers
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/JsonStringCodec.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RUNDEE_JSON_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace
+{
+#ifdef RUNDEE_JSON_SSE2
+    /** @brief Index of the lowest set bit of a non-zero 16-bit mask */
+    inline unsigned LowestBit(unsigned mask)
+    {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return static_cast<unsigned>(index);
+#else
+        return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+    }
+#endif
+}
+
+namespace JsonStringCodec
+{
+    size_t FindQuoteOrBackslash(const char* data, size_t size)
+    {
+        size_t i = 0;
+#ifdef RUNDEE_JSON_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            const __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (mask != 0)
+                return i + LowestBit(mask);
+        }
+#endif
+        for (; i < size; ++i)
+        {
+            if (data[i] == '"' || data[i] == '\\')
+                return i;
+        }
+        return size;
+    }
+
+    size_t FindEscapeNeeded(const char* data, size_t size)
+    {
+        size_t i = 0;
+#ifdef RUNDEE_JSON_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i controlMax = _mm_set1_epi8(0x1F);
+        for (; i + 16 <= size; i += 16)
+        {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            // Unsigned c <= 0x1F  <=>  max(c, 0x1F) == 0x1F
+            const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(chunk, controlMax), controlMax);
+            const __m128i hits = _mm_or_si128(control,
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+            if (mask != 0)
+                return i + LowestBit(mask);
+        }
+#endif
+        for (; i < size; ++i)
+        {
+            const unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c == '"' || c == '\\' || c < 0x20)
+                return i;
+        }
+        return size;
+    }
+
+    size_t EscapeChar(unsigned char c, char* out)
+    {
+        static const char kHex[] = "0123456789abcdef";
+        out[0] = '\\';
+        switch (c)
+        {
+        case '"': out[1] = '"'; return 2;
+        case '\\': out[1] = '\\'; return 2;
+        case '\b': out[1] = 'b'; return 2;
+        case '\f': out[1] = 'f'; return 2;
+        case '\n': out[1] = 'n'; return 2;
+        case '\r': out[1] = 'r'; return 2;
+        case '\t': out[1] = 't'; return 2;
+        default:
+            out[1] = 'u';
+            out[2] = '0';
+            out[3] = '0';
+            out[4] = kHex[c >> 4];
+            out[5] = kHex[c & 0x0F];
+            return 6;
+        }
+    }
+
+    size_t EscapedLength(const char* data, size_t size)
+    {
+        size_t length = size;
+        char scratch[kMaxEscapeLength];
+        for (size_t i = FindEscapeNeeded(data, size); i < size; i += 1 + FindEscapeNeeded(data + i + 1, size - i - 1))
+            length += EscapeChar(static_cast<unsigned char>(data[i]), scratch) - 1;
+        return length;
+    }
+
+    void AppendEscaped(std::string& out, const char* data, size_t size)
+    {
+        char escape[kMaxEscapeLength];
+        size_t i = 0;
+        while (i < size)
+        {
+            const size_t run = FindEscapeNeeded(data + i, size - i);
+            out.append(data + i, run);
+            i += run;
+            if (i == size)
+                break;
+            out.append(escape, EscapeChar(static_cast<unsigned char>(data[i]), escape));
+            ++i;
+        }
+    }
+
+    bool ParseHex4(const char* digits, uint32_t& outValue)
+    {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const char c = digits[i];
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+                value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            else
+                return false;
+        }
+        outValue = value;
+        return true;
+    }
+
+    void AppendUtf8(std::string& out, uint32_t codePoint)
+    {
+        if (codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+            codePoint = 0xFFFD;
+
+        if (codePoint < 0x80)
+        {
+            out.push_back(static_cast<char>(codePoint));
+        }
+        else if (codePoint < 0x800)
+        {
+            out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else if (codePoint < 0x10000)
+        {
+            out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+        }
+    }
+}
@@ -10,6 +10,7 @@
 
 #include "Utils/JsonUtils.h"
 #include <algorithm>
+#include <cstring>
 
 namespace JsonUtils
 {
@@ -48,4 +49,165 @@ namespace JsonUtils
     {
         return std::max(minV, std::min(maxV, v));
     }
+
+    bool ScanTopLevelArray(const char* data, size_t size, const std::function<bool(size_t, size_t)>& onElement)
+    {
+        auto isSpace = [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+
+        size_t pos = 0;
+        while (pos < size && isSpace(data[pos]))
+            ++pos;
+        if (pos >= size || data[pos] != '[')
+            return false;
+        ++pos;
+
+        int depth = 0;            // Nesting depth inside the root array
+        size_t elementBegin = std::string::npos;
+        for (; pos < size; ++pos)
+        {
+            const char c = data[pos];
+            if (c == '"')
+            {
+                if (elementBegin == std::string::npos)
+                    elementBegin = pos;
+                // Jump to the closing quote, skipping escaped characters
+                for (++pos; pos < size && data[pos] != '"'; ++pos)
+                {
+                    if (data[pos] == '\\')
+                        ++pos;
+                }
+                continue;
+            }
+            if (isSpace(c))
+                continue;
+            if (depth == 0 && (c == ',' || c == ']'))
+            {
+                if (elementBegin != std::string::npos)
+                {
+                    size_t elementEnd = pos;
+                    while (elementEnd > elementBegin && isSpace(data[elementEnd - 1]))
+                        --elementEnd;
+                    if (!onElement(elementBegin, elementEnd))
+                        return true;
+                    elementBegin = std::string::npos;
+                }
+                if (c == ']')
+                    return true;
+                continue;
+            }
+
+            if (elementBegin == std::string::npos)
+                elementBegin = pos;
+            if (c == '{' || c == '[')
+                ++depth;
+            else if (c == '}' || c == ']')
+                --depth;
+        }
+        return false;
+    }
+
+    bool SplitTopLevelArray(const char* data, size_t size, std::vector<std::pair<size_t, size_t>>& outSpans)
+    {
+        outSpans.clear();
+        return ScanTopLevelArray(data, size, [&outSpans](size_t begin, size_t end)
+        {
+            outSpans.emplace_back(begin, end);
+            return true;
+        });
+    }
+
+    bool FindTopLevelString(const char* data, size_t size, const char* key, std::string& outValue)
+    {
+        auto isSpace = [](char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; };
+        // Returns the position of the closing quote of the string opening at pos
+        auto skipString = [data, size](size_t pos)
+        {
+            for (++pos; pos < size && data[pos] != '"'; ++pos)
+            {
+                if (data[pos] == '\\')
+                    ++pos;
+            }
+            return pos;
+        };
+
+        const size_t keyLength = std::strlen(key);
+        size_t pos = 0;
+        while (pos < size && isSpace(data[pos]))
+            ++pos;
+        if (pos >= size || data[pos] != '{')
+            return false;
+        ++pos;
+
+        while (pos < size)
+        {
+            while (pos < size && (isSpace(data[pos]) || data[pos] == ','))
+                ++pos;
+            if (pos >= size || data[pos] != '"')
+                return false; // '}' or malformed
+            const size_t keyBegin = pos + 1;
+            pos = skipString(pos);
+            if (pos >= size)
+                return false;
+            const bool keyMatches = (pos - keyBegin == keyLength) && std::memcmp(data + keyBegin, key, keyLength) == 0;
+            ++pos;
+
+            while (pos < size && isSpace(data[pos]))
+                ++pos;
+            if (pos >= size || data[pos] != ':')
+                return false;
+            ++pos;
+            while (pos < size && isSpace(data[pos]))
+                ++pos;
+            if (pos >= size)
+                return false;
+
+            if (data[pos] == '"')
+            {
+                const size_t valueBegin = pos + 1;
+                pos = skipString(pos);
+                if (pos >= size)
+                    return false;
+                if (keyMatches)
+                {
+                    const char* raw = data + valueBegin;
+                    const size_t rawLength = pos - valueBegin;
+                    if (std::memchr(raw, '\\', rawLength) == nullptr)
+                    {
+                        outValue.assign(raw, rawLength);
+                        return true;
+                    }
+                    // Escaped strings are rare in IDs; let the full parser decode them
+                    json decoded = json::parse(raw - 1, raw + rawLength + 1, nullptr, false);
+                    if (!decoded.is_string())
+                        return false;
+                    outValue = decoded.get<std::string>();
+                    return true;
+                }
+                ++pos;
+                continue;
+            }
+            if (keyMatches)
+                return false; // Not a string
+
+            // Skip a number, literal, object or array value
+            int depth = 0;
+            for (; pos < size; ++pos)
+            {
+                const char c = data[pos];
+                if (c == '"')
+                    pos = skipString(pos);
+                else if (c == '{' || c == '[')
+                    ++depth;
+                else if (c == '}' || c == ']')
+                {
+                    if (depth == 0)
+                        return false; // End of the object
+                    --depth;
+                }
+                else if (c == ',' && depth == 0)
+                    break;
+            }
+        }
+        return false;
+    }
 }
@@ -0,0 +1,146 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the read-only file mapping
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Utils/MappedFile.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_open = true;
+    if (m_size == 0)
+        return true; // Zero-length files cannot be mapped
+
+    m_mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle)
+        m_data = static_cast<const char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!m_data)
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mappingHandle)
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    if (m_fileHandle)
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_data = nullptr;
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+    m_size = 0;
+    m_open = false;
+}
+
+void MappedFile::AdviseSequential()
+{
+    // FILE_FLAG_SEQUENTIAL_SCAN is already set when the file is opened
+}
+
+void MappedFile::Release(size_t offset, size_t length)
+{
+    if (!m_data || offset >= m_size)
+        return;
+    // Unlocking pages that are not locked removes them from the working set
+    VirtualUnlock(const_cast<char*>(m_data) + offset, (length < m_size - offset) ? length : m_size - offset);
+}
+
+#else
+
+bool MappedFile::Open(const std::string& path)
+{
+    Close();
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    m_fd = fd;
+    m_size = static_cast<size_t>(st.st_size);
+    m_open = true;
+    if (m_size == 0)
+        return true; // Zero-length files cannot be mapped
+
+    void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+        Close();
+        return false;
+    }
+    m_data = static_cast<const char*>(view);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (m_data)
+        munmap(const_cast<char*>(m_data), m_size);
+    if (m_fd >= 0)
+        ::close(m_fd);
+    m_data = nullptr;
+    m_fd = -1;
+    m_size = 0;
+    m_open = false;
+}
+
+void MappedFile::AdviseSequential()
+{
+    if (m_data)
+        madvise(const_cast<char*>(m_data), m_size, MADV_SEQUENTIAL);
+}
+
+void MappedFile::Release(size_t offset, size_t length)
+{
+    if (!m_data || offset >= m_size)
+        return;
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t end = (length < m_size - offset) ? offset + length : m_size;
+    const size_t alignedBegin = (offset + pageSize - 1) / pageSize * pageSize;
+    const size_t alignedEnd = (end == m_size) ? end : end / pageSize * pageSize;
+    if (alignedEnd > alignedBegin)
+        madvise(const_cast<char*>(m_data) + alignedBegin, alignedEnd - alignedBegin, MADV_DONTNEED);
+}
+
+#endif
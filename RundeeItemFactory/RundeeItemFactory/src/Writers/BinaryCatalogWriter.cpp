@@ -0,0 +1,150 @@
+/**
+ * @file BinaryCatalogWriter.cpp
+ * @brief Implementation of the binary catalog writer
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Writers/BinaryCatalogWriter.h"
+#include "Parsers/BinaryCatalogReader.h"
+#include "Utils/FileUtils.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <set>
+
+using namespace BinaryCatalogFormat;
+
+namespace
+{
+    /**
+     * @struct PendingEntry
+     * @brief Index entry collected while records are appended
+     */
+    struct PendingEntry
+    {
+        std::string id;
+        uint64_t recordOffset = 0;
+        uint32_t recordLength = 0;
+    };
+}
+
+std::string BinaryCatalogWriter::GetBinaryPath(const std::string& jsonPath)
+{
+    std::filesystem::path path(jsonPath);
+    path.replace_extension(".ricat");
+    return path.string();
+}
+
+bool BinaryCatalogWriter::WriteItemsToFile(
+    std::vector<nlohmann::json>&& items,
+    const std::string& path,
+    bool mergeWithExisting,
+    FileUtils::AtomicFileWriter* staged)
+{
+    if (items.empty())
+    {
+        std::cerr << "[BinaryCatalogWriter] Warning: No items to write.\n";
+        return false;
+    }
+
+    std::string out(kHeaderMagic, sizeof(kHeaderMagic));
+    PutLE<uint32_t>(out, kVersion);
+    PutLE<uint32_t>(out, 0);
+
+    std::vector<PendingEntry> entries;
+    std::set<std::string> existingIds;
+
+    // Existing records keep their offsets: the header size never changes, so the
+    // record section is copied as one block without decoding any item
+    if (mergeWithExisting && std::filesystem::exists(path))
+    {
+        BinaryCatalogReader reader;
+        std::string records;
+        if (reader.Open(path) && reader.ReadRecordSection(records))
+        {
+            out += records;
+            entries.reserve(reader.GetCount() + items.size());
+            for (size_t i = 0; i < reader.GetCount(); ++i)
+            {
+                PendingEntry entry;
+                entry.id = reader.GetId(i);
+                entry.recordOffset = reader.GetRecordOffset(i);
+                entry.recordLength = reader.GetRecordLength(i);
+                existingIds.insert(entry.id);
+                entries.push_back(std::move(entry));
+            }
+        }
+        else
+        {
+            std::cerr << "[BinaryCatalogWriter] Warning: Failed to read existing catalog, rewriting: " << path << "\n";
+        }
+    }
+
+    int addedCount = 0;
+    for (auto& item : items)
+    {
+        if (!item.is_object())
+            continue;
+
+        auto idIt = item.find("id");
+        if (idIt == item.end() || !idIt->is_string())
+        {
+            std::cerr << "[BinaryCatalogWriter] Warning: Item missing 'id' field, skipping.\n";
+            continue;
+        }
+
+        std::string& itemId = idIt->get_ref<std::string&>();
+        if (!existingIds.insert(itemId).second)
+            continue; // Skip duplicate
+
+        std::vector<uint8_t> record = nlohmann::json::to_msgpack(item);
+        PendingEntry entry;
+        entry.id = std::move(itemId); // Encoded already; the index takes the ID string
+        entry.recordOffset = out.size();
+        entry.recordLength = static_cast<uint32_t>(record.size());
+        out.append(reinterpret_cast<const char*>(record.data()), record.size());
+        entries.push_back(std::move(entry));
+        addedCount++;
+    }
+    items.clear();
+
+    // Sorted index + id pool + footer
+    std::sort(entries.begin(), entries.end(),
+        [](const PendingEntry& a, const PendingEntry& b) { return a.id < b.id; });
+
+    const uint64_t indexOffset = out.size();
+    uint64_t poolSize = 0;
+    for (const auto& entry : entries)
+    {
+        PutLE<uint64_t>(out, entry.recordOffset);
+        PutLE<uint64_t>(out, poolSize);
+        PutLE<uint32_t>(out, static_cast<uint32_t>(entry.id.size()));
+        PutLE<uint32_t>(out, entry.recordLength);
+        poolSize += entry.id.size();
+    }
+    const uint64_t poolOffset = out.size();
+    for (const auto& entry : entries)
+        out += entry.id;
+
+    PutLE<uint64_t>(out, indexOffset);
+    PutLE<uint64_t>(out, poolOffset);
+    PutLE<uint64_t>(out, poolSize);
+    PutLE<uint64_t>(out, static_cast<uint64_t>(entries.size()));
+    out.append(kFooterMagic, sizeof(kFooterMagic));
+
+    FileUtils::AtomicFileWriter localOutput;
+    FileUtils::AtomicFileWriter& output = staged ? *staged : localOutput;
+    const bool written = output.Open(path) && output.Write(out) &&
+                         (staged ? output.Prepare() : output.Commit());
+    if (!written)
+    {
+        std::cerr << "[BinaryCatalogWriter] Error: Failed to write file: " << path << "\n";
+        return false;
+    }
+
+    std::cout << "[BinaryCatalogWriter] Wrote " << addedCount << " new items to " << path
+              << " (total: " << entries.size() << " items)\n";
+    return true;
+}
@@ -7,17 +7,39 @@
  */
 
 #include "Writers/DynamicItemJsonWriter.h"
+#include "Parsers/LazyCatalogReader.h"
+#include "Utils/FileUtils.h"
+#include "Utils/JsonUtils.h"
 #include "Utils/StringUtils.h"
-#include <fstream>
 #include <iostream>
 #include <filesystem>
 
 using nlohmann::json;
 
+namespace
+{
+    /**
+     * @brief Indent a pretty-printed element by one level, as dump(2) does inside an array
+     */
+    std::string IndentElement(const std::string& text)
+    {
+        std::string out = "  ";
+        out.reserve(text.size() + 64);
+        for (char c : text)
+        {
+            out.push_back(c);
+            if (c == '\n')
+                out += "  ";
+        }
+        return out;
+    }
+}
+
 bool DynamicItemJsonWriter::WriteItemsToFile(
-    const std::vector<nlohmann::json>& items,
+    std::vector<nlohmann::json>&& items,
     const std::string& path,
-    bool mergeWithExisting)
+    bool mergeWithExisting,
+    FileUtils::AtomicFileWriter* staged)
 {
     if (items.empty())
     {
@@ -25,143 +47,105 @@ bool DynamicItemJsonWriter::WriteItemsToFile(
         return false;
     }
     
-    // Ensure parent directory exists
-    std::filesystem::path filePath(path);
-    if (filePath.has_parent_path())
+    FileUtils::AtomicFileWriter localOutput;
+    FileUtils::AtomicFileWriter& output = staged ? *staged : localOutput;
+    if (!output.Open(path))
     {
-        std::filesystem::create_directories(filePath.parent_path());
+        std::cerr << "[DynamicItemJsonWriter] Error: Failed to open file for writing: " << path << "\n";
+        return false;
     }
     
-    json outputArray = json::array();
-    
-    // If merging, load existing items first
+    // Existing elements are copied from the mapped file as raw text; only their
+    // IDs are decoded, so merging never builds a DOM of the whole catalog
+    std::set<std::string> existingIds;
+    size_t totalCount = 0;
+    LazyCatalogReader existing;
     if (mergeWithExisting && std::filesystem::exists(path))
     {
-        try
+        if (existing.Open(path))
         {
-            std::ifstream file(path);
-            if (file.is_open())
+            std::string id;
+            const bool complete = existing.ForEachItem([&](const char* text, size_t length)
             {
-                json existingJson;
-                file >> existingJson;
-                file.close();
-                
-                if (existingJson.is_array())
-                {
-                    outputArray = existingJson;
-                }
+                output.Write(totalCount == 0 ? "[\n  " : ",\n  ");
+                output.Write(text, length);
+                if (JsonUtils::FindTopLevelString(text, length, "id", id))
+                    existingIds.insert(id);
+                ++totalCount;
+                return true;
+            });
+            if (!complete)
+            {
+                std::cerr << "[DynamicItemJsonWriter] Warning: Existing file is truncated, keeping "
+                          << totalCount << " readable items: " << path << "\n";
             }
         }
-        catch (const std::exception& e)
+        else
         {
-            std::cerr << "[DynamicItemJsonWriter] Warning: Failed to read existing file: " << e.what() << "\n";
-            // Continue with empty array
-        }
-    }
-    
-    // Collect existing IDs for duplicate checking
-    std::set<std::string> existingIds;
-    for (const auto& item : outputArray)
-    {
-        if (item.is_object() && item.contains("id") && item["id"].is_string())
-        {
-            existingIds.insert(item["id"].get<std::string>());
+            std::cerr << "[DynamicItemJsonWriter] Warning: Failed to read existing file: " << path << "\n";
         }
     }
     
     // Add new items, skipping duplicates
     int addedCount = 0;
-    for (const auto& item : items)
+    for (auto& item : items)
     {
         if (!item.is_object())
             continue;
         
-        if (!item.contains("id") || !item["id"].is_string())
+        auto idIt = item.find("id");
+        if (idIt == item.end() || !idIt->is_string())
         {
             std::cerr << "[DynamicItemJsonWriter] Warning: Item missing 'id' field, skipping.\n";
             continue;
         }
         
-        std::string itemId = item["id"].get<std::string>();
-        if (existingIds.find(itemId) != existingIds.end())
+        std::string& id = idIt->get_ref<std::string&>();
+        if (existingIds.count(id) > 0)
         {
             continue; // Skip duplicate
         }
         
-        outputArray.push_back(item);
-        existingIds.insert(itemId);
+        output.Write(totalCount == 0 ? "[\n" : ",\n");
+        output.Write(IndentElement(item.dump(2)));
+        existingIds.insert(std::move(id)); // The item is written; its ID string can be taken
+        ++totalCount;
         addedCount++;
     }
+    items.clear();
+    output.Write(totalCount == 0 ? "[]" : "\n]");
     
-    // Write to file
-    try
-    {
-        std::ofstream file(path);
-        if (!file.is_open())
-        {
-            std::cerr << "[DynamicItemJsonWriter] Error: Failed to open file for writing: " << path << "\n";
-            return false;
-        }
-        
-        file << outputArray.dump(2); // Pretty print with 2 spaces
-        file.close();
-        
-        std::cout << "[DynamicItemJsonWriter] Wrote " << addedCount << " new items to " << path 
-                  << " (total: " << outputArray.size() << " items)\n";
-        
-        return true;
-    }
-    catch (const std::exception& e)
+    // The mapping must be released before the file is replaced (required on Windows)
+    existing.Close();
+    if (staged ? !output.Prepare() : !output.Commit())
     {
-        std::cerr << "[DynamicItemJsonWriter] Error: Failed to write file: " << e.what() << "\n";
+        std::cerr << "[DynamicItemJsonWriter] Error: Failed to write file: " << path << "\n";
         return false;
     }
+    
+    std::cout << "[DynamicItemJsonWriter] Wrote " << addedCount << " new items to " << path 
+              << " (total: " << totalCount << " items)\n";
+    return true;
 }
 
 std::set<std::string> DynamicItemJsonWriter::GetExistingIds(const std::string& path)
 {
     std::set<std::string> ids;
     
-    if (!std::filesystem::exists(path))
+    LazyCatalogReader reader;
+    if (!std::filesystem::exists(path) || !reader.Open(path))
     {
         return ids;
     }
     
-    try
-    {
-        std::ifstream file(path);
-        if (!file.is_open())
-        {
-            return ids;
-        }
-        
-        json jsonData;
-        file >> jsonData;
-        file.close();
-        
-        if (jsonData.is_array())
-        {
-            for (const auto& item : jsonData)
-            {
-                if (item.is_object() && item.contains("id") && item["id"].is_string())
-                {
-                    ids.insert(item["id"].get<std::string>());
-                }
-            }
-        }
-    }
-    catch (const std::exception&)
-    {
-        // Return empty set on error
-    }
-    
+    reader.ForEachId([&ids](const std::string& id) { ids.insert(id); });
     return ids;
 }
 
 bool DynamicItemJsonWriter::MergeItemsWithFile(
-    const std::vector<nlohmann::json>& newItems,
+    std::vector<nlohmann::json>&& newItems,
     const std::string& path)
 {
-    return WriteItemsToFile(newItems, path, true);
+    return WriteItemsToFile(std::move(newItems), path, true);
 }
 
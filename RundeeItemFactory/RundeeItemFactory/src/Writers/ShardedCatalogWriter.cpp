@@ -0,0 +1,213 @@
+/**
+ * @file ShardedCatalogWriter.cpp
+ * @brief Implementation of hash-partitioned catalog output
+ * @author Haneul Lee (Rundee)
+ * @date 2026-10-18
+ * @copyright Copyright (c) 2025 Haneul Lee. All rights reserved.
+ */
+
+#include "Writers/ShardedCatalogWriter.h"
+#include "Utils/FileUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+    const uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+    const uint64_t kFnvPrime = 1099511628211ULL;
+
+    /** @brief Per-shard locks, created on first use */
+    std::map<std::string, std::unique_ptr<std::mutex>> s_shardMutexes;
+    std::mutex s_shardMutexesMutex;
+
+    /** @brief Serializes manifest creation and checks */
+    std::mutex s_manifestMutex;
+
+    std::mutex& GetShardMutex(const std::string& shardPath)
+    {
+        std::lock_guard<std::mutex> lock(s_shardMutexesMutex);
+        auto& mutex = s_shardMutexes[shardPath];
+        if (!mutex)
+            mutex = std::make_unique<std::mutex>();
+        return *mutex;
+    }
+
+    /**
+     * @brief Create the manifest, or check that an existing one matches shardCount
+     */
+    bool EnsureManifest(const std::string& basePath, int shardCount)
+    {
+        std::lock_guard<std::mutex> lock(s_manifestMutex);
+        ShardManifest existing;
+        if (ShardedCatalogWriter::LoadManifest(basePath, existing))
+        {
+            if (existing.shardCount != shardCount)
+            {
+                std::cerr << "[ShardedCatalogWriter] Error: " << ShardedCatalogWriter::GetManifestPath(basePath)
+                          << " has " << existing.shardCount << " shards, requested " << shardCount
+                          << " (resharding an existing catalog is not supported)\n";
+                return false;
+            }
+            return true;
+        }
+
+        nlohmann::json manifest;
+        manifest["version"] = 1;
+        manifest["hash"] = "fnv1a64";
+        manifest["shardCount"] = shardCount;
+        manifest["shards"] = nlohmann::json::array();
+        for (int i = 0; i < shardCount; ++i)
+        {
+            const std::string shardPath = ShardedCatalogWriter::GetShardPath(basePath, i, shardCount);
+            manifest["shards"].push_back(std::filesystem::path(shardPath).filename().string());
+        }
+
+        const std::string manifestPath = ShardedCatalogWriter::GetManifestPath(basePath);
+        if (!FileUtils::EnsureParentDirectories(manifestPath) || !FileUtils::WriteFileAtomic(manifestPath, manifest.dump(2)))
+        {
+            std::cerr << "[ShardedCatalogWriter] Error: Failed to write manifest: " << manifestPath << "\n";
+            return false;
+        }
+        return true;
+    }
+}
+
+uint64_t ShardedCatalogWriter::HashId(const std::string& id)
+{
+    uint64_t hash = kFnvOffsetBasis;
+    for (unsigned char c : id)
+    {
+        hash ^= c;
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+int ShardedCatalogWriter::GetShardIndex(const std::string& id, int shardCount)
+{
+    return shardCount <= 1 ? 0 : static_cast<int>(HashId(id) % static_cast<uint64_t>(shardCount));
+}
+
+std::string ShardedCatalogWriter::GetShardPath(const std::string& basePath, int index, int shardCount)
+{
+    int width = 2;
+    for (int n = shardCount - 1; n >= 100; n /= 10)
+        ++width;
+
+    std::filesystem::path path(basePath);
+    std::ostringstream suffix;
+    suffix << "." << std::setw(width) << std::setfill('0') << index << path.extension().string();
+    path.replace_extension();
+    return path.string() + suffix.str();
+}
+
+std::string ShardedCatalogWriter::GetManifestPath(const std::string& basePath)
+{
+    std::filesystem::path path(basePath);
+    path.replace_extension(".shards.json");
+    return path.string();
+}
+
+bool ShardedCatalogWriter::LoadManifest(const std::string& basePath, ShardManifest& outManifest)
+{
+    const std::string manifestPath = GetManifestPath(basePath);
+    std::string text;
+    if (!FileUtils::ReadFile(manifestPath, text))
+        return false;
+
+    nlohmann::json manifest = nlohmann::json::parse(text, nullptr, false);
+    if (!manifest.is_object() || !manifest.contains("shardCount") || !manifest["shardCount"].is_number_integer() ||
+        !manifest.contains("shards") || !manifest["shards"].is_array())
+    {
+        std::cerr << "[ShardedCatalogWriter] Warning: Invalid manifest: " << manifestPath << "\n";
+        return false;
+    }
+
+    const std::filesystem::path directory = std::filesystem::path(manifestPath).parent_path();
+    outManifest.shardCount = manifest["shardCount"].get<int>();
+    outManifest.shardPaths.clear();
+    for (const auto& shard : manifest["shards"])
+    {
+        if (shard.is_string())
+            outManifest.shardPaths.push_back((directory / shard.get<std::string>()).string());
+    }
+    return outManifest.shardCount >= 1 && static_cast<int>(outManifest.shardPaths.size()) == outManifest.shardCount;
+}
+
+std::vector<std::string> ShardedCatalogWriter::GetShardPaths(const std::string& basePath, int shardCount)
+{
+    ShardManifest manifest;
+    if (LoadManifest(basePath, manifest))
+        return manifest.shardPaths;
+
+    std::vector<std::string> paths;
+    for (int i = 0; i < shardCount; ++i)
+        paths.push_back(GetShardPath(basePath, i, shardCount));
+    return paths;
+}
+
+bool ShardedCatalogWriter::WriteItems(
+    std::vector<nlohmann::json>&& items,
+    const std::string& basePath,
+    int shardCount,
+    const ShardWriteFn& writeShard)
+{
+    if (!EnsureManifest(basePath, shardCount))
+        return false;
+
+    std::vector<std::vector<nlohmann::json>> partitions(static_cast<size_t>(shardCount));
+    const size_t itemCount = items.size();
+    for (auto& item : items)
+    {
+        if (!item.is_object() || !item.contains("id") || !item["id"].is_string())
+        {
+            std::cerr << "[ShardedCatalogWriter] Warning: Item missing 'id' field, skipping.\n";
+            continue;
+        }
+        const int shard = GetShardIndex(item["id"].get_ref<const std::string&>(), shardCount);
+        partitions[shard].push_back(std::move(item));
+    }
+    items.clear();
+
+    std::vector<int> pending;
+    for (int i = 0; i < shardCount; ++i)
+    {
+        if (!partitions[i].empty())
+            pending.push_back(i);
+    }
+
+    // A few workers pull shards from a shared cursor; each write holds only its shard's lock
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> ok{ true };
+    auto worker = [&]()
+    {
+        for (size_t k = next++; k < pending.size(); k = next++)
+        {
+            const int shard = pending[k];
+            const std::string shardPath = GetShardPath(basePath, shard, shardCount);
+            std::lock_guard<std::mutex> lock(GetShardMutex(shardPath));
+            if (!writeShard(std::move(partitions[shard]), shardPath))
+                ok = false;
+        }
+    };
+
+    const size_t threadCount = std::min<size_t>(pending.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> workers;
+    for (size_t t = 1; t < threadCount; ++t)
+        workers.emplace_back(worker);
+    worker();
+    for (auto& thread : workers)
+        thread.join();
+
+    std::cout << "[ShardedCatalogWriter] Committed " << itemCount << " items to " << pending.size()
+              << "/" << shardCount << " shards of " << basePath << "\n";
+    return ok;
+}